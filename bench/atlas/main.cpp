@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "myopengl/atlas.h"
+#include "myopengl/image.h"
+
+std::vector<myopengl::image> create_sprites(int count);
+void run_benchmark(const std::vector<myopengl::image>& sprites, int page_size, int mip_levels);
+bool check_cells(const myopengl::atlas_builder& atlas, const std::vector<myopengl::image>& sprites,
+    int padding, int mip_levels);
+
+// Entry method for the atlas benchmark.  Packs thousands of sprites of varying size, reporting the time taken, how
+// many pages they need and how much of each page they fill, for increasing numbers of mip levels the atlas must stay
+// safe for.  Every cell is checked to be filled from the edges of its sprite.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int page_size = argc > 2 ? std::atoi(argv[2]) : 2048;
+
+  const std::vector<myopengl::image> sprites = create_sprites(count);
+
+  for (int mip_levels = 1; mip_levels <= 5; mip_levels += 2) {
+    run_benchmark(sprites, page_size, mip_levels);
+  }
+
+  return 0;
+}
+
+// Packs the sprites into an atlas and reports the build time, page count and fill.
+//
+// Parameters
+// sprites - the images to pack
+// page_size - the width and height of each page
+// mip_levels - the number of mip levels the atlas must remain safe for
+void run_benchmark(const std::vector<myopengl::image>& sprites, int page_size, int mip_levels) {
+  myopengl::atlas_options options;
+  options.page_size = page_size;
+  options.mip_levels = mip_levels;
+
+  myopengl::atlas_builder atlas(options);
+
+  for (const myopengl::image& sprite : sprites) {
+    atlas.add(sprite);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  atlas.build();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  size_t used = 0;
+
+  for (const myopengl::image& sprite : sprites) {
+    used += static_cast<size_t>(sprite.width) * sprite.height;
+  }
+
+  const size_t pages = atlas.pages().size();
+  const double fill = static_cast<double>(used) / (static_cast<double>(pages) * page_size * page_size);
+  const bool match = check_cells(atlas, sprites, options.padding, mip_levels);
+
+  std::cout << "[" << mip_levels << " mip levels] " << sprites.size() << " sprites in " << elapsed.count() << " ms, "
+            << pages << " pages of " << page_size << ", " << fill * 100.0 << "% filled, " << sprites.size()
+            << " texture binds reduced to " << pages << (match ? "" : " OUTPUT MISMATCH") << std::endl;
+}
+
+// Creates RGBA sprites between 8 and 135 texels a side, every texel non zero so blank atlas texels can be found.
+//
+// Parameters
+// count - the number of sprites
+//
+// Returns the sprites
+std::vector<myopengl::image> create_sprites(int count) {
+  std::vector<myopengl::image> sprites(count);
+
+  for (int i = 0; i < count; ++i) {
+    myopengl::image& sprite = sprites[i];
+    sprite.width = 8 + static_cast<int>(static_cast<unsigned int>(i * 2654435761u) >> 25);
+    sprite.height = 8 + static_cast<int>(static_cast<unsigned int>(i * 2246822519u) >> 25);
+    sprite.channels = 4;
+    sprite.pixels.resize(static_cast<size_t>(sprite.width) * sprite.height * sprite.channels);
+
+    for (size_t p = 0; p < sprite.pixels.size(); ++p) {
+      sprite.pixels[p] = static_cast<unsigned char>(1 + (p + i) % 255);
+    }
+  }
+
+  return sprites;
+}
+
+// Checks every texel of each sprite's aligned cell holds the nearest texel of the sprite, so the gutter and the
+// alignment remainder never leave blank texels for filtering to pick up.
+//
+// Parameters
+// atlas - the built atlas
+// sprites - the images which were packed, in the order they were added
+// padding - the gutter the atlas was built with
+// mip_levels - the number of mip levels the atlas was built for
+//
+// Returns true if every cell matches
+bool check_cells(const myopengl::atlas_builder& atlas, const std::vector<myopengl::image>& sprites,
+    int padding, int mip_levels) {
+  const int alignment = 1 << (mip_levels - 1);
+  const int gutter = (padding + alignment - 1) / alignment * alignment;
+
+  for (size_t i = 0; i < sprites.size(); ++i) {
+    const myopengl::image& sprite = sprites[i];
+    const myopengl::atlas_region& region = atlas.region(i);
+    const myopengl::image& page = atlas.pages()[region.page];
+    const int width = (sprite.width + 2 * gutter + alignment - 1) / alignment * alignment;
+    const int height = (sprite.height + 2 * gutter + alignment - 1) / alignment * alignment;
+
+    for (int y = region.y - gutter; y < region.y - gutter + height; ++y) {
+      const int sy = std::min(std::max(y - region.y, 0), sprite.height - 1);
+
+      for (int x = region.x - gutter; x < region.x - gutter + width; ++x) {
+        const int sx = std::min(std::max(x - region.x, 0), sprite.width - 1);
+        const unsigned char* expected = &sprite.pixels[(static_cast<size_t>(sy) * sprite.width + sx) * 4];
+        const unsigned char* actual = &page.pixels[(static_cast<size_t>(y) * page.width + x) * 4];
+
+        if (!std::equal(expected, expected + 4, actual)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
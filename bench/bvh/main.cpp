@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "myopengl/bvh.h"
+#include "myopengl/culling.h"
+#include "myopengl/job_system.h"
+#include "myopengl/math.h"
+
+myopengl::bounding_boxes create_boxes(size_t count, float offset);
+std::vector<myopengl::ray> create_rays(size_t count);
+bool brute_force_raycast(const myopengl::bounding_boxes& boxes, const myopengl::ray& r, myopengl::ray_hit& hit);
+
+// Entry method for the bounding volume hierarchy benchmark.  Builds over a million boxes on increasing numbers of
+// threads, then compares frustum queries against flat SIMD culling, raycasts against brute force, and times a refit.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  const size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 1000000;
+  const size_t ray_count = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 100000;
+  unsigned int max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+
+  const myopengl::bounding_boxes boxes = create_boxes(count, 0.0f);
+
+  for (unsigned int threads = 1; threads <= max_threads; threads *= 2) {
+    myopengl::job_system jobs(threads);
+
+    auto start = std::chrono::steady_clock::now();
+    myopengl::bvh tree(boxes, myopengl::bvh_options(), &jobs);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "[build " << threads << " threads] " << count << " objects in " << elapsed.count() << " ms, "
+              << tree.nodes().size() << " nodes, depth " << tree.depth() << std::endl;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  myopengl::bvh tree(boxes);
+  std::chrono::duration<double, std::milli> build_ms = std::chrono::steady_clock::now() - start;
+
+  const myopengl::frustum f = myopengl::extract_frustum(myopengl::math::perspective(1.0f, 16.0f / 9.0f, 0.1f, 500.0f)
+      * myopengl::math::look_at(myopengl::math::vec3(0.0f, 0.0f, 0.0f), myopengl::math::vec3(1.0f, 0.0f, 0.0f),
+          myopengl::math::vec3(0.0f, 1.0f, 0.0f)));
+
+  std::vector<uint32_t> flat(count);
+  std::vector<uint32_t> visible;
+  visible.reserve(count);
+
+  const int iterations = 20;
+  size_t flat_count = 0;
+
+  start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    flat_count = myopengl::cull(f, boxes, flat.data());
+  }
+
+  std::chrono::duration<double, std::milli> flat_ms = (std::chrono::steady_clock::now() - start) / iterations;
+
+  start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    visible.clear();
+    tree.query(f, visible);
+  }
+
+  std::chrono::duration<double, std::milli> query_ms = (std::chrono::steady_clock::now() - start) / iterations;
+
+  std::sort(visible.begin(), visible.end());
+  bool match = visible.size() == flat_count && std::equal(visible.begin(), visible.end(), flat.begin());
+
+  std::cout << "[frustum] flat simd cull " << flat_ms.count() << " ms, bvh " << query_ms.count() << " ms, speedup "
+            << flat_ms.count() / query_ms.count() << "x, " << visible.size() << " visible"
+            << (match ? "" : " OUTPUT MISMATCH") << std::endl;
+
+  const std::vector<myopengl::ray> rays = create_rays(ray_count);
+  const size_t brute_count = std::min<size_t>(ray_count, 100);
+  size_t hits = 0;
+
+  start = std::chrono::steady_clock::now();
+
+  for (const myopengl::ray& r : rays) {
+    myopengl::ray_hit hit;
+    hits += tree.raycast(r, std::numeric_limits<float>::max(), hit) ? 1 : 0;
+  }
+
+  std::chrono::duration<double> ray_s = std::chrono::steady_clock::now() - start;
+
+  match = true;
+  start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < brute_count; ++i) {
+    myopengl::ray_hit expected;
+    myopengl::ray_hit hit;
+    bool expected_found = brute_force_raycast(boxes, rays[i], expected);
+    bool found = tree.raycast(rays[i], std::numeric_limits<float>::max(), hit);
+    match = match && expected_found == found && (!found || expected.distance == hit.distance);
+  }
+
+  std::chrono::duration<double> brute_s = std::chrono::steady_clock::now() - start;
+
+  std::cout << "[raycast] bvh " << rays.size() / ray_s.count() << " rays/s, brute force "
+            << brute_count / brute_s.count() << " rays/s, " << hits << " hits" << (match ? "" : " OUTPUT MISMATCH")
+            << std::endl;
+
+  const myopengl::bounding_boxes moved = create_boxes(count, 0.5f);
+
+  start = std::chrono::steady_clock::now();
+  tree.refit(moved);
+  std::chrono::duration<double, std::milli> refit_ms = std::chrono::steady_clock::now() - start;
+
+  visible.clear();
+  tree.query(f, visible);
+  std::sort(visible.begin(), visible.end());
+  flat_count = myopengl::cull(f, moved, flat.data());
+  match = visible.size() == flat_count && std::equal(visible.begin(), visible.end(), flat.begin());
+
+  std::cout << "[refit] " << refit_ms.count() << " ms against a " << build_ms.count() << " ms build, " << visible.size()
+            << " visible after moving" << (match ? "" : " OUTPUT MISMATCH") << std::endl;
+
+  return 0;
+}
+
+// Creates boxes of varying size scattered through a cube around the origin.
+//
+// Parameters
+// count - the number of boxes
+// offset - moves every box along x, i.e. to test a refit
+//
+// Returns the boxes
+myopengl::bounding_boxes create_boxes(size_t count, float offset) {
+  myopengl::bounding_boxes boxes;
+
+  for (size_t i = 0; i < count; ++i) {
+    const float x = static_cast<float>(static_cast<unsigned int>(i * 2654435761u) >> 8) / 16777216.0f * 1000.0f
+        - 500.0f;
+    const float y = static_cast<float>(static_cast<unsigned int>(i * 2246822519u) >> 8) / 16777216.0f * 1000.0f
+        - 500.0f;
+    const float z = static_cast<float>(static_cast<unsigned int>(i * 3266489917u) >> 8) / 16777216.0f * 1000.0f
+        - 500.0f;
+    const float size = 0.25f + static_cast<float>(i % 4);
+
+    myopengl::add_box(boxes, myopengl::math::vec3(x + offset - size, y - size, z - size),
+        myopengl::math::vec3(x + offset + size, y + size, z + size));
+  }
+
+  return boxes;
+}
+
+// Creates rays from the origin in directions spread over the sphere.
+//
+// Parameters
+// count - the number of rays
+//
+// Returns the rays
+std::vector<myopengl::ray> create_rays(size_t count) {
+  std::vector<myopengl::ray> rays(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    const float z = 1.0f - 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(count);
+    const float radius = std::sqrt(1.0f - z * z);
+    const float angle = 2.39996323f * static_cast<float>(i);
+
+    rays[i].origin = myopengl::math::vec3(0.0f, 0.0f, 0.0f);
+    rays[i].direction = myopengl::math::vec3(radius * std::cos(angle), radius * std::sin(angle), z);
+  }
+
+  return rays;
+}
+
+// Finds the nearest box a ray hits by testing every box.
+//
+// Parameters
+// boxes - the boxes
+// r - the ray
+// hit - receives the nearest box and the distance at which it is entered
+//
+// Returns true if the ray hit a box
+bool brute_force_raycast(const myopengl::bounding_boxes& boxes, const myopengl::ray& r, myopengl::ray_hit& hit) {
+  bool found = false;
+  hit.distance = std::numeric_limits<float>::max();
+
+  const myopengl::math::vec3 inverse(1.0f / r.direction.x, 1.0f / r.direction.y, 1.0f / r.direction.z);
+
+  for (size_t i = 0; i < boxes.centre_x.size(); ++i) {
+    const myopengl::math::vec3 centre(boxes.centre_x[i], boxes.centre_y[i], boxes.centre_z[i]);
+    const myopengl::math::vec3 extent(boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]);
+    const myopengl::math::vec3 min = centre - extent;
+    const myopengl::math::vec3 max = centre + extent;
+
+    const float x1 = (min.x - r.origin.x) * inverse.x;
+    const float x2 = (max.x - r.origin.x) * inverse.x;
+    const float y1 = (min.y - r.origin.y) * inverse.y;
+    const float y2 = (max.y - r.origin.y) * inverse.y;
+    const float z1 = (min.z - r.origin.z) * inverse.z;
+    const float z2 = (max.z - r.origin.z) * inverse.z;
+
+    const float enter = std::fmax(std::fmax(std::fmin(x1, x2), std::fmin(y1, y2)), std::fmax(std::fmin(z1, z2), 0.0f));
+    const float exit = std::fmin(std::fmin(std::fmax(x1, x2), std::fmax(y1, y2)), std::fmax(z1, z2));
+
+    if (enter <= exit && enter < hit.distance) {
+      hit.distance = enter;
+      hit.object = static_cast<uint32_t>(i);
+      found = true;
+    }
+  }
+
+  return found;
+}
@@ -0,0 +1,284 @@
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "myopengl/command_buffer.h"
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/job_system.h"
+#include "myopengl/shader.h"
+#include "myopengl/shader_exception.h"
+
+int run_benchmark(int objects, int frames, int work);
+unsigned int create_quad(unsigned int& vbo, unsigned int& ebo);
+void prepare_object(int index, int frame, int work, float* transform, float* colour);
+
+struct scene {
+  int objects;
+  int work;
+  unsigned int vao;
+  unsigned int program;
+  int transform_location;
+  int colour_location;
+};
+
+// Entry method for the command buffer benchmark.  Draws thousands of quads whose transforms take some CPU work to
+// compute, first preparing and issuing each one directly on the GL thread and then preparing and recording them
+// across a job system with a varying number of threads with the GL thread replaying the recorded commands.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  int objects = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int frames = argc > 2 ? std::atoi(argv[2]) : 100;
+  int work = argc > 3 ? std::atoi(argv[3]) : 64;
+
+  try {
+    return run_benchmark(objects, frames, work);
+  } catch (myopengl::context_exception& e) {
+    std::cout << "Error creating context: [" << e.what() << "]" << std::endl;
+  } catch (myopengl::shader_exception& e) {
+    std::cout << "Error loading shaders: [" << e.what() << "]" << std::endl;
+  }
+
+  return -1;
+}
+
+// Prepares and draws every object on the GL thread.
+//
+// Parameters
+// s - the scene being drawn
+// frame - the index of the frame
+void draw_direct(const scene& s, int frame) {
+  glUseProgram(s.program);
+  glBindVertexArray(s.vao);
+
+  float transform[16];
+  float colour[4];
+
+  for (int i = 0; i < s.objects; ++i) {
+    prepare_object(i, frame, s.work, transform, colour);
+
+    glUniformMatrix4fv(s.transform_location, 1, GL_FALSE, transform);
+    glUniform4f(s.colour_location, colour[0], colour[1], colour[2], colour[3]);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+  }
+}
+
+// Prepares and records a contiguous range of objects.  Runs on a worker thread so makes no OpenGL calls.
+//
+// Parameters
+// s - the scene being drawn
+// frame - the index of the frame
+// first - the first object of the range
+// last - one past the last object of the range
+// buffer - the worker's command buffer to record into
+void record_objects(const scene& s, int frame, int first, int last, myopengl::command_buffer& buffer) {
+  buffer.clear();
+  buffer.use_program(s.program);
+  buffer.bind_vertex_array(s.vao);
+
+  float transform[16];
+  float colour[4];
+
+  for (int i = first; i < last; ++i) {
+    prepare_object(i, frame, s.work, transform, colour);
+
+    buffer.set_uniform_matrix(s.transform_location, transform);
+    buffer.set_uniform(s.colour_location, colour[0], colour[1], colour[2], colour[3]);
+    buffer.draw_elements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+  }
+}
+
+// Records the objects across the job system, one command buffer per range of objects, then replays the buffers in
+// order.
+//
+// Parameters
+// s - the scene being drawn
+// frame - the index of the frame
+// jobs - the job system recording the ranges
+// buffers - a command buffer per range
+void draw_recorded(const scene& s, int frame, myopengl::job_system& jobs, std::vector<myopengl::command_buffer>& buffers) {
+  const size_t ranges = buffers.size();
+
+  jobs.parallel_for(ranges, 1, [&s, frame, ranges, &buffers](size_t first, size_t last) {
+    for (size_t r = first; r < last; ++r) {
+      record_objects(s, frame, s.objects * r / ranges, s.objects * (r + 1) / ranges, buffers[r]);
+    }
+  });
+
+  myopengl::replay(buffers);
+}
+
+// Times a number of frames, waiting for the GPU to finish each one.
+//
+// Parameters
+// context - the context to present with
+// frames - the number of frames to time
+// draw - draws the frame with the given index
+//
+// Returns the average frame time in milliseconds
+template <typename draw_t>
+double time_frames(myopengl::context& context, int frames, draw_t draw) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < frames; ++i) {
+    glClear(GL_COLOR_BUFFER_BIT);
+    draw(i);
+    context.swap_buffers();
+    glFinish();
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / frames;
+}
+
+// Runs the direct mode and the recorded mode with 1, 2, 4 and 8 threads and reports the average frame time of each.
+//
+// Parameters
+// objects - the number of quads to draw each frame
+// frames - the number of frames to time for each mode
+// work - iterations of busy work spent preparing each object
+//
+// Returns a status code which should be returned to the OS
+int run_benchmark(int objects, int frames, int work) {
+  myopengl::context_options options;
+  options.title = "bench_command_buffer";
+  options.headless = true;
+
+  std::unique_ptr<myopengl::context> context = myopengl::create_context(options);
+
+  myopengl::shader shader("./shader/vertex.glsl", "./shader/fragment.glsl");
+
+  unsigned int vbo = 0;
+  unsigned int ebo = 0;
+
+  scene s;
+  s.objects = objects;
+  s.work = work;
+  s.vao = create_quad(vbo, ebo);
+  s.program = shader.id();
+  s.transform_location = shader.uniform_location("Transform");
+  s.colour_location = shader.uniform_location("Colour");
+
+  double direct_ms = time_frames(*context, frames, [&s](int frame) {
+    draw_direct(s, frame);
+  });
+
+  std::cout << objects << " objects, " << work << " work, " << std::thread::hardware_concurrency()
+            << " hardware threads" << std::endl;
+  std::cout << "[direct] " << direct_ms << " ms/frame" << std::endl;
+
+  for (unsigned int threads : { 1, 2, 4, 8 }) {
+    myopengl::job_system jobs(threads);
+    std::vector<myopengl::command_buffer> buffers(threads * 4);
+
+    double recorded_ms = time_frames(*context, frames, [&s, &jobs, &buffers](int frame) {
+      draw_recorded(s, frame, jobs, buffers);
+    });
+
+    size_t bytes = 0;
+
+    for (const myopengl::command_buffer& buffer : buffers) {
+      bytes += buffer.size();
+    }
+
+    std::cout << "[recorded, " << threads << " threads] " << recorded_ms << " ms/frame, speedup "
+              << direct_ms / recorded_ms << "x, " << bytes / 1024 << " KiB of commands" << std::endl;
+  }
+
+  glDeleteVertexArrays(1, &s.vao);
+  glDeleteBuffers(1, &vbo);
+  glDeleteBuffers(1, &ebo);
+
+  return 0;
+}
+
+// Computes the transform and colour of an object, spinning through some busy work first to stand in for the
+// animation and culling a real scene would do.
+//
+// Parameters
+// index - the index of the object
+// frame - the index of the frame
+// work - iterations of busy work
+// transform - receives 16 floats in column major order
+// colour - receives 4 floats
+void prepare_object(int index, int frame, int work, float* transform, float* colour) {
+  const int columns = 64;
+
+  float angle = index * 0.1f + frame * 0.02f;
+
+  for (int i = 0; i < work; ++i) {
+    angle = angle + std::sin(angle) * 1e-4f;
+  }
+
+  const float scale = 0.5f / columns;
+  const float c = std::cos(angle) * scale;
+  const float s = std::sin(angle) * scale;
+  const float x = -1.0f + (index % columns + 0.5f) * 2.0f / columns;
+  const float y = -1.0f + (index / columns % columns + 0.5f) * 2.0f / columns;
+
+  const float matrix[16] = {
+    c, s, 0.0f, 0.0f,
+    -s, c, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    x, y, 0.0f, 1.0f
+  };
+
+  for (int i = 0; i < 16; ++i) {
+    transform[i] = matrix[i];
+  }
+
+  colour[0] = (index % 7) / 6.0f;
+  colour[1] = (index % 11) / 10.0f;
+  colour[2] = (index % 13) / 12.0f;
+  colour[3] = 1.0f;
+}
+
+// Creates a quad with positions only.
+//
+// Parameters
+// vbo - set to the id of the vertex buffer
+// ebo - set to the id of the element buffer
+//
+// Returns the OpenGL generated id for the vertex array
+unsigned int create_quad(unsigned int& vbo, unsigned int& ebo) {
+  float vertices[] = {
+    1.0f, 1.0f, 0.0f, // top right
+    1.0f, -1.0f, 0.0f, // bottom right
+    -1.0f, -1.0f, 0.0f, // bottom left
+    -1.0f, 1.0f, 0.0f // top left
+  };
+
+  unsigned int indices[] = {
+    0, 1, 3,
+    1, 2, 3
+  };
+
+  unsigned int vao = 0;
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  glGenBuffers(1, &vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+  glEnableVertexAttribArray(0);
+
+  glGenBuffers(1, &ebo);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+  glBindVertexArray(0);
+
+  return vao;
+}
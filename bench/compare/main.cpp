@@ -0,0 +1,162 @@
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int report(const std::filesystem::path& results);
+int compare(const std::filesystem::path& baseline, const std::filesystem::path& results, double threshold);
+bool read_file(const std::filesystem::path& path, std::string& contents);
+double read_statistic(const std::string& json, const char* metric, const char* statistic);
+
+const char* compared_metrics[] = { "cpu_ms", "gpu_ms" };
+const char* compared_statistics[] = { "p50", "p95" };
+const double noise_floor_ms = 0.05;
+
+// Entry method for the benchmark comparison.  Prints the frame statistics written by examples run with --stats and,
+// given a baseline, compares them and fails if any has regressed beyond a threshold.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments, [baseline] results [threshold percent]
+int main(int argc, char* argv[]) {
+  if (argc == 2) {
+    return report(argv[1]);
+  }
+
+  if (argc == 3 || argc == 4) {
+    return compare(argv[1], argv[2], argc == 4 ? std::atof(argv[3]) : 10.0);
+  }
+
+  std::cout << "Usage: bench_compare [baseline directory] <results directory> [threshold percent]" << std::endl;
+
+  return -1;
+}
+
+// Prints the frame statistics of every result in a directory.
+//
+// Parameters
+// results - the directory of results
+//
+// Returns a status code which should be returned to the OS
+int report(const std::filesystem::path& results) {
+  for (const auto& entry : std::filesystem::directory_iterator(results)) {
+    std::string json;
+
+    if (entry.path().extension() != ".json" || !read_file(entry.path(), json)) {
+      continue;
+    }
+
+    std::cout << entry.path().stem().string() << std::endl;
+
+    for (const char* metric : compared_metrics) {
+      std::cout << "  " << std::left << std::setw(8) << metric << std::right << std::fixed << std::setprecision(3)
+                << " mean " << read_statistic(json, metric, "mean") << " p50 " << read_statistic(json, metric, "p50")
+                << " p95 " << read_statistic(json, metric, "p95") << " p99 " << read_statistic(json, metric, "p99")
+                << " max " << read_statistic(json, metric, "max") << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+// Compares every result in a directory against the result of the same name in a baseline directory.
+//
+// Parameters
+// baseline - the directory of baseline results
+// results - the directory of new results
+// threshold - the percentage by which a statistic may exceed its baseline, ignoring differences below the noise floor
+//
+// Returns a status code which should be returned to the OS, non zero if any statistic regressed
+int compare(const std::filesystem::path& baseline, const std::filesystem::path& results, double threshold) {
+  int regressions = 0;
+
+  for (const auto& entry : std::filesystem::directory_iterator(results)) {
+    std::string current;
+    std::string previous;
+
+    if (entry.path().extension() != ".json" || !read_file(entry.path(), current)) {
+      continue;
+    }
+
+    if (!read_file(baseline / entry.path().filename(), previous)) {
+      std::cout << entry.path().stem().string() << ": no baseline" << std::endl;
+      continue;
+    }
+
+    std::cout << entry.path().stem().string() << std::endl;
+
+    for (const char* metric : compared_metrics) {
+      for (const char* statistic : compared_statistics) {
+        double before = read_statistic(previous, metric, statistic);
+        double after = read_statistic(current, metric, statistic);
+        double change = before > 0.0 ? (after - before) / before * 100.0 : 0.0;
+        bool regressed = change > threshold && after - before > noise_floor_ms;
+
+        std::cout << "  " << metric << " " << statistic << std::fixed << std::setprecision(3) << " " << before
+                  << " -> " << after << std::setprecision(1) << " (" << std::showpos << change << std::noshowpos
+                  << "%)" << (regressed ? " REGRESSED" : "") << std::endl;
+
+        regressions += regressed ? 1 : 0;
+      }
+    }
+  }
+
+  if (regressions > 0) {
+    std::cout << regressions << " statistics regressed by more than " << threshold << "%" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+// Reads the contents of a file.
+//
+// Parameters
+// path - the file to read
+// contents - receives the contents of the file
+//
+// Returns true if the file was read
+bool read_file(const std::filesystem::path& path, std::string& contents) {
+  std::ifstream file(path);
+
+  if (!file) {
+    return false;
+  }
+
+  std::stringstream stream;
+  stream << file.rdbuf();
+  contents = stream.str();
+
+  return true;
+}
+
+// Reads a statistic from the JSON written by frame_recorder, i.e. "cpu_ms": { "p95": 1.2 }.
+//
+// Parameters
+// json - the contents of the results file
+// metric - the name of the metric object
+// statistic - the name of the statistic within the metric
+//
+// Returns the value of the statistic, or 0 if it is missing
+double read_statistic(const std::string& json, const char* metric, const char* statistic) {
+  size_t object = json.find("\"" + std::string(metric) + "\"");
+
+  if (object == std::string::npos) {
+    return 0.0;
+  }
+
+  size_t end = json.find('}', object);
+  size_t key = json.find("\"" + std::string(statistic) + "\"", object);
+
+  if (key == std::string::npos || key > end) {
+    return 0.0;
+  }
+
+  size_t colon = json.find(':', key);
+
+  return std::strtod(json.c_str() + colon + 1, NULL);
+}
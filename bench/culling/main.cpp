@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "myopengl/culling.h"
+#include "myopengl/job_system.h"
+#include "myopengl/math.h"
+
+void run_benchmark(const myopengl::frustum& f, const myopengl::bounding_spheres& spheres,
+    const myopengl::bounding_boxes& boxes, unsigned int threads);
+
+// Entry method for the culling benchmark.  Culls a million spheres and boxes scattered around a camera, comparing the
+// scalar test of one object at a time against the SIMD kernels, then scales the SIMD kernels over threads.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  const size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 1000000;
+  unsigned int max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+
+  const myopengl::math::mat4 view_projection = myopengl::math::perspective(1.0f, 16.0f / 9.0f, 0.1f, 500.0f)
+      * myopengl::math::look_at(myopengl::math::vec3(0.0f, 0.0f, 0.0f), myopengl::math::vec3(1.0f, 0.0f, 0.0f),
+          myopengl::math::vec3(0.0f, 1.0f, 0.0f));
+  const myopengl::frustum f = myopengl::extract_frustum(view_projection);
+
+  myopengl::bounding_spheres spheres;
+  myopengl::bounding_boxes boxes;
+
+  for (size_t i = 0; i < count; ++i) {
+    const float x = static_cast<float>(static_cast<unsigned int>(i * 2654435761u) >> 8) / 16777216.0f * 1000.0f
+        - 500.0f;
+    const float y = static_cast<float>(static_cast<unsigned int>(i * 2246822519u) >> 8) / 16777216.0f * 1000.0f
+        - 500.0f;
+    const float z = static_cast<float>(static_cast<unsigned int>(i * 3266489917u) >> 8) / 16777216.0f * 1000.0f
+        - 500.0f;
+    const float size = 0.5f + static_cast<float>(i % 16);
+
+    myopengl::add_sphere(spheres, myopengl::math::vec3(x, y, z), size);
+    myopengl::add_box(boxes, myopengl::math::vec3(x - size, y - size, z - size),
+        myopengl::math::vec3(x + size, y + size, z + size));
+  }
+
+  for (unsigned int threads = 1; threads <= max_threads; threads *= 2) {
+    run_benchmark(f, spheres, boxes, threads);
+  }
+
+  return 0;
+}
+
+// Times an operation averaged over several runs.
+//
+// Parameters
+// function - the operation to time
+//
+// Returns the average time in milliseconds
+template <typename F>
+double time_ms(F function) {
+  const int iterations = 20;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / iterations;
+}
+
+// Culls spheres and boxes scalar and with SIMD on a number of threads, checking every path finds the same visible
+// objects.
+//
+// Parameters
+// f - the frustum to cull against
+// spheres - the bounding spheres
+// boxes - the bounding boxes
+// threads - the number of threads to cull on
+void run_benchmark(const myopengl::frustum& f, const myopengl::bounding_spheres& spheres,
+    const myopengl::bounding_boxes& boxes, unsigned int threads) {
+  myopengl::job_system jobs(threads);
+
+  myopengl::cull_options scalar;
+  scalar.use_simd = false;
+
+  myopengl::cull_options simd;
+
+  std::vector<uint32_t> expected(spheres.x.size());
+  std::vector<uint32_t> visible(spheres.x.size());
+
+  size_t expected_count = 0;
+  size_t visible_count = 0;
+
+  double sphere_scalar_ms = time_ms([&]() { expected_count = myopengl::cull(f, spheres, expected.data(), scalar); });
+  double sphere_simd_ms = time_ms([&]() { visible_count = myopengl::cull(f, spheres, visible.data(), simd, &jobs); });
+
+  bool match = expected_count == visible_count
+      && std::equal(expected.begin(), expected.begin() + expected_count, visible.begin());
+  size_t spheres_visible = visible_count;
+
+  double box_scalar_ms = time_ms([&]() { expected_count = myopengl::cull(f, boxes, expected.data(), scalar); });
+  double box_simd_ms = time_ms([&]() { visible_count = myopengl::cull(f, boxes, visible.data(), simd, &jobs); });
+
+  match = match && expected_count == visible_count
+      && std::equal(expected.begin(), expected.begin() + expected_count, visible.begin());
+
+  std::cout << "[" << threads << " threads, " << spheres.x.size() << " objects] spheres scalar " << sphere_scalar_ms
+            << " ms, simd " << sphere_simd_ms << " ms, speedup " << sphere_scalar_ms / sphere_simd_ms << "x, "
+            << spheres_visible << " visible; boxes scalar " << box_scalar_ms << " ms, simd " << box_simd_ms
+            << " ms, speedup " << box_scalar_ms / box_simd_ms << "x, " << visible_count << " visible"
+            << (match ? "" : " OUTPUT MISMATCH") << std::endl;
+}
@@ -0,0 +1,294 @@
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/frame_pipeline.h"
+#include "myopengl/job_system.h"
+#include "myopengl/shader.h"
+#include "myopengl/shader_exception.h"
+
+struct particles {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> vx;
+  std::vector<float> vy;
+};
+
+struct scene {
+  unsigned int vao;
+  int offset_location;
+  int work;
+};
+
+int run_benchmark(int objects, int frames, int work);
+particles create_particles(int objects);
+void update_particles(const particles& previous, particles& next, int work);
+void render_particles(const scene& s, const particles& p);
+unsigned int create_quad(unsigned int& vbo, unsigned int& ebo);
+
+// Entry method for the frame pipeline benchmark.  Simulates and draws thousands of particles, first updating and
+// rendering each frame one after the other on one thread and then overlapping the update of the next frame with the
+// rendering of the current one through a frame pipeline with double and triple buffered frame data.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments, [objects] [frames] [work]
+int main(int argc, char* argv[]) {
+  int objects = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int frames = argc > 2 ? std::atoi(argv[2]) : 100;
+  int work = argc > 3 ? std::atoi(argv[3]) : 256;
+
+  try {
+    return run_benchmark(objects, frames, work);
+  } catch (myopengl::context_exception& e) {
+    std::cout << "Error creating context: [" << e.what() << "]" << std::endl;
+  } catch (myopengl::shader_exception& e) {
+    std::cout << "Error loading shaders: [" << e.what() << "]" << std::endl;
+  }
+
+  return -1;
+}
+
+// Times a number of frames, updating and rendering each in turn on the calling thread.
+//
+// Parameters
+// context - the context to present with
+// s - the scene being drawn
+// initial - the state of the first frame
+// frames - the number of frames to time
+//
+// Returns the average frame time in milliseconds
+double time_serial(myopengl::context& context, const scene& s, const particles& initial, int frames) {
+  particles current = initial;
+  particles next = initial;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < frames; ++i) {
+    update_particles(current, next, s.work);
+    std::swap(current, next);
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    render_particles(s, current);
+    context.swap_buffers();
+    glFinish();
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / frames;
+}
+
+// Times a number of frames, rendering each from its slot while the pipeline updates the following frames.
+//
+// Parameters
+// context - the context to present with
+// s - the scene being drawn
+// initial - the state of the first frame
+// frames - the number of frames to time
+// buffers - the number of slots of frame data
+//
+// Returns the average frame time in milliseconds
+double time_pipelined(myopengl::context& context, const scene& s, const particles& initial, int frames, int buffers) {
+  myopengl::job_system jobs(2);
+  std::vector<particles> slots(buffers, initial);
+
+  myopengl::frame_pipeline pipeline(jobs, [&s, &slots](size_t, int previous, int next) {
+    update_particles(slots[previous], slots[next], s.work);
+  }, buffers);
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < frames; ++i) {
+    int slot = pipeline.begin_frame();
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    render_particles(s, slots[slot]);
+    context.swap_buffers();
+    glFinish();
+
+    pipeline.end_frame();
+  }
+
+  pipeline.finish();
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / frames;
+}
+
+// Runs the serial mode and the pipelined mode with double and triple buffering and reports the average frame time
+// of each.
+//
+// Parameters
+// objects - the number of particles to simulate and draw each frame
+// frames - the number of frames to time for each mode
+// work - iterations of busy work spent updating each particle
+//
+// Returns a status code which should be returned to the OS
+int run_benchmark(int objects, int frames, int work) {
+  myopengl::context_options options;
+  options.title = "bench_frame_pipeline";
+  options.headless = true;
+
+  std::unique_ptr<myopengl::context> context = myopengl::create_context(options);
+
+  myopengl::shader shader("./shader/vertex.glsl", "./shader/fragment.glsl");
+
+  unsigned int vbo = 0;
+  unsigned int ebo = 0;
+
+  scene s;
+  s.vao = create_quad(vbo, ebo);
+  s.offset_location = shader.uniform_location("Offset");
+  s.work = work;
+
+  shader.use();
+  shader.set_float("Scale", 0.005f);
+
+  particles initial = create_particles(objects);
+
+  double serial_ms = time_serial(*context, s, initial, frames);
+
+  std::cout << objects << " objects, " << work << " work, " << std::thread::hardware_concurrency()
+            << " hardware threads" << std::endl;
+  std::cout << "[serial] " << serial_ms << " ms/frame" << std::endl;
+
+  for (int buffers : { 2, 3 }) {
+    double pipelined_ms = time_pipelined(*context, s, initial, frames, buffers);
+
+    std::cout << "[pipelined, " << buffers << " buffers] " << pipelined_ms << " ms/frame, speedup "
+              << serial_ms / pipelined_ms << "x" << std::endl;
+  }
+
+  glDeleteVertexArrays(1, &s.vao);
+  glDeleteBuffers(1, &vbo);
+  glDeleteBuffers(1, &ebo);
+
+  return 0;
+}
+
+// Creates particles spread over the screen moving in different directions.
+//
+// Parameters
+// objects - the number of particles
+//
+// Returns the particles
+particles create_particles(int objects) {
+  particles result;
+
+  for (int i = 0; i < objects; ++i) {
+    float angle = i * 2.399963f;
+
+    result.x.push_back(std::cos(angle) * (i % 97) / 97.0f);
+    result.y.push_back(std::sin(angle) * (i % 89) / 89.0f);
+    result.vx.push_back(std::cos(angle * 3.0f) * 0.01f);
+    result.vy.push_back(std::sin(angle * 3.0f) * 0.01f);
+  }
+
+  return result;
+}
+
+// Advances every particle by a frame, bouncing off the edges of the screen, spinning through some busy work first to
+// stand in for the simulation a real scene would do.
+//
+// Parameters
+// previous - the particles of the previous frame
+// next - receives the particles of the next frame
+// work - iterations of busy work for each particle
+void update_particles(const particles& previous, particles& next, int work) {
+  const size_t count = previous.x.size();
+
+  next.x.resize(count);
+  next.y.resize(count);
+  next.vx.resize(count);
+  next.vy.resize(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    float vx = previous.vx[i];
+    float vy = previous.vy[i];
+    float drag = 1.0f;
+
+    for (int w = 0; w < work; ++w) {
+      drag = std::sqrt(drag * 0.999f + 0.001f);
+    }
+
+    float x = previous.x[i] + vx * drag;
+    float y = previous.y[i] + vy * drag;
+
+    if (x < -1.0f || x > 1.0f) {
+      vx = -vx;
+    }
+
+    if (y < -1.0f || y > 1.0f) {
+      vy = -vy;
+    }
+
+    next.x[i] = x;
+    next.y[i] = y;
+    next.vx[i] = vx;
+    next.vy[i] = vy;
+  }
+}
+
+// Draws every particle with its own offset uniform and draw call.  The shader must be in use.
+//
+// Parameters
+// s - the scene being drawn
+// p - the particles of the frame, which are only read
+void render_particles(const scene& s, const particles& p) {
+  glBindVertexArray(s.vao);
+
+  for (size_t i = 0; i < p.x.size(); ++i) {
+    glUniform2f(s.offset_location, p.x[i], p.y[i]);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+  }
+}
+
+// Creates a quad with positions only.
+//
+// Parameters
+// vbo - set to the id of the vertex buffer
+// ebo - set to the id of the element buffer
+//
+// Returns the OpenGL generated id for the vertex array
+unsigned int create_quad(unsigned int& vbo, unsigned int& ebo) {
+  float vertices[] = {
+    1.0f, 1.0f, 0.0f, // top right
+    1.0f, -1.0f, 0.0f, // bottom right
+    -1.0f, -1.0f, 0.0f, // bottom left
+    -1.0f, 1.0f, 0.0f // top left
+  };
+
+  unsigned int indices[] = {
+    0, 1, 3,
+    1, 2, 3
+  };
+
+  unsigned int vao = 0;
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  glGenBuffers(1, &vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+  glEnableVertexAttribArray(0);
+
+  glGenBuffers(1, &ebo);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+  glBindVertexArray(0);
+
+  return vao;
+}
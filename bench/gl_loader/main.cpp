@@ -0,0 +1,83 @@
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/gl_loader.h"
+
+double time_loading(myopengl::proc_loader_t loader, myopengl::gl_loading mode, int iterations);
+void draw_frame();
+
+// Entry method for the OpenGL loading benchmark.  Loads OpenGL repeatedly, eagerly through glad and lazily through
+// trampolines, and reports the cost of each along with how many functions a simple frame needs resolved.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments, [iterations]
+int main(int argc, char* argv[]) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+
+  try {
+    myopengl::context_options options = myopengl::parse_context_options(argc, argv, "bench_gl_loader");
+    options.headless = true;
+
+    std::unique_ptr<myopengl::context> context = myopengl::create_context(options);
+    myopengl::proc_loader_t loader = context->proc_loader();
+
+    double eager = time_loading(loader, myopengl::gl_loading::eager, iterations);
+    double lazy = time_loading(loader, myopengl::gl_loading::lazy, iterations);
+
+    size_t before = myopengl::gl_functions_resolved();
+    myopengl::load_gl(loader, myopengl::gl_loading::lazy);
+    draw_frame();
+    size_t resolved = myopengl::gl_functions_resolved() - before;
+
+    std::cout << iterations << " iterations" << std::endl;
+    std::cout << "[gladLoadGLLoader] " << eager << " us/load" << std::endl;
+    std::cout << "[lazy trampolines] " << lazy << " us/load, speedup " << eager / lazy << "x, " << resolved
+              << " functions resolved by a frame" << std::endl;
+  } catch (myopengl::context_exception& e) {
+    std::cout << "Error creating context: [" << e.what() << "]" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+// Loads OpenGL a number of times.
+//
+// Parameters
+// loader - resolves OpenGL functions for the current context
+// mode - how functions are loaded
+// iterations - the number of times to load
+//
+// Returns the average time of a load in microseconds
+double time_loading(myopengl::proc_loader_t loader, myopengl::gl_loading mode, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    myopengl::load_gl(loader, mode);
+  }
+
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / iterations;
+}
+
+// Clears and draws nothing, touching the functions a minimal frame calls.
+void draw_frame() {
+  unsigned int vao = 0;
+
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+  glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+  glBindVertexArray(0);
+  glDeleteVertexArrays(1, &vao);
+  glFinish();
+}
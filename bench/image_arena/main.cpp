@@ -0,0 +1,120 @@
+#include <stb/stb_image.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "myopengl/image_arena.h"
+
+typedef std::vector<unsigned char> encoded_image;
+
+encoded_image read_file(const char* path);
+double run_decoders(const std::vector<encoded_image>& files, int threads, int iterations, bool use_arena);
+
+// Entry method for the image arena benchmark.  Decodes the same set of in-memory files on several threads, first
+// with the decoder allocating from the heap and then from per-thread arenas, and reports throughput for both.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments, [threads] [iterations] [files...]
+int main(int argc, char* argv[]) {
+  int threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+  int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+  std::vector<encoded_image> files;
+
+  if (argc > 3) {
+    for (int i = 3; i < argc; ++i) {
+      files.push_back(read_file(argv[i]));
+    }
+  } else {
+    files.push_back(read_file("./texture/container.jpg"));
+    files.push_back(read_file("./texture/awesomeface.png"));
+  }
+
+  threads = threads > 0 ? threads : 1;
+
+#ifndef MYOPENGL_STBI_ARENA
+  std::cout << "Built without MYOPENGL_STBI_ARENA, arena results use the heap" << std::endl;
+#endif
+
+  double heap = run_decoders(files, threads, iterations, false);
+  double arena = run_decoders(files, threads, iterations, true);
+
+  std::cout << threads << " threads, " << files.size() << " files, " << iterations << " iterations" << std::endl;
+  std::cout << "[heap] " << heap << " images/s" << std::endl;
+  std::cout << "[arena] " << arena << " images/s, speedup " << arena / heap << "x" << std::endl;
+
+  return 0;
+}
+
+// Decodes every file a number of times on each thread.
+//
+// Parameters
+// files - the encoded files
+// threads - the number of decoding threads
+// iterations - the number of times each thread decodes every file
+// use_arena - true to decode within an arena scope
+//
+// Returns the number of images decoded per second
+double run_decoders(const std::vector<encoded_image>& files, int threads, int iterations, bool use_arena) {
+  std::atomic<size_t> allocations(0);
+  std::atomic<size_t> arena_allocations(0);
+  std::vector<std::thread> workers;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&]() {
+      myopengl::reset_thread_image_allocation_stats();
+
+      for (int i = 0; i < iterations; ++i) {
+        for (const encoded_image& file : files) {
+          int width = 0;
+          int height = 0;
+          int channels = 0;
+
+          if (use_arena) {
+            myopengl::image_arena::scope scope(myopengl::image_arena::thread_arena());
+            stbi_image_free(stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0));
+          } else {
+            stbi_image_free(stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0));
+          }
+        }
+      }
+
+      const myopengl::image_allocation_stats& stats = myopengl::thread_image_allocation_stats();
+      allocations += stats.allocations + stats.reallocations;
+      arena_allocations += stats.arena_allocations;
+    });
+  }
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  size_t images = static_cast<size_t>(threads) * iterations * files.size();
+
+  std::cout << (use_arena ? "[arena] " : "[heap] ") << allocations.load() / images << " allocations per image, "
+            << arena_allocations.load() / images << " from the arena" << std::endl;
+
+  return images / elapsed.count();
+}
+
+// Reads the whole of a file into memory.
+//
+// Parameters
+// path - path to the file
+//
+// Returns the contents of the file
+encoded_image read_file(const char* path) {
+  std::ifstream file(path, std::ios::binary);
+
+  return encoded_image(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
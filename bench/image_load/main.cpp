@@ -0,0 +1,123 @@
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "myopengl/file_exception.h"
+#include "myopengl/mapped_file.h"
+
+std::vector<std::string> find_images(const char* directory);
+double load_with_stdio(const std::vector<std::string>& paths, int iterations);
+double load_with_mapping(const std::vector<std::string>& paths, int iterations);
+
+// Entry method for the image loading benchmark.  Decodes every JPEG and PNG in a directory through stb_image's
+// stdio path and through a memory mapping, and reports throughput for both.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments, [directory] [iterations]
+int main(int argc, char* argv[]) {
+  const char* directory = argc > 1 ? argv[1] : "./texture";
+  int iterations = argc > 2 ? std::atoi(argv[2]) : 5;
+
+  std::vector<std::string> paths = find_images(directory);
+
+  if (paths.empty()) {
+    std::cout << "No images found in [" << directory << "]" << std::endl;
+    return -1;
+  }
+
+  try {
+    double stdio = load_with_stdio(paths, iterations);
+    double mapping = load_with_mapping(paths, iterations);
+
+    std::cout << paths.size() << " images, " << iterations << " iterations" << std::endl;
+    std::cout << "[stbi_load] " << stdio << " images/s" << std::endl;
+    std::cout << "[mmap + stbi_load_from_memory] " << mapping << " images/s, speedup " << mapping / stdio << "x"
+              << std::endl;
+  } catch (myopengl::file_exception& e) {
+    std::cout << "Error reading files: [" << e.what() << "]" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+// Decodes every image through stb_image's FILE* based loader.
+//
+// Parameters
+// paths - the images to decode
+// iterations - the number of times to decode every image
+//
+// Returns the number of images decoded per second
+double load_with_stdio(const std::vector<std::string>& paths, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    for (const std::string& path : paths) {
+      int width = 0;
+      int height = 0;
+      int channels = 0;
+
+      stbi_image_free(stbi_load(path.c_str(), &width, &height, &channels, 0));
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return paths.size() * iterations / elapsed.count();
+}
+
+// Decodes every image from a memory mapping of its file.
+//
+// Parameters
+// paths - the images to decode
+// iterations - the number of times to decode every image
+//
+// Returns the number of images decoded per second
+double load_with_mapping(const std::vector<std::string>& paths, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    for (const std::string& path : paths) {
+      int width = 0;
+      int height = 0;
+      int channels = 0;
+
+      myopengl::mapped_file file(path.c_str());
+      stbi_image_free(stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0));
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return paths.size() * iterations / elapsed.count();
+}
+
+// Finds every JPEG and PNG file in a directory.
+//
+// Parameters
+// directory - the directory to search
+//
+// Returns the paths of the images, sorted
+std::vector<std::string> find_images(const char* directory) {
+  std::vector<std::string> paths;
+  std::error_code error;
+
+  for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+    std::string extension = entry.path().extension().string();
+
+    if (extension == ".jpg" || extension == ".jpeg" || extension == ".png") {
+      paths.push_back(entry.path().string());
+    }
+  }
+
+  std::sort(paths.begin(), paths.end());
+
+  return paths;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "myopengl/job_system.h"
+
+double time_parallel_for(unsigned int threads, std::vector<float>& items, size_t grain, int work, int iterations);
+
+// Entry method for the job system benchmark.  Runs the same total work through parallel_for split into tiny and
+// large jobs on 1 up to N threads and reports the time and speedup over a single thread of each.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments, [max threads] [items] [iterations]
+int main(int argc, char* argv[]) {
+  unsigned int max_threads = argc > 1 ? std::atoi(argv[1]) : std::thread::hardware_concurrency();
+  size_t count = argc > 2 ? std::atoi(argv[2]) : 1 << 18;
+  int iterations = argc > 3 ? std::atoi(argv[3]) : 20;
+
+  if (max_threads == 0) {
+    max_threads = 1;
+  }
+
+  struct granularity {
+    const char* name;
+    size_t grain;
+    int work;
+  };
+
+  const granularity granularities[] = {
+    { "tiny", 16, 4 },
+    { "large", 16384, 4 },
+    { "tiny heavy", 16, 64 },
+    { "large heavy", 16384, 64 }
+  };
+
+  std::vector<float> items(count);
+
+  std::cout << count << " items, " << iterations << " iterations, " << std::thread::hardware_concurrency()
+            << " hardware threads" << std::endl;
+
+  std::vector<unsigned int> thread_counts;
+
+  for (unsigned int threads = 1; threads < max_threads; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+
+  thread_counts.push_back(max_threads);
+
+  for (const granularity& g : granularities) {
+    double single = 0.0;
+
+    for (unsigned int threads : thread_counts) {
+      double ms = time_parallel_for(threads, items, g.grain, g.work, iterations);
+
+      if (threads == 1) {
+        single = ms;
+      }
+
+      std::cout << "[" << g.name << ", " << (count + g.grain - 1) / g.grain << " jobs, " << threads << " threads] "
+                << ms << " ms, speedup " << single / ms << "x" << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+// Times parallel_for over a range of items on a job system of a given size.
+//
+// Parameters
+// threads - the number of threads running jobs
+// items - the items to update
+// grain - the number of items in each job
+// work - iterations of arithmetic applied to each item
+// iterations - the number of times to run over the items
+//
+// Returns the average time of a run over the items in milliseconds
+double time_parallel_for(unsigned int threads, std::vector<float>& items, size_t grain, int work, int iterations) {
+  myopengl::job_system jobs(threads);
+
+  auto update = [&items, work](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      float value = items[i] + static_cast<float>(i);
+
+      for (int w = 0; w < work; ++w) {
+        value = std::sqrt(value * 0.5f + 1.0f);
+      }
+
+      items[i] = value;
+    }
+  };
+
+  jobs.parallel_for(items.size(), grain, update);
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    jobs.parallel_for(items.size(), grain, update);
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / iterations;
+}
@@ -0,0 +1,209 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "myopengl/math.h"
+
+struct scalar_point {
+  float x;
+  float y;
+  float z;
+};
+
+struct scalar_matrix {
+  float m[16];
+};
+
+void scalar_transform_points(const scalar_matrix& m, const std::vector<scalar_point>& points,
+    std::vector<scalar_point>& result);
+void scalar_multiply_matrices(const std::vector<scalar_matrix>& a, const std::vector<scalar_matrix>& b,
+    std::vector<scalar_matrix>& result);
+void run_transform(size_t count);
+void run_multiply(size_t count);
+
+// Entry method for the math benchmark.  Compares the batched SIMD kernels against plain scalar loops over arrays of
+// structures, transforming points and multiplying matrices.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  const size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 1000000;
+
+  constexpr myopengl::math::mat4 model = myopengl::math::translation(myopengl::math::vec3(1.0f, 2.0f, 3.0f));
+  static_assert(model[3].z == 3.0f, "translation is evaluated at compile time");
+
+  run_transform(count);
+  run_transform(count / 100);
+  run_multiply(count / 10);
+  run_multiply(count / 1000);
+
+  return 0;
+}
+
+// Times an operation averaged over several runs.
+//
+// Parameters
+// function - the operation to time
+//
+// Returns the average time in milliseconds
+template <typename F>
+double time_ms(F function) {
+  const int iterations = 20;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / iterations;
+}
+
+// Returns a pseudo random value between -1 and 1.
+//
+// Parameters
+// i - the index of the value
+float pattern(size_t i) {
+  return static_cast<float>(static_cast<unsigned int>(i * 2654435761u) >> 8) / 8388608.0f - 1.0f;
+}
+
+// Returns true if two values are equal within a relative tolerance.
+//
+// Parameters
+// a - the first value
+// b - the second value
+bool close(float a, float b) {
+  return std::fabs(a - b) <= 1e-4f * (1.0f + std::fabs(a) + std::fabs(b));
+}
+
+// Builds a transform with every element in use.
+//
+// Parameters
+// seed - varies the transform
+myopengl::math::mat4 create_transform(size_t seed) {
+  using namespace myopengl::math;
+
+  const quat q = axis_angle(vec3(pattern(seed), pattern(seed + 1), 1.0f), pattern(seed + 2) * 3.0f);
+
+  return translation(vec3(pattern(seed + 3), pattern(seed + 4), pattern(seed + 5))) * rotation(q)
+      * scaling(vec3(2.0f, 3.0f, 4.0f));
+}
+
+// Benchmarks transforming points, scalar over an array of structures against the SIMD kernel over a structure of
+// arrays, and checks the results match.
+//
+// Parameters
+// count - the number of points
+void run_transform(size_t count) {
+  const myopengl::math::mat4 m = create_transform(1);
+
+  scalar_matrix sm;
+
+  for (int i = 0; i < 16; ++i) {
+    sm.m[i] = m.data()[i];
+  }
+
+  std::vector<scalar_point> points(count);
+  std::vector<scalar_point> scalar_result(count);
+  std::vector<float> x(count), y(count), z(count), out_x(count), out_y(count), out_z(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    points[i] = { pattern(i * 3), pattern(i * 3 + 1), pattern(i * 3 + 2) };
+    x[i] = points[i].x;
+    y[i] = points[i].y;
+    z[i] = points[i].z;
+  }
+
+  double scalar_ms = time_ms([&]() { scalar_transform_points(sm, points, scalar_result); });
+  double simd_ms = time_ms([&]() {
+    myopengl::math::transform_points(m, x.data(), y.data(), z.data(), out_x.data(), out_y.data(), out_z.data(), count);
+  });
+
+  bool match = true;
+
+  for (size_t i = 0; i < count && match; ++i) {
+    match = close(scalar_result[i].x, out_x[i]) && close(scalar_result[i].y, out_y[i])
+        && close(scalar_result[i].z, out_z[i]);
+  }
+
+  std::cout << "[transform " << count << " points] scalar " << scalar_ms << " ms, simd " << simd_ms << " ms, speedup "
+            << scalar_ms / simd_ms << "x" << (match ? "" : " OUTPUT MISMATCH") << std::endl;
+}
+
+// Benchmarks multiplying pairs of matrices, scalar against the SIMD kernel, and checks the results match.
+//
+// Parameters
+// count - the number of pairs
+void run_multiply(size_t count) {
+  std::vector<myopengl::math::mat4> a(count), b(count), result(count);
+  std::vector<scalar_matrix> sa(count), sb(count), scalar_result(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    a[i] = create_transform(i * 6);
+    b[i] = create_transform(i * 6 + 3);
+
+    for (int e = 0; e < 16; ++e) {
+      sa[i].m[e] = a[i].data()[e];
+      sb[i].m[e] = b[i].data()[e];
+    }
+  }
+
+  double scalar_ms = time_ms([&]() { scalar_multiply_matrices(sa, sb, scalar_result); });
+  double simd_ms = time_ms([&]() { myopengl::math::multiply_matrices(a.data(), b.data(), result.data(), count); });
+
+  bool match = true;
+
+  for (size_t i = 0; i < count && match; ++i) {
+    for (int e = 0; e < 16 && match; ++e) {
+      match = close(scalar_result[i].m[e], result[i].data()[e]);
+    }
+  }
+
+  std::cout << "[multiply " << count << " matrices] scalar " << scalar_ms << " ms, simd " << simd_ms << " ms, speedup "
+            << scalar_ms / simd_ms << "x" << (match ? "" : " OUTPUT MISMATCH") << std::endl;
+}
+
+// Transforms points one at a time by a column major matrix.
+//
+// Parameters
+// m - the transform
+// points - the points to transform
+// result - receives the transformed points
+void scalar_transform_points(const scalar_matrix& m, const std::vector<scalar_point>& points,
+    std::vector<scalar_point>& result) {
+  for (size_t i = 0; i < points.size(); ++i) {
+    const scalar_point& p = points[i];
+
+    result[i].x = m.m[0] * p.x + m.m[4] * p.y + m.m[8] * p.z + m.m[12];
+    result[i].y = m.m[1] * p.x + m.m[5] * p.y + m.m[9] * p.z + m.m[13];
+    result[i].z = m.m[2] * p.x + m.m[6] * p.y + m.m[10] * p.z + m.m[14];
+  }
+}
+
+// Multiplies pairs of column major matrices element by element.
+//
+// Parameters
+// a - the left hand matrices
+// b - the right hand matrices
+// result - receives a[i] * b[i]
+void scalar_multiply_matrices(const std::vector<scalar_matrix>& a, const std::vector<scalar_matrix>& b,
+    std::vector<scalar_matrix>& result) {
+  for (size_t i = 0; i < a.size(); ++i) {
+    for (int column = 0; column < 4; ++column) {
+      for (int row = 0; row < 4; ++row) {
+        float sum = 0.0f;
+
+        for (int k = 0; k < 4; ++k) {
+          sum += a[i].m[k * 4 + row] * b[i].m[column * 4 + k];
+        }
+
+        result[i].m[column * 4 + row] = sum;
+      }
+    }
+  }
+}
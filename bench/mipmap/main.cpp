@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "myopengl/image.h"
+#include "myopengl/mipmap.h"
+
+myopengl::image create_pattern(int size, int channels);
+double psnr(const myopengl::image& a, const myopengl::image& b);
+double time_chain(const myopengl::image& base, const myopengl::mip_options& options, int iterations);
+void run_filter(const myopengl::image& base, myopengl::mip_filter filter, const char* name);
+
+// Entry method for the mipmap benchmark.  Compares the SIMD kernels against the scalar reference for speed and
+// checks both produce the same chain, then measures quality against an analytically rendered half size image.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  int size = argc > 1 ? std::atoi(argv[1]) : 2048;
+
+  myopengl::image base = create_pattern(size, 4);
+
+  std::cout << "Base image " << size << "x" << size << ", " << myopengl::mip_level_count(size, size) << " levels"
+            << std::endl;
+
+  run_filter(base, myopengl::mip_filter::box, "box");
+  run_filter(base, myopengl::mip_filter::kaiser, "kaiser");
+
+  return 0;
+}
+
+// Benchmarks a single filter and reports timings and PSNR.
+//
+// Parameters
+// base - the base level to build chains from
+// filter - the filter to benchmark
+// name - name of the filter for output
+void run_filter(const myopengl::image& base, myopengl::mip_filter filter, const char* name) {
+  const int iterations = 5;
+
+  myopengl::mip_options scalar;
+  scalar.filter = filter;
+  scalar.use_simd = false;
+
+  myopengl::mip_options simd = scalar;
+  simd.use_simd = true;
+
+  double scalar_ms = time_chain(base, scalar, iterations);
+  double simd_ms = time_chain(base, simd, iterations);
+
+  std::vector<myopengl::image> scalar_chain = myopengl::generate_mip_chain(base, scalar);
+  std::vector<myopengl::image> simd_chain = myopengl::generate_mip_chain(base, simd);
+
+  double worst = std::numeric_limits<double>::infinity();
+
+  for (size_t level = 1; level < scalar_chain.size(); ++level) {
+    worst = std::min(worst, psnr(scalar_chain[level], simd_chain[level]));
+  }
+
+  myopengl::image reference = create_pattern(base.width / 2, base.channels);
+
+  std::cout << "[" << name << "] scalar " << scalar_ms << " ms, simd " << simd_ms << " ms, speedup "
+            << scalar_ms / simd_ms << "x" << std::endl;
+  std::cout << "[" << name << "] simd vs scalar worst PSNR " << worst << " dB, level 1 vs analytic "
+            << psnr(simd_chain[1], reference) << " dB" << std::endl;
+}
+
+// Returns the average time to build a chain in milliseconds.
+//
+// Parameters
+// base - the base level to build chains from
+// options - options passed to the generator
+// iterations - the number of chains to build
+double time_chain(const myopengl::image& base, const myopengl::mip_options& options, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    myopengl::generate_mip_chain(base, options);
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / iterations;
+}
+
+// Renders a band limited test pattern with a soft alpha gradient.  Colour is defined in linear space and sRGB
+// encoded, and the pattern is defined in texture space so rendering it at half size gives a reference for the first
+// mip level.
+//
+// Parameters
+// size - width and height of the image
+// channels - number of channels to generate
+myopengl::image create_pattern(int size, int channels) {
+  myopengl::image result;
+  result.width = size;
+  result.height = size;
+  result.channels = channels;
+  result.pixels.resize(static_cast<size_t>(size) * size * channels);
+
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      float u = (x + 0.5f) / size;
+      float v = (y + 0.5f) / size;
+      float values[4] = {
+        0.5f + 0.5f * std::sin(u * 40.0f),
+        0.5f + 0.5f * std::cos(v * 25.0f),
+        0.5f + 0.5f * std::sin((u + v) * 15.0f),
+        std::min(1.0f, u + 0.25f)
+      };
+
+      for (int c = 0; c < 3; ++c) {
+        values[c] = values[c] <= 0.0031308f ? values[c] * 12.92f : 1.055f * std::pow(values[c], 1.0f / 2.4f) - 0.055f;
+      }
+
+      for (int c = 0; c < channels; ++c) {
+        result.pixels[(static_cast<size_t>(y) * size + x) * channels + c]
+            = static_cast<unsigned char>(values[c] * 255.0f + 0.5f);
+      }
+    }
+  }
+
+  return result;
+}
+
+// Calculates the peak signal to noise ratio between two images of equal dimensions.
+//
+// Parameters
+// a - the first image
+// b - the second image
+//
+// Returns the PSNR in decibels, infinity if the images are identical
+double psnr(const myopengl::image& a, const myopengl::image& b) {
+  double error = 0.0;
+
+  for (size_t i = 0; i < a.pixels.size(); ++i) {
+    double d = static_cast<double>(a.pixels[i]) - b.pixels[i];
+    error += d * d;
+  }
+
+  if (error == 0.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  double mse = error / a.pixels.size();
+
+  return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "myopengl/image.h"
+#include "myopengl/pixel_pipeline.h"
+
+myopengl::image create_image(int width, int height, int channels);
+myopengl::image process_separately(const myopengl::image& source, const myopengl::pixel_operations& operations);
+void run_case(const char* name, int width, int height, int channels, const myopengl::pixel_operations& operations);
+
+// Entry method for the pixel pipeline benchmark.  Compares the fused pipeline, scalar and SIMD, against a vertical
+// flip in the style of stb_image followed by a separate pass per operation, on 4K and 8K images.
+int main() {
+  myopengl::pixel_operations expand;
+  expand.flip_vertically = true;
+  expand.expand_to_rgba = true;
+  expand.swizzle_bgr = true;
+
+  myopengl::pixel_operations premultiply;
+  premultiply.flip_vertically = true;
+  premultiply.swizzle_bgr = true;
+  premultiply.premultiply_alpha = true;
+
+  myopengl::pixel_operations flip;
+  flip.flip_vertically = true;
+
+  run_case("4K RGB flip", 3840, 2160, 3, flip);
+  run_case("4K RGB flip+expand+bgr", 3840, 2160, 3, expand);
+  run_case("4K RGBA flip+bgr+premultiply", 3840, 2160, 4, premultiply);
+  run_case("8K RGB flip+expand+bgr", 7680, 4320, 3, expand);
+  run_case("8K RGBA flip+bgr+premultiply", 7680, 4320, 4, premultiply);
+
+  return 0;
+}
+
+// Times an operation averaged over several runs.
+//
+// Parameters
+// function - the operation to time
+//
+// Returns the average time in milliseconds
+template <typename F>
+double time_ms(F function) {
+  const int iterations = 5;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / iterations;
+}
+
+// Benchmarks one set of operations and checks the fused output matches the separate passes.
+//
+// Parameters
+// name - name of the case for output
+// width - width of the image
+// height - height of the image
+// channels - channels of the image
+// operations - the operations to apply
+void run_case(const char* name, int width, int height, int channels, const myopengl::pixel_operations& operations) {
+  myopengl::image source = create_image(width, height, channels);
+
+  myopengl::pixel_operations scalar = operations;
+  scalar.use_simd = false;
+
+  myopengl::image separate = process_separately(source, operations);
+  myopengl::image fused_scalar = myopengl::process_pixels(source, scalar);
+  myopengl::image fused_simd = myopengl::process_pixels(source, operations);
+
+  bool match = separate.pixels == fused_scalar.pixels && separate.pixels == fused_simd.pixels;
+
+  double separate_ms = time_ms([&]() { process_separately(source, operations); });
+  double scalar_ms = time_ms([&]() { myopengl::process_pixels(source, scalar); });
+  double simd_ms = time_ms([&]() { myopengl::process_pixels(source, operations); });
+
+  std::cout << "[" << name << "] separate passes " << separate_ms << " ms, fused scalar " << scalar_ms
+            << " ms, fused simd " << simd_ms << " ms, speedup " << separate_ms / simd_ms << "x"
+            << (match ? "" : " OUTPUT MISMATCH") << std::endl;
+}
+
+// Applies operations the way they would be without the pipeline: an in place row swap flip, as stb_image does
+// after decoding, followed by one pass over the image per operation.
+//
+// Parameters
+// source - the image to process
+// operations - the operations to apply
+//
+// Returns the processed image
+myopengl::image process_separately(const myopengl::image& source, const myopengl::pixel_operations& operations) {
+  myopengl::image result = source;
+  size_t stride = static_cast<size_t>(result.width) * result.channels;
+
+  if (operations.flip_vertically) {
+    for (int y = 0; y < result.height / 2; ++y) {
+      unsigned char* top = &result.pixels[y * stride];
+      unsigned char* bottom = &result.pixels[(result.height - 1 - y) * stride];
+      std::swap_ranges(top, top + stride, bottom);
+    }
+  }
+
+  size_t count = static_cast<size_t>(result.width) * result.height;
+
+  if (operations.expand_to_rgba && result.channels == 3) {
+    std::vector<unsigned char> expanded(count * 4);
+
+    for (size_t i = 0; i < count; ++i) {
+      std::memcpy(&expanded[i * 4], &result.pixels[i * 3], 3);
+      expanded[i * 4 + 3] = 255;
+    }
+
+    result.pixels.swap(expanded);
+    result.channels = 4;
+  }
+
+  if (operations.swizzle_bgr) {
+    for (size_t i = 0; i < count; ++i) {
+      std::swap(result.pixels[i * result.channels], result.pixels[i * result.channels + 2]);
+    }
+  }
+
+  if (operations.premultiply_alpha && result.channels == 4) {
+    for (size_t i = 0; i < count; ++i) {
+      unsigned char* texel = &result.pixels[i * 4];
+
+      for (int c = 0; c < 3; ++c) {
+        unsigned int t = texel[c] * texel[3] + 128;
+        texel[c] = static_cast<unsigned char>((t + (t >> 8)) >> 8);
+      }
+    }
+  }
+
+  return result;
+}
+
+// Creates an image filled with a varying pattern.
+//
+// Parameters
+// width - width of the image
+// height - height of the image
+// channels - channels of the image
+myopengl::image create_image(int width, int height, int channels) {
+  myopengl::image result;
+  result.width = width;
+  result.height = height;
+  result.channels = channels;
+  result.pixels.resize(static_cast<size_t>(width) * height * channels);
+
+  for (size_t i = 0; i < result.pixels.size(); ++i) {
+    result.pixels[i] = static_cast<unsigned char>(i * 2654435761u >> 24);
+  }
+
+  return result;
+}
@@ -0,0 +1,200 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "myopengl/job_system.h"
+#include "myopengl/math.h"
+#include "myopengl/scene_graph.h"
+
+struct pointer_node {
+  myopengl::math::vec3 position;
+  myopengl::math::quat rotation;
+  myopengl::math::vec3 scale;
+  myopengl::math::mat4 world;
+  bool dirty;
+  std::vector<pointer_node*> children;
+};
+
+void build(int count, int branching, myopengl::scene_graph& graph, std::vector<myopengl::scene_node_t>& handles,
+    std::vector<std::unique_ptr<pointer_node>>& pointers);
+void update_pointer(pointer_node& node, const myopengl::math::mat4& parent, bool dirty);
+void run_benchmark(int count, int branching, unsigned int threads);
+
+// Entry method for the scene graph benchmark.  Compares the structure of arrays graph against a graph of individually
+// allocated nodes updated recursively, for full, partial and clean updates, then scales the full update over
+// threads.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 200000;
+  int branching = argc > 2 ? std::atoi(argv[2]) : 8;
+  unsigned int max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+
+  for (unsigned int threads = 1; threads <= max_threads; threads *= 2) {
+    run_benchmark(count, branching, threads);
+  }
+
+  return 0;
+}
+
+// Times an operation averaged over several runs, each run preceded by an untimed setup.
+//
+// Parameters
+// setup - prepares a run, i.e. by marking nodes dirty
+// function - the operation to time
+//
+// Returns the average time in milliseconds
+template <typename S, typename F>
+double time_ms(S setup, F function) {
+  const int iterations = 20;
+  double total = 0.0;
+
+  for (int i = 0; i < iterations; ++i) {
+    setup();
+
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    total += elapsed.count();
+  }
+
+  return total / iterations;
+}
+
+// Runs full, partial and clean updates of both graphs and checks their world transforms match.
+//
+// Parameters
+// count - the number of nodes
+// branching - the number of children of each interior node
+// threads - the number of threads to update the graph on
+void run_benchmark(int count, int branching, unsigned int threads) {
+  myopengl::job_system jobs(threads);
+  myopengl::scene_graph graph;
+  std::vector<myopengl::scene_node_t> handles;
+  std::vector<std::unique_ptr<pointer_node>> pointers;
+
+  build(count, branching, graph, handles, pointers);
+  graph.update(&jobs);
+
+  pointer_node& root = *pointers.front();
+  float angle = 0.0f;
+
+  auto dirty_root = [&](bool soa) {
+    angle += 0.01f;
+    const myopengl::math::quat q = myopengl::math::axis_angle(myopengl::math::vec3(0.0f, 1.0f, 0.0f), angle);
+
+    if (soa) {
+      graph.set_rotation(handles.front(), q);
+    } else {
+      root.rotation = q;
+      root.dirty = true;
+    }
+  };
+
+  auto dirty_some = [&](bool soa) {
+    angle += 0.01f;
+
+    for (size_t i = 1; i < handles.size(); i += 100) {
+      const myopengl::math::vec3 p(angle, static_cast<float>(i % 7), 0.0f);
+
+      if (soa) {
+        graph.set_position(handles[i], p);
+      } else {
+        pointers[i]->position = p;
+        pointers[i]->dirty = true;
+      }
+    }
+  };
+
+  size_t updated = 0;
+
+  double full_ms = time_ms([&]() { dirty_root(true); }, [&]() { updated = graph.update(&jobs); });
+  double full_pointer_ms = time_ms([&]() { dirty_root(false); },
+      [&]() { update_pointer(root, myopengl::math::identity(), false); });
+  double partial_ms = time_ms([&]() { dirty_some(true); }, [&]() { graph.update(&jobs); });
+  double partial_pointer_ms = time_ms([&]() { dirty_some(false); },
+      [&]() { update_pointer(root, myopengl::math::identity(), false); });
+  double clean_ms = time_ms([]() {}, [&]() { graph.update(&jobs); });
+
+  dirty_root(true);
+  angle -= 0.01f;
+  dirty_root(false);
+  angle -= 0.01f;
+  dirty_some(true);
+  angle -= 0.01f;
+  dirty_some(false);
+  graph.update(&jobs);
+  update_pointer(root, myopengl::math::identity(), false);
+
+  bool match = updated == handles.size();
+
+  for (size_t i = 0; i < handles.size() && match; i += 997) {
+    const float* a = graph.world(handles[i]).data();
+    const float* b = pointers[i]->world.data();
+
+    for (int e = 0; e < 16 && match; ++e) {
+      match = std::fabs(a[e] - b[e]) <= 1e-3f * (1.0f + std::fabs(b[e]));
+    }
+  }
+
+  std::cout << "[" << threads << " threads, " << count << " nodes, " << graph.levels() << " levels] full "
+            << full_ms << " ms (pointer " << full_pointer_ms << " ms), 1% dirty " << partial_ms << " ms (pointer "
+            << partial_pointer_ms << " ms), clean " << clean_ms << " ms" << (match ? "" : " OUTPUT MISMATCH")
+            << std::endl;
+}
+
+// Builds the same tree in both graphs, in breadth first order, with every node given a transform.
+//
+// Parameters
+// count - the number of nodes
+// branching - the number of children of each interior node
+// graph - the structure of arrays graph to build
+// handles - receives the handle of each node
+// pointers - receives each node of the pointer graph
+void build(int count, int branching, myopengl::scene_graph& graph, std::vector<myopengl::scene_node_t>& handles,
+    std::vector<std::unique_ptr<pointer_node>>& pointers) {
+  for (int i = 0; i < count; ++i) {
+    const int parent = i == 0 ? -1 : (i - 1) / branching;
+    const myopengl::math::vec3 position(static_cast<float>(i % branching), 1.0f, 0.0f);
+    const myopengl::math::quat rotation
+        = myopengl::math::axis_angle(myopengl::math::vec3(0.0f, 0.0f, 1.0f), 0.1f * (i % 5));
+    const myopengl::math::vec3 scale(0.9f, 0.9f, 0.9f);
+
+    handles.push_back(graph.add(parent < 0 ? myopengl::no_scene_node : handles[parent]));
+    graph.set_position(handles.back(), position);
+    graph.set_rotation(handles.back(), rotation);
+    graph.set_scale(handles.back(), scale);
+
+    pointers.emplace_back(new pointer_node { position, rotation, scale, myopengl::math::identity(), true, {} });
+
+    if (parent >= 0) {
+      pointers[parent]->children.push_back(pointers.back().get());
+    }
+  }
+}
+
+// Recursively recomputes the world transforms of dirty nodes and their descendants.
+//
+// Parameters
+// node - the node to update
+// parent - the world transform of the node's parent
+// dirty - true if the parent's world transform changed
+void update_pointer(pointer_node& node, const myopengl::math::mat4& parent, bool dirty) {
+  dirty = dirty || node.dirty;
+
+  if (dirty) {
+    node.world = parent * myopengl::math::compose(node.position, node.rotation, node.scale);
+    node.dirty = false;
+  }
+
+  for (pointer_node* child : node.children) {
+    update_pointer(*child, node.world, dirty);
+  }
+}
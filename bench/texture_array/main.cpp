@@ -0,0 +1,280 @@
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/image.h"
+#include "myopengl/shader.h"
+#include "myopengl/shader_exception.h"
+#include "myopengl/texture.h"
+#include "myopengl/texture_exception.h"
+
+int run_benchmark(int objects, int textures, int frames);
+myopengl::image create_layer_image(int size, int index);
+unsigned int create_quad(unsigned int& vbo, unsigned int& ebo);
+double time_frames(myopengl::context& context, int frames, void (*draw)(void*), void* data);
+
+struct scene {
+  int objects;
+  int textures;
+  float scale;
+  unsigned int vao;
+  std::vector<float> offsets;
+  std::vector<unsigned int> texture_ids;
+  myopengl::shader* shader;
+};
+
+// Entry method for the texture array benchmark.  Draws thousands of quads, each using one of many distinct
+// textures, first with a bind and draw per object and then with a single instanced draw from a texture array.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+int main(int argc, char* argv[]) {
+  int objects = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int textures = argc > 2 ? std::atoi(argv[2]) : 256;
+  int frames = argc > 3 ? std::atoi(argv[3]) : 200;
+
+  try {
+    return run_benchmark(objects, textures, frames);
+  } catch (myopengl::context_exception& e) {
+    std::cout << "Error creating context: [" << e.what() << "]" << std::endl;
+  } catch (myopengl::shader_exception& e) {
+    std::cout << "Error loading shaders: [" << e.what() << "]" << std::endl;
+  } catch (myopengl::texture_exception& e) {
+    std::cout << "Error creating textures: [" << e.what() << "]" << std::endl;
+  }
+
+  return -1;
+}
+
+// Draws every object with its own texture bind, offset uniform and draw call.
+//
+// Parameters
+// context - the scene being drawn
+void draw_with_binds(void* context) {
+  scene& s = *static_cast<scene*>(context);
+
+  s.shader->use();
+  glBindVertexArray(s.vao);
+  glActiveTexture(GL_TEXTURE0);
+
+  for (int i = 0; i < s.objects; ++i) {
+    glBindTexture(GL_TEXTURE_2D, s.texture_ids[i % s.textures]);
+    s.shader->set_vec2("Offset", s.offsets[i * 3], s.offsets[i * 3 + 1]);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+  }
+}
+
+// Draws every object in one instanced call, each instance selecting its layer of the texture array.
+//
+// Parameters
+// context - the scene being drawn
+void draw_instanced(void* context) {
+  scene& s = *static_cast<scene*>(context);
+
+  s.shader->use();
+  glBindVertexArray(s.vao);
+  glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, s.objects);
+}
+
+// Runs both modes and reports the average frame time of each.
+//
+// Parameters
+// objects - the number of quads to draw each frame
+// textures - the number of distinct textures
+// frames - the number of frames to time for each mode
+//
+// Returns a status code which should be returned to the OS
+int run_benchmark(int objects, int textures, int frames) {
+  myopengl::context_options options;
+  options.title = "bench_texture_array";
+  options.headless = true;
+
+  std::unique_ptr<myopengl::context> context = myopengl::create_context(options);
+
+  const int texture_size = 32;
+  const int columns = 64;
+
+  myopengl::shader bind_shader("./shader/bind_vertex.glsl", "./shader/bind_fragment.glsl");
+  myopengl::shader array_shader("./shader/vertex.glsl", "./shader/fragment.glsl");
+
+  myopengl::texture_array array(texture_size, texture_size, 4, textures);
+  std::vector<unsigned int> texture_ids(textures);
+
+  glGenTextures(textures, texture_ids.data());
+
+  for (int i = 0; i < textures; ++i) {
+    myopengl::image layer = create_layer_image(texture_size, i);
+
+    array.add_layer(layer);
+
+    glBindTexture(GL_TEXTURE_2D, texture_ids[i]);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, layer.width, layer.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, layer.pixels.data());
+  }
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  scene s;
+  s.objects = objects;
+  s.textures = textures;
+  s.scale = 1.0f / columns;
+  s.texture_ids = texture_ids;
+
+  for (int i = 0; i < objects; ++i) {
+    s.offsets.push_back(-1.0f + (i % columns + 0.5f) * 2.0f / columns);
+    s.offsets.push_back(-1.0f + (i / columns % columns + 0.5f) * 2.0f / columns);
+    s.offsets.push_back(static_cast<float>(i % textures));
+  }
+
+  unsigned int vbo = 0;
+  unsigned int ebo = 0;
+  unsigned int instance_vbo = 0;
+
+  s.vao = create_quad(vbo, ebo);
+
+  glBindVertexArray(s.vao);
+  glGenBuffers(1, &instance_vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+  glBufferData(GL_ARRAY_BUFFER, s.offsets.size() * sizeof(float), s.offsets.data(), GL_STATIC_DRAW);
+
+  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+  glEnableVertexAttribArray(2);
+  glVertexAttribDivisor(2, 1);
+
+  glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)(2 * sizeof(float)));
+  glEnableVertexAttribArray(3);
+  glVertexAttribDivisor(3, 1);
+
+  glBindVertexArray(0);
+
+  bind_shader.use();
+  bind_shader.set_int("Texture", 0);
+  bind_shader.set_float("Scale", s.scale);
+
+  array_shader.use();
+  array_shader.set_int("Textures", 0);
+  array_shader.set_float("Scale", s.scale);
+  array.bind(0);
+
+  s.shader = &bind_shader;
+  double bind_ms = time_frames(*context, frames, draw_with_binds, &s);
+
+  array.bind(0);
+  s.shader = &array_shader;
+  double array_ms = time_frames(*context, frames, draw_instanced, &s);
+
+  std::cout << objects << " objects, " << textures << " textures" << std::endl;
+  std::cout << "[bind per object] " << bind_ms << " ms/frame" << std::endl;
+  std::cout << "[texture array instanced] " << array_ms << " ms/frame, speedup " << bind_ms / array_ms << "x"
+            << std::endl;
+
+  glDeleteTextures(textures, texture_ids.data());
+  glDeleteVertexArrays(1, &s.vao);
+  glDeleteBuffers(1, &vbo);
+  glDeleteBuffers(1, &ebo);
+  glDeleteBuffers(1, &instance_vbo);
+
+  return 0;
+}
+
+// Times a number of frames, waiting for the GPU to finish each one.
+//
+// Parameters
+// context - the context to present with
+// frames - the number of frames to time
+// draw - function drawing the scene
+// data - passed to the draw function
+//
+// Returns the average frame time in milliseconds
+double time_frames(myopengl::context& context, int frames, void (*draw)(void*), void* data) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < frames; ++i) {
+    glClear(GL_COLOR_BUFFER_BIT);
+    draw(data);
+    context.swap_buffers();
+    glFinish();
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / frames;
+}
+
+// Creates a quad with positions and texture coordinates.
+//
+// Parameters
+// vbo - set to the id of the vertex buffer
+// ebo - set to the id of the element buffer
+//
+// Returns the OpenGL generated id for the vertex array
+unsigned int create_quad(unsigned int& vbo, unsigned int& ebo) {
+  float vertices[] = {
+    1.0f, 1.0f, 0.0f, 1.0f, 1.0f, // top right
+    1.0f, -1.0f, 0.0f, 1.0f, 0.0f, // bottom right
+    -1.0f, -1.0f, 0.0f, 0.0f, 0.0f, // bottom left
+    -1.0f, 1.0f, 0.0f, 0.0f, 1.0f // top left
+  };
+
+  unsigned int indices[] = {
+    0, 1, 3,
+    1, 2, 3
+  };
+
+  unsigned int vao = 0;
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  glGenBuffers(1, &vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+  glEnableVertexAttribArray(0);
+
+  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+  glEnableVertexAttribArray(1);
+
+  glGenBuffers(1, &ebo);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+  glBindVertexArray(0);
+
+  return vao;
+}
+
+// Creates a distinct image for a layer, a checkerboard tinted by the layer index.
+//
+// Parameters
+// size - width and height of the image
+// index - index of the layer
+myopengl::image create_layer_image(int size, int index) {
+  myopengl::image result;
+  result.width = size;
+  result.height = size;
+  result.channels = 4;
+  result.pixels.resize(static_cast<size_t>(size) * size * 4);
+
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      unsigned char* texel = &result.pixels[(static_cast<size_t>(y) * size + x) * 4];
+      bool check = ((x / 4) + (y / 4)) % 2 == 0;
+
+      texel[0] = static_cast<unsigned char>(index * 37);
+      texel[1] = static_cast<unsigned char>(index * 91);
+      texel[2] = check ? 255 : static_cast<unsigned char>(index * 13);
+      texel[3] = 255;
+    }
+  }
+
+  return result;
+}
@@ -1,16 +1,22 @@
 #include <glad/glad.h>
 
-#include <GLFW/glfw3.h>
-
 #include <iostream>
+#include <memory>
 #include <vector>
 
+#include "myopengl/app_options.h"
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/file_exception.h"
+#include "myopengl/frame_pacer.h"
+#include "myopengl/frame_recorder.h"
+#include "myopengl/gl_intercept.h"
 #include "myopengl/shader.h"
 #include "myopengl/shader_exception.h"
 
-int run_application();
-void process_input(GLFWwindow* window);
-void on_window_change(GLFWwindow* window, int width, int height);
+int run_application(int argc, char* argv[]);
+void process_input(myopengl::context& context);
+void on_window_change(int width, int height);
 unsigned int compile_shader(unsigned int type, const char* source);
 unsigned int link_shaders(const std::vector<unsigned int>& shaders);
 unsigned int create_vertex_buffer(float* vertices, size_t n);
@@ -22,37 +28,34 @@ unsigned int create_vertex_buffer(float* vertices, size_t n);
 // argv - array of command line arguments
 int main(int argc, char* argv[]) {
   try {
-    return run_application();
+    return run_application(argc, argv);
+  } catch (myopengl::context_exception& e) {
+    std::cout << "Error creating context: [" << e.what() << "]" << std::endl;
   } catch (myopengl::shader_exception& e) {
     std::cout << "Error loading shaders: [" << e.what() << "]" << std::endl;
+  } catch (myopengl::file_exception& e) {
+    std::cout << "Error writing files: [" << e.what() << "]" << std::endl;
   }
+
+  return -1;
 }
 
-// Runs the application
+// Runs the application.  Pass --headless to render offscreen without a window, --frames N to exit after N frames
+// and --stats PATH to write frame time statistics as JSON.  Pass --swap-interval N and --fps N to control frame
+// pacing and --pacing PATH to write pacing statistics as JSON.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
 //
 // Returns a status code which should be returned to the OS
-int run_application() {
-  glfwInit();
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-  GLFWwindow* window = glfwCreateWindow(800, 600, "OpenGL", NULL, NULL);
-
-  if (window == NULL) {
-    std::cout << "Failed to create window" << std::endl;
-    glfwTerminate();
-    return -1;
-  }
+int run_application(int argc, char* argv[]) {
+  myopengl::context_options options = myopengl::parse_context_options(argc, argv, "OpenGL");
+  myopengl::app_options app = myopengl::parse_app_options(argc, argv);
 
-  glfwMakeContextCurrent(window);
-  glfwSetFramebufferSizeCallback(window, on_window_change);
-
-  if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-    std::cout << "Failed to initialise GLAD" << std::endl;
-    glfwTerminate();
-    return -1;
-  }
+  std::unique_ptr<myopengl::context> context = myopengl::create_context(options);
+  myopengl::set_gl_call_timing(app.gl_timing);
+  context->set_resize_callback(on_window_change);
 
   myopengl::shader default_shader("./shader/vertex.glsl", "./shader/fragment.glsl");
 
@@ -70,8 +73,13 @@ int run_application() {
 
   vbo = create_vertex_buffer(vertices, sizeof(vertices));
 
-  while (!glfwWindowShouldClose(window)) {
-    process_input(window);
+  myopengl::frame_recorder recorder(options.title);
+  myopengl::frame_pacer pacer(*context, app.target_fps);
+
+  while (!context->should_close()) {
+    recorder.begin_frame();
+
+    process_input(*context);
 
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -80,36 +88,48 @@ int run_application() {
     default_shader.set_float("offset", 0.0f);
 
     glBindVertexArray(vao);
+    myopengl::record_state_change();
     glDrawArrays(GL_TRIANGLES, 0, 3);
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+    myopengl::record_draw_call();
+    pacer.present();
+    pacer.poll_events();
+
+    recorder.end_frame();
+  }
+
+  recorder.finish();
+
+  if (!app.stats_path.empty()) {
+    recorder.write_json(app.stats_path);
+  }
+
+  if (!app.pacing_path.empty()) {
+    pacer.write_json(app.pacing_path);
   }
 
   glDeleteVertexArrays(1, &vao);
   glDeleteBuffers(1, &vbo);
 
-  glfwTerminate();
-
   return 0;
 }
 
-// Function callback registered with GLFW called when window dimensions change.  Allows us to reset the OpenGL viewport.
+// Function callback registered with the context called when the framebuffer dimensions change.  Allows us to reset
+// the OpenGL viewport.
 //
 // Parameters
-// window - the window whose dimensions have changed
-// width - the new width of the window
-// height - the new height of the window
-void on_window_change(GLFWwindow* window, int width, int height) {
+// width - the new width of the framebuffer
+// height - the new height of the framebuffer
+void on_window_change(int width, int height) {
   glViewport(0, 0, width, height);
 }
 
-// Handles input events on the GLFW window.  Called during rendering loop.
+// Handles input on the context.  Called during rendering loop.
 //
 // Parameters
-// window - the window which has received input.
-void process_input(GLFWwindow* window) {
-  if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-    glfwSetWindowShouldClose(window, true);
+// context - the context which has received input.
+void process_input(myopengl::context& context) {
+  if (context.key_pressed(myopengl::key::escape)) {
+    context.request_close();
   }
 }
 
@@ -1,24 +1,47 @@
 #include <glad/glad.h>
 
-#include <GLFW/glfw3.h>
-
-#include <stb/stb_image.h>
-
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <vector>
 
+#include "myopengl/app_options.h"
+#include "myopengl/atlas.h"
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/dynamic_resolution.h"
+#include "myopengl/file_exception.h"
+#include "myopengl/frame_clock.h"
+#include "myopengl/frame_pipeline.h"
+#include "myopengl/frame_pacer.h"
+#include "myopengl/frame_recorder.h"
+#include "myopengl/gl_intercept.h"
+#include "myopengl/gpu_profiler.h"
+#include "myopengl/image.h"
+#include "myopengl/job_system.h"
+#include "myopengl/mipmap.h"
+#include "myopengl/sampler_cache.h"
 #include "myopengl/shader.h"
 #include "myopengl/shader_exception.h"
-
-typedef void (*configure_texture_t)(void);
-
-int run_application();
-void process_input(GLFWwindow* window, myopengl::shader& shader, float& mix);
-void on_window_change(GLFWwindow* window, int width, int height);
+#include "myopengl/texture.h"
+#include "myopengl/texture_exception.h"
+#include "myopengl/texture_streamer.h"
+#include "myopengl/trace.h"
+
+struct frame_state {
+  float previous_mix;
+  float mix;
+  double alpha;
+};
+
+int run_application(int argc, char* argv[]);
+void process_input(myopengl::context& context, std::atomic<int>& mix_direction);
+frame_state update_state(const frame_state& previous, int mix_direction, int steps, double alpha);
+void on_window_change(int width, int height);
 unsigned int create_vertex_buffer(float* vertices, size_t n);
 unsigned int create_element_buffer(unsigned int* indices, size_t n);
-unsigned int create_texture(const char* path, unsigned int format, configure_texture_t configure_texture);
-void standard_texture_configuration();
+unsigned int create_atlas(const std::vector<const char*>& paths, myopengl::texture_streamer& streamer,
+    std::vector<myopengl::atlas_region>& regions);
 
 // Entry method for the applications
 //
@@ -27,37 +50,45 @@ void standard_texture_configuration();
 // argv - array of command line arguments
 int main(int argc, char* argv[]) {
   try {
-    return run_application();
+    return run_application(argc, argv);
+  } catch (myopengl::context_exception& e) {
+    std::cout << "Error creating context: [" << e.what() << "]" << std::endl;
   } catch (myopengl::shader_exception& e) {
     std::cout << "Error loading shaders: [" << e.what() << "]" << std::endl;
+  } catch (myopengl::texture_exception& e) {
+    std::cout << "Error loading textures: [" << e.what() << "]" << std::endl;
+  } catch (myopengl::file_exception& e) {
+    std::cout << "Error accessing files: [" << e.what() << "]" << std::endl;
   }
+
+  return -1;
 }
 
-// Runs the application
+// Runs the application.  Pass --headless to render offscreen without a window, --frames N to exit after N frames
+// and --stats PATH to write frame time statistics as JSON.  Pass --swap-interval N and --fps N to control frame
+// pacing and --pacing PATH to write pacing statistics as JSON.  Pass --profile to report the CPU and GPU time of each
+// pass and --trace PATH to write a CPU trace of startup and every frame when built with MYOPENGL_TRACE.
+//
+// The state of the next frame is updated on a job while the current frame is rendered from its own, triple
+// buffered, copy of the state.  Updates run fixed simulation steps and rendering interpolates between the last two,
+// so the mix changes at the same rate whatever the frame rate.  Pass --gpu-budget MS to render the scene at a
+// resolution adjusted each frame to keep its GPU time within the budget, upscaled to the window.
+//
+// Both images are packed into one atlas page, so each frame binds a single texture and sampler.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
 //
 // Returns a status code which should be returned to the OS
-int run_application() {
-  glfwInit();
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-  GLFWwindow* window = glfwCreateWindow(800, 600, "OpenGL", NULL, NULL);
-
-  if (window == NULL) {
-    std::cout << "Failed to create window" << std::endl;
-    glfwTerminate();
-    return -1;
-  }
+int run_application(int argc, char* argv[]) {
+  myopengl::context_options options = myopengl::parse_context_options(argc, argv, "OpenGL");
+  myopengl::app_options app = myopengl::parse_app_options(argc, argv);
+  options.srgb = true;
 
-  glfwMakeContextCurrent(window);
-  glfwSetFramebufferSizeCallback(window, on_window_change);
-
-  if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-    std::cout << "Failed to initialise GLAD" << std::endl;
-    glfwTerminate();
-    return -1;
-  }
+  std::unique_ptr<myopengl::context> context = myopengl::create_context(options);
+  myopengl::set_gl_call_timing(app.gl_timing);
+  context->set_resize_callback(on_window_change);
 
   myopengl::shader default_shader("./shader/vertex.glsl", "./shader/fragment.glsl");
 
@@ -77,76 +108,202 @@ int run_application() {
   glGenVertexArrays(1, &vao);
   glBindVertexArray(vao);
 
-  stbi_set_flip_vertically_on_load(true);
-
   unsigned int vbo = create_vertex_buffer(vertices, sizeof(vertices));
   unsigned int ebo = create_element_buffer(indices, sizeof(indices));
-  unsigned int texture = create_texture("./texture/container.jpg", GL_RGB, standard_texture_configuration);
-  unsigned int texture2 = create_texture("./texture/awesomeface.png", GL_RGBA, standard_texture_configuration);
+  myopengl::job_system jobs;
+  std::vector<myopengl::atlas_region> regions;
+  myopengl::texture_streamer streamer(256 * 1024, 32, &jobs);
+  myopengl::sampler_cache samplers;
+  const myopengl::sampler_descriptor atlas_sampler = { GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE, GL_LINEAR, GL_LINEAR };
 
-  glBindVertexArray(0);
+  unsigned int texture = create_atlas({ "./texture/container.jpg", "./texture/awesomeface.png" }, streamer, regions);
+  bool regions_set = false;
 
-  float mix = 0.2f;
+  glBindVertexArray(0);
 
   default_shader.use();
-  default_shader.set_int("Texture2", 1);
-  default_shader.set_float("Mix", mix);
 
-  while (!glfwWindowShouldClose(window)) {
-    process_input(window, default_shader, mix);
+  std::atomic<int> mix_direction(0);
+  std::vector<frame_state> states(3, { 0.2f, 0.2f, 0.0 });
+  myopengl::frame_clock clock;
+
+  myopengl::frame_pipeline pipeline(jobs, [&states, &mix_direction, &clock](size_t, int previous, int next) {
+    int steps = clock.advance();
+    states[next] = update_state(states[previous], mix_direction.load(), steps, clock.alpha());
+  }, static_cast<int>(states.size()));
 
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);    
+  std::unique_ptr<myopengl::dynamic_resolution> resolution;
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, texture2);
-    
-    glBindVertexArray(vao);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+  if (app.gpu_budget_ms > 0.0) {
+    myopengl::dynamic_resolution_options resolution_options;
+    resolution_options.budget_ms = app.gpu_budget_ms;
+    resolution_options.srgb = options.srgb;
 
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+    resolution = std::make_unique<myopengl::dynamic_resolution>(resolution_options);
+  }
+
+  myopengl::frame_recorder recorder(options.title);
+  myopengl::frame_pacer pacer(*context, app.target_fps);
+  myopengl::gpu_profiler profiler;
+
+  while (!context->should_close()) {
+    MYOPENGL_TRACE_SCOPE("frame");
+
+    recorder.begin_frame();
+
+    if (app.profile) {
+      profiler.begin_frame();
+    }
+
+    process_input(*context, mix_direction);
+
+    const frame_state& state = states[pipeline.begin_frame()];
+
+    {
+      MYOPENGL_TRACE_SCOPE("stream");
+      myopengl::gpu_scope scope("stream");
+      streamer.update();
+    }
+
+    if (!regions_set && !streamer.loading(texture)) {
+      default_shader.set_vec2("Offset1", regions[0].uv_offset[0], regions[0].uv_offset[1]);
+      default_shader.set_vec2("Scale1", regions[0].uv_scale[0], regions[0].uv_scale[1]);
+      default_shader.set_vec2("Offset2", regions[1].uv_offset[0], regions[1].uv_offset[1]);
+      default_shader.set_vec2("Scale2", regions[1].uv_scale[0], regions[1].uv_scale[1]);
+      regions_set = true;
+    }
+
+    {
+      MYOPENGL_TRACE_SCOPE("draw");
+      myopengl::gpu_scope scope("draw");
+
+      if (resolution) {
+        int width = 0;
+        int height = 0;
+        context->framebuffer_size(width, height);
+        resolution->begin_frame(width, height);
+      }
+
+      glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+
+      default_shader.set_float("Mix", myopengl::interpolate(state.previous_mix, state.mix, state.alpha));
+
+      myopengl::bind_texture(0, GL_TEXTURE_2D, texture);
+      samplers.bind(0, atlas_sampler);
+
+      glBindVertexArray(vao);
+      myopengl::record_state_change();
+      glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+      myopengl::record_draw_call();
+
+      if (resolution) {
+        resolution->end_frame(context->framebuffer());
+      }
+    }
+
+    if (app.profile) {
+      profiler.end_frame();
+    }
+
+    {
+      MYOPENGL_TRACE_SCOPE("present");
+      pacer.present();
+      pacer.poll_events();
+    }
+
+    pipeline.end_frame();
+    recorder.end_frame();
+  }
+
+  pipeline.finish();
+  recorder.finish();
+  profiler.finish();
+
+  if (!app.stats_path.empty()) {
+    recorder.write_json(app.stats_path);
+  }
+
+  if (!app.pacing_path.empty()) {
+    pacer.write_json(app.pacing_path);
+  }
+
+  if (app.profile) {
+    profiler.write_report(std::cout);
+  }
+
+  if (resolution) {
+    std::cout << "Dynamic resolution scale [" << resolution->scale() << "], GPU time [" << resolution->gpu_ms()
+              << "] ms" << std::endl;
+  }
+
+  if (!app.trace_path.empty()) {
+    myopengl::write_chrome_trace(app.trace_path);
   }
 
   glDeleteVertexArrays(1, &vao);
   glDeleteBuffers(1, &vbo);
   glDeleteBuffers(1, &ebo);
 
-  glfwTerminate();
-
   return 0;
 }
 
-// Function callback registered with GLFW called when window dimensions change.  Allows us to reset the OpenGL viewport.
+// Function callback registered with the context called when the framebuffer dimensions change.  Allows us to reset
+// the OpenGL viewport.
 //
 // Parameters
-// window - the window whose dimensions have changed
-// width - the new width of the window
-// height - the new height of the window
-void on_window_change(GLFWwindow* window, int width, int height) {
+// width - the new width of the framebuffer
+// height - the new height of the framebuffer
+void on_window_change(int width, int height) {
   glViewport(0, 0, width, height);
 }
 
-// Handles input events on the GLFW window.  Called during rendering loop.
+// Handles input on the context.  Called during rendering loop.
 //
 // Parameters
-// window - the window which has received input.
-void process_input(GLFWwindow* window, myopengl::shader& shader, float& mix) {
-  if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-    glfwSetWindowShouldClose(window, true);
+// context - the context which has received input.
+// mix_direction - set to the direction the mix should move in, read by updates
+void process_input(myopengl::context& context, std::atomic<int>& mix_direction) {
+  if (context.key_pressed(myopengl::key::escape)) {
+    context.request_close();
   }
 
-  if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) {
-    mix = mix < 1.0f ? mix += 0.01f : mix;
-    shader.set_float("Mix", mix);
+  if (context.key_pressed(myopengl::key::up)) {
+    mix_direction = 1;
+  } else if (context.key_pressed(myopengl::key::down)) {
+    mix_direction = -1;
+  } else {
+    mix_direction = 0;
   }
+}
 
-  if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
-    mix = mix > 0.0f ? mix -= 0.01f : mix;
-    shader.set_float("Mix", mix);
+// Updates the state of a frame from the previous one by a number of fixed simulation steps.  Called on a job while
+// an earlier frame is rendered.
+//
+// Parameters
+// previous - the state of the previous frame
+// mix_direction - the direction the mix should move in
+// steps - the number of simulation steps to run
+// alpha - how far the frame falls between the last two steps
+//
+// Returns the state of the next frame
+frame_state update_state(const frame_state& previous, int mix_direction, int steps, double alpha) {
+  frame_state next = previous;
+  next.alpha = alpha;
+
+  for (int i = 0; i < steps; ++i) {
+    next.previous_mix = next.mix;
+
+    if (mix_direction > 0 && next.mix < 1.0f) {
+      next.mix += 0.01f;
+    }
+
+    if (mix_direction < 0 && next.mix > 0.0f) {
+      next.mix -= 0.01f;
+    }
   }
+
+  return next;
 }
 
 // Creates and returns a vertex buffer.
@@ -196,45 +353,47 @@ unsigned int create_element_buffer(unsigned int* indices, size_t n) {
   return ebo;
 }
 
-// Creates a new texture, configures it, loads an image file into the texture and generates midmaps.
+// Creates a texture holding an atlas of image files with a mip chain generated on the CPU.  Decoding, packing and
+// mipmapping run on the streamer's job system, so the texture is a placeholder until the streamer reports it is no
+// longer loading.  The images are flipped and expanded to RGBA as they are decoded, then packed into a single page.
+// Cells are aligned and extruded for every level down to the thumbnail the streamer uploads first, so sampling
+// whichever level is resident never reaches a neighbouring image.  Only the smallest levels are uploaded once the
+// chain is ready, the rest are streamed in over the following frames.  Filtering and wrapping come from sampler
+// objects bound at draw time rather than per texture parameters.
 //
 // Parameters
-// path - path to the image file to load
-// format - colour format to be used (GL_RGB/GL_RGBA)
-// configure_texture - a function pointer to a method to configure the texture
+// paths - paths to the image files to load
+// streamer - the streamer which loads the atlas and uploads its levels
+// regions - receives the region of each image in the atlas, in the order of paths, once the texture has loaded.
+//           Must outlive the streamer
 //
 // Returns the OpenGL generated id for the texture
-unsigned int create_texture(const char* path, unsigned int format, configure_texture_t configure_texture) {
-  unsigned int texture = 0;
+unsigned int create_atlas(const std::vector<const char*>& paths, myopengl::texture_streamer& streamer,
+    std::vector<myopengl::atlas_region>& regions) {
+  myopengl::atlas_options atlas_options;
+  atlas_options.mip_levels = 7;
 
-  glGenTextures(1, &texture);
-  glBindTexture(GL_TEXTURE_2D, texture);
+  return streamer.add(atlas_options.page_size, atlas_options.page_size, 4, myopengl::colour_space::srgb,
+      [paths, atlas_options, &regions]() {
+    myopengl::pixel_operations operations;
+    operations.flip_vertically = true;
 
-  configure_texture();
+    myopengl::atlas_builder atlas(atlas_options);
 
-  int width = 0;
-  int height = 0;
-  int channels = 0;
+    for (const char* path : paths) {
+      atlas.add(myopengl::load_image(path, operations, 4));
+    }
 
-  unsigned char* data = stbi_load(path, &width, &height, &channels, 0);
+    atlas.build();
 
-  if (data != NULL) {
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-  } else {
-    std::cout << "Failed to load texture [" << path << "]" << std::endl;  
-  }
+    if (atlas.pages().size() != 1) {
+      throw myopengl::texture_exception("Images do not fit a single atlas page");
+    }
 
-  glBindTexture(GL_TEXTURE_2D, 0);
-  stbi_image_free(data);
+    for (size_t i = 0; i < paths.size(); ++i) {
+      regions.push_back(atlas.region(i));
+    }
 
-  return texture;
+    return myopengl::generate_mip_chain(atlas.pages().front());
+  });
 }
-
-// Sets the standard options for a texture
-void standard_texture_configuration() {
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-}
\ No newline at end of file
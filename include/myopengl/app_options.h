@@ -0,0 +1,22 @@
+#ifndef MYOPENGL_APP_OPTIONS_H
+#define MYOPENGL_APP_OPTIONS_H
+
+#include <string>
+
+namespace myopengl {
+
+struct app_options {
+  double target_fps = 0.0;
+  double gpu_budget_ms = 0.0;
+  std::string stats_path;
+  bool profile = false;
+  std::string trace_path;
+  std::string pacing_path;
+  bool gl_timing = false;
+};
+
+app_options parse_app_options(int argc, char* argv[]);
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef MYOPENGL_ATLAS_H
+#define MYOPENGL_ATLAS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "myopengl/image.h"
+
+namespace myopengl {
+
+struct atlas_options {
+  int page_size = 2048;
+  int padding = 2;
+  int mip_levels = 1;
+};
+
+struct atlas_region {
+  int page = 0;
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+  float uv_offset[2] = { 0.0f, 0.0f };
+  float uv_scale[2] = { 1.0f, 1.0f };
+};
+
+class atlas_builder {
+
+  public:
+  atlas_builder(const atlas_options& options = atlas_options());
+
+  size_t add(image source);
+  void build();
+
+  size_t size() const noexcept;
+  const std::vector<image>& pages() const noexcept;
+  const atlas_region& region(size_t index) const;
+
+  void remap_uvs(size_t index, float* vertices, size_t count, size_t stride, size_t offset) const;
+
+  private:
+  struct skyline_node {
+    int x;
+    int y;
+    int width;
+  };
+
+  atlas_options _options;
+  std::vector<image> _sources;
+  std::vector<atlas_region> _regions;
+  std::vector<std::vector<skyline_node>> _skylines;
+  std::vector<image> _pages;
+  bool _built;
+
+  bool find_position(const std::vector<skyline_node>& skyline, int width, int height, int& x, int& y, size_t& node) const;
+  void place(std::vector<skyline_node>& skyline, size_t node, int x, int y, int width, int height);
+  void blit(const image& source, const atlas_region& region, int x, int y, int width, int height);
+};
+
+}
+
+#endif
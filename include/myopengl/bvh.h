@@ -0,0 +1,61 @@
+#ifndef MYOPENGL_BVH_H
+#define MYOPENGL_BVH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "myopengl/culling.h"
+#include "myopengl/job_system.h"
+#include "myopengl/math.h"
+
+namespace myopengl {
+
+struct bvh_node {
+  math::vec3 min;
+  uint32_t first;
+  math::vec3 max;
+  uint32_t count;
+};
+
+struct bvh_options {
+  int bins = 16;
+  int max_leaf_size = 4;
+  size_t parallel_threshold = 16384;
+};
+
+struct ray {
+  math::vec3 origin;
+  math::vec3 direction;
+};
+
+struct ray_hit {
+  uint32_t object = 0;
+  float distance = 0.0f;
+};
+
+class bvh {
+
+  public:
+  bvh(const bounding_boxes& boxes, const bvh_options& options = bvh_options(), job_system* jobs = NULL);
+
+  void refit(const bounding_boxes& boxes);
+
+  size_t query(const frustum& f, std::vector<uint32_t>& visible) const;
+  bool raycast(const ray& r, float max_distance, ray_hit& hit) const noexcept;
+
+  const std::vector<bvh_node>& nodes() const noexcept;
+  size_t size() const noexcept;
+  int depth() const noexcept;
+
+  private:
+  std::vector<bvh_node> _nodes;
+  std::vector<uint32_t> _objects;
+  std::vector<math::vec3> _mins;
+  std::vector<math::vec3> _maxs;
+  int _depth;
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef MYOPENGL_COMMAND_BUFFER_H
+#define MYOPENGL_COMMAND_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace myopengl {
+
+enum class command_type : uint32_t {
+  use_program,
+  bind_vertex_array,
+  bind_texture,
+  uniform_int,
+  uniform_float,
+  uniform_vec2,
+  uniform_vec4,
+  uniform_mat4,
+  draw_arrays,
+  draw_elements,
+  draw_elements_instanced
+};
+
+class command_buffer {
+
+  public:
+  command_buffer(size_t reserve_bytes = 64 * 1024);
+
+  void use_program(unsigned int program);
+  void bind_vertex_array(unsigned int vertex_array);
+  void bind_texture(unsigned int unit, unsigned int target, unsigned int texture);
+  void set_uniform(int location, int value);
+  void set_uniform(int location, float value);
+  void set_uniform(int location, float x, float y);
+  void set_uniform(int location, float x, float y, float z, float w);
+  void set_uniform_matrix(int location, const float* matrix);
+  void draw_arrays(unsigned int mode, int first, int count);
+  void draw_elements(unsigned int mode, int count, unsigned int type, size_t offset);
+  void draw_elements_instanced(unsigned int mode, int count, unsigned int type, size_t offset, int instances);
+
+  void clear() noexcept;
+  size_t size() const noexcept;
+  size_t commands() const noexcept;
+
+  void replay() const;
+
+  private:
+  friend void replay(const std::vector<command_buffer>& buffers);
+
+  struct replay_state {
+    unsigned int program = ~0u;
+    unsigned int vertex_array = ~0u;
+    unsigned int active_unit = ~0u;
+  };
+
+  template <typename command_t>
+  void push(const command_t& command);
+
+  void replay(replay_state& state) const;
+
+  std::vector<unsigned char> _data;
+  size_t _commands;
+};
+
+void replay(const std::vector<command_buffer>& buffers);
+
+}
+
+#endif
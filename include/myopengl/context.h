@@ -0,0 +1,70 @@
+#ifndef MYOPENGL_CONTEXT_H
+#define MYOPENGL_CONTEXT_H
+
+#include <memory>
+#include <string>
+
+#include "myopengl/extensions.h"
+#include "myopengl/gl_loader.h"
+
+namespace myopengl {
+
+enum class key {
+  escape,
+  up,
+  down,
+  left,
+  right,
+  space
+};
+
+struct context_options {
+  int width = 800;
+  int height = 600;
+  std::string title = "OpenGL";
+  bool headless = false;
+  bool srgb = false;
+  int frame_limit = 0;
+  int swap_interval = 1;
+  gl_loading loading = gl_loading::eager;
+};
+
+typedef void (*resize_callback_t)(int width, int height);
+
+class context {
+
+  public:
+  virtual ~context() = default;
+
+  virtual void swap_buffers() = 0;
+  virtual void poll_events() = 0;
+  virtual bool key_pressed(key k) const = 0;
+  virtual void framebuffer_size(int& width, int& height) const = 0;
+  virtual void set_resize_callback(resize_callback_t callback) = 0;
+  virtual proc_loader_t proc_loader() const noexcept = 0;
+  virtual unsigned int framebuffer() const noexcept;
+  virtual bool set_swap_interval(int interval);
+  virtual double presentation_rate() const;
+  virtual void gl_loaded();
+
+  bool should_close() const noexcept;
+  void request_close() noexcept;
+  int frame() const noexcept;
+
+  protected:
+  context(const context_options& options);
+
+  void end_frame() noexcept;
+
+  private:
+  int _frame_limit;
+  int _frame;
+  bool _close_requested;
+};
+
+context_options parse_context_options(int argc, char* argv[], const char* title);
+std::unique_ptr<context> create_context(const context_options& options);
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MYOPENGL_CONTEXT_EXCEPTION_H
+#define MYOPENGL_CONTEXT_EXCEPTION_H
+
+#include <exception>
+#include <string>
+
+namespace myopengl {
+
+class context_exception : public std::exception {
+
+  public:
+  context_exception() = delete;
+  context_exception(const std::string& message) noexcept;
+
+  const char* what() const noexcept override;
+
+  private:
+  std::string _message;
+};
+
+}
+
+#endif
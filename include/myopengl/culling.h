@@ -0,0 +1,50 @@
+#ifndef MYOPENGL_CULLING_H
+#define MYOPENGL_CULLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "myopengl/job_system.h"
+#include "myopengl/math.h"
+
+namespace myopengl {
+
+struct frustum {
+  math::vec4 planes[6];
+};
+
+struct bounding_spheres {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<float> radius;
+};
+
+struct bounding_boxes {
+  std::vector<float> centre_x;
+  std::vector<float> centre_y;
+  std::vector<float> centre_z;
+  std::vector<float> extent_x;
+  std::vector<float> extent_y;
+  std::vector<float> extent_z;
+};
+
+struct cull_options {
+  size_t grain = 16384;
+  bool use_simd = true;
+};
+
+frustum extract_frustum(const math::mat4& view_projection) noexcept;
+bool intersects(const frustum& f, const math::vec3& centre, float radius) noexcept;
+bool intersects(const frustum& f, const math::vec3& centre, const math::vec3& extent) noexcept;
+void add_sphere(bounding_spheres& spheres, const math::vec3& centre, float radius);
+void add_box(bounding_boxes& boxes, const math::vec3& min, const math::vec3& max);
+size_t cull(const frustum& f, const bounding_spheres& spheres, uint32_t* visible,
+    const cull_options& options = cull_options(), job_system* jobs = NULL);
+size_t cull(const frustum& f, const bounding_boxes& boxes, uint32_t* visible,
+    const cull_options& options = cull_options(), job_system* jobs = NULL);
+
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef MYOPENGL_DYNAMIC_RESOLUTION_H
+#define MYOPENGL_DYNAMIC_RESOLUTION_H
+
+#include <vector>
+
+namespace myopengl {
+
+struct dynamic_resolution_options {
+  double budget_ms = 16.0;
+  float min_scale = 0.5f;
+  float max_scale = 1.0f;
+  float smoothing = 0.25f;
+  bool srgb = false;
+  int query_latency = 3;
+};
+
+class dynamic_resolution {
+
+  public:
+  dynamic_resolution(const dynamic_resolution_options& options);
+  ~dynamic_resolution();
+
+  dynamic_resolution(const dynamic_resolution&) = delete;
+  dynamic_resolution& operator=(const dynamic_resolution&) = delete;
+
+  void begin_frame(int output_width, int output_height);
+  void end_frame(unsigned int output_framebuffer);
+
+  float scale() const noexcept;
+  void render_size(int& width, int& height) const noexcept;
+  double gpu_ms() const noexcept;
+  unsigned int framebuffer() const noexcept;
+  unsigned int texture() const noexcept;
+
+  private:
+  void allocate(int output_width, int output_height);
+  void release();
+  bool read_oldest(bool wait);
+  void adjust(double gpu_ms);
+
+  dynamic_resolution_options _options;
+  std::vector<unsigned int> _queries;
+  size_t _next_query;
+  size_t _pending;
+  unsigned int _framebuffer;
+  unsigned int _colour;
+  unsigned int _depth_stencil;
+  int _output_width;
+  int _output_height;
+  int _render_width;
+  int _render_height;
+  float _scale;
+  double _gpu_ms;
+  bool _in_frame;
+};
+
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef MYOPENGL_EXTENSIONS_H
+#define MYOPENGL_EXTENSIONS_H
+
+namespace myopengl {
+
+typedef void* (*proc_loader_t)(const char* name);
+
+void load_extensions(proc_loader_t load);
+bool has_extension(const char* name);
+
+float max_texture_anisotropy() noexcept;
+
+bool has_texture_storage() noexcept;
+void texture_storage_2d(unsigned int target, int levels, unsigned int internal_format, int width, int height) noexcept;
+void texture_storage_3d(unsigned int target, int levels, unsigned int internal_format, int width, int height,
+    int depth) noexcept;
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MYOPENGL_FILE_EXCEPTION_H
+#define MYOPENGL_FILE_EXCEPTION_H
+
+#include <exception>
+#include <string>
+
+namespace myopengl {
+
+class file_exception : public std::exception {
+
+  public:
+  file_exception() = delete;
+  file_exception(const std::string& message) noexcept;
+
+  const char* what() const noexcept override;
+
+  private:
+  std::string _message;
+};
+
+}
+
+#endif
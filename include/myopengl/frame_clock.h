@@ -0,0 +1,38 @@
+#ifndef MYOPENGL_FRAME_CLOCK_H
+#define MYOPENGL_FRAME_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace myopengl {
+
+class frame_clock {
+
+  public:
+  frame_clock(double step = 1.0 / 60.0, int max_steps = 5);
+
+  int advance();
+  int advance(double elapsed);
+  void reset();
+
+  double step() const noexcept;
+  double alpha() const noexcept;
+  double time() const noexcept;
+  uint64_t steps() const noexcept;
+  double dropped() const noexcept;
+
+  private:
+  std::chrono::steady_clock::time_point _last;
+  double _step;
+  int _max_steps;
+  double _accumulator;
+  uint64_t _steps;
+  double _dropped;
+  bool _started;
+};
+
+float interpolate(float previous, float current, double alpha) noexcept;
+
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef MYOPENGL_FRAME_PACER_H
+#define MYOPENGL_FRAME_PACER_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "myopengl/context.h"
+#include "myopengl/frame_recorder.h"
+
+namespace myopengl {
+
+struct frame_pacing_statistics {
+  unsigned int frames = 0;
+  double target_ms = 0.0;
+  frame_statistics interval_ms;
+  double interval_stddev_ms = 0.0;
+  unsigned int missed_deadlines = 0;
+  frame_statistics latency_ms;
+};
+
+class frame_pacer {
+
+  public:
+  frame_pacer(context& ctx, double target_fps = 0.0);
+
+  void set_target_fps(double target_fps) noexcept;
+  void poll_events();
+  void present();
+
+  frame_pacing_statistics statistics() const;
+  void write_json(std::ostream& stream) const;
+  void write_json(const std::string& path) const;
+
+  private:
+  double target_period() const;
+  void sleep_until(std::chrono::steady_clock::time_point deadline);
+
+  context& _context;
+  double _target_fps;
+  std::vector<double> _intervals;
+  std::vector<double> _latencies;
+  std::chrono::steady_clock::time_point _last_present;
+  std::chrono::steady_clock::time_point _last_poll;
+  std::chrono::steady_clock::time_point _next_frame;
+  std::chrono::steady_clock::duration _sleep_margin;
+  unsigned int _missed_deadlines;
+  bool _presented;
+  bool _polled;
+};
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef MYOPENGL_FRAME_PIPELINE_H
+#define MYOPENGL_FRAME_PIPELINE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "myopengl/job_system.h"
+
+namespace myopengl {
+
+typedef std::function<void(size_t frame, int previous, int next)> frame_update_t;
+
+class frame_pipeline {
+
+  public:
+  frame_pipeline(job_system& jobs, frame_update_t update, int buffers = 3);
+  ~frame_pipeline();
+
+  frame_pipeline(const frame_pipeline&) = delete;
+  frame_pipeline& operator=(const frame_pipeline&) = delete;
+
+  int begin_frame();
+  void end_frame();
+  void finish();
+
+  int buffers() const noexcept;
+  size_t frame() const noexcept;
+
+  private:
+  void schedule();
+  void update(size_t frame);
+
+  job_system& _jobs;
+  frame_update_t _update;
+  const int _buffers;
+  std::unique_ptr<job_counter[]> _counters;
+  std::mutex _mutex;
+  size_t _scheduled;
+  size_t _rendered;
+  bool _updating;
+  bool _stopping;
+  bool _failed;
+};
+
+}
+
+#endif
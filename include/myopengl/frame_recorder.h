@@ -0,0 +1,72 @@
+#ifndef MYOPENGL_FRAME_RECORDER_H
+#define MYOPENGL_FRAME_RECORDER_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace myopengl {
+
+struct frame_sample {
+  double cpu_ms = 0.0;
+  double gpu_ms = 0.0;
+  unsigned int draw_calls = 0;
+  unsigned int state_changes = 0;
+};
+
+struct frame_statistics {
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+void record_draw_call(unsigned int count = 1) noexcept;
+void record_state_change(unsigned int count = 1) noexcept;
+
+frame_statistics summarise(std::vector<double> values);
+
+class frame_recorder {
+
+  public:
+  frame_recorder(const std::string& name, int query_latency = 3);
+  ~frame_recorder();
+
+  frame_recorder(const frame_recorder&) = delete;
+  frame_recorder& operator=(const frame_recorder&) = delete;
+
+  void begin_frame();
+  void end_frame();
+  void finish();
+
+  const std::vector<frame_sample>& samples() const noexcept;
+  void write_json(std::ostream& stream) const;
+  void write_json(const std::string& path) const;
+
+  private:
+  struct call_total {
+    const char* name;
+    unsigned long long calls;
+    double ms;
+  };
+
+  bool read_oldest(bool wait);
+
+  std::string _name;
+  std::vector<frame_sample> _samples;
+  std::vector<call_total> _gl_calls;
+  std::vector<unsigned int> _queries;
+  std::vector<size_t> _query_frames;
+  size_t _next_query;
+  size_t _pending;
+  std::chrono::steady_clock::time_point _frame_start;
+  unsigned int _draw_calls;
+  unsigned int _state_changes;
+  bool _in_frame;
+};
+
+}
+
+#endif
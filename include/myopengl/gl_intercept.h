@@ -0,0 +1,23 @@
+#ifndef MYOPENGL_GL_INTERCEPT_H
+#define MYOPENGL_GL_INTERCEPT_H
+
+#include <vector>
+
+namespace myopengl {
+
+struct gl_call_count {
+  const char* name;
+  unsigned int calls;
+  double ms;
+};
+
+bool gl_interception_enabled() noexcept;
+void install_gl_interception() noexcept;
+void set_gl_call_timing(bool enabled) noexcept;
+void reset_gl_call_counts() noexcept;
+std::vector<gl_call_count> gl_call_counts();
+unsigned int gl_calls(const char* name) noexcept;
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MYOPENGL_GL_LOADER_H
+#define MYOPENGL_GL_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "myopengl/extensions.h"
+
+namespace myopengl {
+
+enum class gl_loading {
+  eager,
+  lazy
+};
+
+bool load_gl(proc_loader_t loader, gl_loading mode = gl_loading::eager);
+bool load_gl_subset(proc_loader_t loader, const std::vector<std::string>& names);
+size_t gl_functions_resolved() noexcept;
+
+}
+
+#endif
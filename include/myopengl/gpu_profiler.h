@@ -0,0 +1,85 @@
+#ifndef MYOPENGL_GPU_PROFILER_H
+#define MYOPENGL_GPU_PROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace myopengl {
+
+struct gpu_profile_node {
+  std::string name;
+  int parent = -1;
+  int depth = 0;
+  double cpu_ms = 0.0;
+  double gpu_ms = 0.0;
+  double total_cpu_ms = 0.0;
+  double total_gpu_ms = 0.0;
+  unsigned int frames = 0;
+};
+
+class gpu_profiler {
+
+  public:
+  gpu_profiler(int frame_latency = 3);
+  ~gpu_profiler();
+
+  gpu_profiler(const gpu_profiler&) = delete;
+  gpu_profiler& operator=(const gpu_profiler&) = delete;
+
+  void begin_frame();
+  void end_frame();
+  void begin_scope(const char* name);
+  void end_scope();
+  void finish();
+
+  const std::vector<gpu_profile_node>& nodes() const noexcept;
+  bool gpu_bound() const noexcept;
+  void write_report(std::ostream& stream) const;
+
+  static gpu_profiler* current() noexcept;
+
+  private:
+  struct event {
+    int node;
+    size_t begin_query;
+    size_t end_query;
+    std::chrono::steady_clock::time_point cpu_begin;
+    std::chrono::steady_clock::time_point cpu_end;
+  };
+
+  struct frame {
+    std::vector<unsigned int> queries;
+    std::vector<event> events;
+    size_t used_queries = 0;
+    bool pending = false;
+  };
+
+  int find_node(int parent, const char* name);
+  size_t issue_timestamp(frame& f);
+  bool resolve(frame& f, bool wait);
+
+  std::vector<gpu_profile_node> _nodes;
+  std::vector<frame> _frames;
+  std::vector<size_t> _open;
+  size_t _frame;
+  gpu_profiler* _previous;
+};
+
+class gpu_scope {
+
+  public:
+  gpu_scope(const char* name);
+  ~gpu_scope();
+
+  gpu_scope(const gpu_scope&) = delete;
+  gpu_scope& operator=(const gpu_scope&) = delete;
+
+  private:
+  gpu_profiler* _profiler;
+};
+
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef MYOPENGL_IMAGE_H
+#define MYOPENGL_IMAGE_H
+
+#include <vector>
+
+namespace myopengl {
+
+enum class colour_space {
+  linear,
+  srgb
+};
+
+struct image {
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  std::vector<unsigned char> pixels;
+};
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef MYOPENGL_IMAGE_ARENA_H
+#define MYOPENGL_IMAGE_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace myopengl {
+
+struct image_allocation_stats {
+  size_t allocations = 0;
+  size_t reallocations = 0;
+  size_t frees = 0;
+  size_t bytes = 0;
+  size_t arena_allocations = 0;
+};
+
+class image_arena {
+
+  public:
+  class scope {
+
+    public:
+    scope(image_arena& arena) noexcept;
+    ~scope();
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+    private:
+    image_arena& _arena;
+    image_arena* _previous;
+  };
+
+  image_arena(size_t block_size = 16 * 1024 * 1024);
+
+  image_arena(const image_arena&) = delete;
+  image_arena& operator=(const image_arena&) = delete;
+
+  void* allocate(size_t size);
+  void* reallocate(void* p, size_t old_size, size_t new_size);
+  bool owns(const void* p) const noexcept;
+  void reset() noexcept;
+
+  size_t used() const noexcept;
+  size_t peak() const noexcept;
+  size_t capacity() const noexcept;
+
+  static image_arena& thread_arena();
+  static image_arena* current() noexcept;
+
+  private:
+  struct block {
+    std::unique_ptr<unsigned char[]> data;
+    size_t size;
+  };
+
+  size_t _block_size;
+  std::vector<block> _blocks;
+  size_t _block;
+  size_t _offset;
+  size_t _used;
+  size_t _peak;
+  void* _last;
+};
+
+const image_allocation_stats& thread_image_allocation_stats() noexcept;
+void reset_thread_image_allocation_stats() noexcept;
+
+void* image_arena_malloc(size_t size);
+void* image_arena_realloc(void* p, size_t old_size, size_t new_size);
+void image_arena_free(void* p);
+
+}
+
+#endif
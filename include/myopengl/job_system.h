@@ -0,0 +1,85 @@
+#ifndef MYOPENGL_JOB_SYSTEM_H
+#define MYOPENGL_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace myopengl {
+
+typedef std::function<void()> job_function_t;
+typedef std::function<void(size_t, size_t)> job_range_function_t;
+
+struct job;
+class job_deque;
+
+class job_counter {
+
+  public:
+  job_counter() noexcept;
+
+  job_counter(const job_counter&) = delete;
+  job_counter& operator=(const job_counter&) = delete;
+
+  bool done() const noexcept;
+
+  private:
+  friend class job_system;
+
+  std::atomic<int> _pending;
+  std::atomic<bool> _failed;
+  std::exception_ptr _error;
+  std::mutex _mutex;
+  std::vector<job*> _continuations;
+};
+
+class job_system {
+
+  public:
+  job_system(unsigned int threads = 0, size_t deque_capacity = 4096);
+  ~job_system();
+
+  job_system(const job_system&) = delete;
+  job_system& operator=(const job_system&) = delete;
+
+  void run(job_function_t function, job_counter* counter = NULL, job_counter* dependency = NULL);
+  void wait(job_counter& counter);
+  void parallel_for(size_t count, size_t grain, const job_range_function_t& function);
+
+  unsigned int threads() const noexcept;
+
+  private:
+  struct free_list {
+    alignas(64) std::vector<job*> jobs;
+  };
+
+  void work(unsigned int index);
+  job* find_job(unsigned int index);
+  job* allocate(job_function_t function, job_counter* counter);
+  void release(job* j);
+  void push(job* j);
+  void execute(job* j);
+  unsigned int thread_index() const noexcept;
+
+  std::vector<std::unique_ptr<job_deque>> _deques;
+  std::vector<free_list> _free;
+  std::vector<job*> _shared_free;
+  std::vector<std::unique_ptr<job[]>> _blocks;
+  std::mutex _pool_mutex;
+  std::vector<std::thread> _workers;
+  std::atomic<int> _queued;
+  std::atomic<int> _sleeping;
+  std::atomic<bool> _stopping;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+};
+
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef MYOPENGL_MAPPED_FILE_H
+#define MYOPENGL_MAPPED_FILE_H
+
+#include <cstddef>
+
+namespace myopengl {
+
+class mapped_file {
+
+  public:
+  mapped_file(const char* path);
+  ~mapped_file();
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  const unsigned char* data() const noexcept;
+  size_t size() const noexcept;
+
+  private:
+  const unsigned char* _data;
+  size_t _size;
+
+#ifdef _WIN32
+  void* _file;
+  void* _mapping;
+#endif
+};
+
+}
+
+#endif
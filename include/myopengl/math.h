@@ -0,0 +1,380 @@
+#ifndef MYOPENGL_MATH_H
+#define MYOPENGL_MATH_H
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYOPENGL_MATH_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#define MYOPENGL_MATH_CONSTEXPR constexpr
+#define MYOPENGL_MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#elif defined(__clang__) && defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define MYOPENGL_MATH_CONSTEXPR constexpr
+#define MYOPENGL_MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define MYOPENGL_MATH_CONSTEXPR constexpr
+#define MYOPENGL_MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#ifndef MYOPENGL_MATH_CONSTEXPR
+#define MYOPENGL_MATH_CONSTEXPR inline
+#define MYOPENGL_MATH_CONSTANT_EVALUATED() false
+#endif
+
+namespace myopengl {
+
+namespace math {
+
+struct vec3 {
+  float x;
+  float y;
+  float z;
+
+  constexpr vec3()
+      : x(0.0f)
+      , y(0.0f)
+      , z(0.0f) {
+  }
+
+  constexpr vec3(float x, float y, float z)
+      : x(x)
+      , y(y)
+      , z(z) {
+  }
+};
+
+struct alignas(16) vec4 {
+  float x;
+  float y;
+  float z;
+  float w;
+
+  constexpr vec4()
+      : x(0.0f)
+      , y(0.0f)
+      , z(0.0f)
+      , w(0.0f) {
+  }
+
+  constexpr vec4(float x, float y, float z, float w)
+      : x(x)
+      , y(y)
+      , z(z)
+      , w(w) {
+  }
+
+  constexpr vec4(const vec3& v, float w)
+      : x(v.x)
+      , y(v.y)
+      , z(v.z)
+      , w(w) {
+  }
+};
+
+struct alignas(16) quat {
+  float x;
+  float y;
+  float z;
+  float w;
+
+  constexpr quat()
+      : x(0.0f)
+      , y(0.0f)
+      , z(0.0f)
+      , w(1.0f) {
+  }
+
+  constexpr quat(float x, float y, float z, float w)
+      : x(x)
+      , y(y)
+      , z(z)
+      , w(w) {
+  }
+};
+
+struct alignas(16) mat4 {
+  vec4 columns[4];
+
+  constexpr mat4()
+      : columns { vec4(), vec4(), vec4(), vec4() } {
+  }
+
+  constexpr mat4(const vec4& c0, const vec4& c1, const vec4& c2, const vec4& c3)
+      : columns { c0, c1, c2, c3 } {
+  }
+
+  constexpr const vec4& operator[](int column) const {
+    return columns[column];
+  }
+
+  constexpr vec4& operator[](int column) {
+    return columns[column];
+  }
+
+  const float* data() const noexcept {
+    return &columns[0].x;
+  }
+};
+
+constexpr vec3 operator+(const vec3& a, const vec3& b) {
+  return vec3(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+constexpr vec3 operator-(const vec3& a, const vec3& b) {
+  return vec3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+constexpr vec3 operator-(const vec3& a) {
+  return vec3(-a.x, -a.y, -a.z);
+}
+
+constexpr vec3 operator*(const vec3& a, const vec3& b) {
+  return vec3(a.x * b.x, a.y * b.y, a.z * b.z);
+}
+
+constexpr vec3 operator*(const vec3& a, float s) {
+  return vec3(a.x * s, a.y * s, a.z * s);
+}
+
+constexpr vec3 operator*(float s, const vec3& a) {
+  return a * s;
+}
+
+constexpr float dot(const vec3& a, const vec3& b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+constexpr vec3 cross(const vec3& a, const vec3& b) {
+  return vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+constexpr vec3 min(const vec3& a, const vec3& b) {
+  return vec3(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z);
+}
+
+constexpr vec3 max(const vec3& a, const vec3& b) {
+  return vec3(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z);
+}
+
+float length(const vec3& v) noexcept;
+vec3 normalize(const vec3& v) noexcept;
+
+#ifdef MYOPENGL_MATH_SSE
+
+inline __m128 load(const vec4& v) {
+  return _mm_load_ps(&v.x);
+}
+
+inline vec4 store(__m128 m) {
+  vec4 result;
+  _mm_store_ps(&result.x, m);
+
+  return result;
+}
+
+inline __m128 splat(__m128 m, int lane) {
+  switch (lane) {
+    case 0:
+      return _mm_shuffle_ps(m, m, _MM_SHUFFLE(0, 0, 0, 0));
+    case 1:
+      return _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+    case 2:
+      return _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+    default:
+      return _mm_shuffle_ps(m, m, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+}
+
+inline __m128 horizontal_sum(__m128 m) {
+  __m128 s = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+#endif
+
+MYOPENGL_MATH_CONSTEXPR vec4 operator+(const vec4& a, const vec4& b) {
+#ifdef MYOPENGL_MATH_SSE
+  if (!MYOPENGL_MATH_CONSTANT_EVALUATED()) {
+    return store(_mm_add_ps(load(a), load(b)));
+  }
+#endif
+
+  return vec4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+}
+
+MYOPENGL_MATH_CONSTEXPR vec4 operator-(const vec4& a, const vec4& b) {
+#ifdef MYOPENGL_MATH_SSE
+  if (!MYOPENGL_MATH_CONSTANT_EVALUATED()) {
+    return store(_mm_sub_ps(load(a), load(b)));
+  }
+#endif
+
+  return vec4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+}
+
+MYOPENGL_MATH_CONSTEXPR vec4 operator*(const vec4& a, const vec4& b) {
+#ifdef MYOPENGL_MATH_SSE
+  if (!MYOPENGL_MATH_CONSTANT_EVALUATED()) {
+    return store(_mm_mul_ps(load(a), load(b)));
+  }
+#endif
+
+  return vec4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w);
+}
+
+MYOPENGL_MATH_CONSTEXPR vec4 operator*(const vec4& a, float s) {
+#ifdef MYOPENGL_MATH_SSE
+  if (!MYOPENGL_MATH_CONSTANT_EVALUATED()) {
+    return store(_mm_mul_ps(load(a), _mm_set1_ps(s)));
+  }
+#endif
+
+  return vec4(a.x * s, a.y * s, a.z * s, a.w * s);
+}
+
+MYOPENGL_MATH_CONSTEXPR vec4 operator*(float s, const vec4& a) {
+  return a * s;
+}
+
+MYOPENGL_MATH_CONSTEXPR float dot(const vec4& a, const vec4& b) {
+#ifdef MYOPENGL_MATH_SSE
+  if (!MYOPENGL_MATH_CONSTANT_EVALUATED()) {
+    return _mm_cvtss_f32(horizontal_sum(_mm_mul_ps(load(a), load(b))));
+  }
+#endif
+
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+float length(const vec4& v) noexcept;
+vec4 normalize(const vec4& v) noexcept;
+
+MYOPENGL_MATH_CONSTEXPR vec4 operator*(const mat4& m, const vec4& v) {
+#ifdef MYOPENGL_MATH_SSE
+  if (!MYOPENGL_MATH_CONSTANT_EVALUATED()) {
+    __m128 c = load(v);
+    __m128 r = _mm_mul_ps(load(m.columns[0]), splat(c, 0));
+    r = _mm_add_ps(r, _mm_mul_ps(load(m.columns[1]), splat(c, 1)));
+    r = _mm_add_ps(r, _mm_mul_ps(load(m.columns[2]), splat(c, 2)));
+    r = _mm_add_ps(r, _mm_mul_ps(load(m.columns[3]), splat(c, 3)));
+
+    return store(r);
+  }
+#endif
+
+  return vec4(m[0].x * v.x + m[1].x * v.y + m[2].x * v.z + m[3].x * v.w,
+      m[0].y * v.x + m[1].y * v.y + m[2].y * v.z + m[3].y * v.w,
+      m[0].z * v.x + m[1].z * v.y + m[2].z * v.z + m[3].z * v.w,
+      m[0].w * v.x + m[1].w * v.y + m[2].w * v.z + m[3].w * v.w);
+}
+
+MYOPENGL_MATH_CONSTEXPR mat4 operator*(const mat4& a, const mat4& b) {
+  return mat4(a * b[0], a * b[1], a * b[2], a * b[3]);
+}
+
+constexpr mat4 identity() {
+  return mat4(vec4(1.0f, 0.0f, 0.0f, 0.0f), vec4(0.0f, 1.0f, 0.0f, 0.0f), vec4(0.0f, 0.0f, 1.0f, 0.0f),
+      vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+constexpr mat4 translation(const vec3& t) {
+  return mat4(vec4(1.0f, 0.0f, 0.0f, 0.0f), vec4(0.0f, 1.0f, 0.0f, 0.0f), vec4(0.0f, 0.0f, 1.0f, 0.0f),
+      vec4(t, 1.0f));
+}
+
+constexpr mat4 scaling(const vec3& s) {
+  return mat4(vec4(s.x, 0.0f, 0.0f, 0.0f), vec4(0.0f, s.y, 0.0f, 0.0f), vec4(0.0f, 0.0f, s.z, 0.0f),
+      vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+constexpr mat4 transpose(const mat4& m) {
+  return mat4(vec4(m[0].x, m[1].x, m[2].x, m[3].x), vec4(m[0].y, m[1].y, m[2].y, m[3].y),
+      vec4(m[0].z, m[1].z, m[2].z, m[3].z), vec4(m[0].w, m[1].w, m[2].w, m[3].w));
+}
+
+constexpr mat4 orthographic(float left, float right, float bottom, float top, float z_near, float z_far) {
+  return mat4(vec4(2.0f / (right - left), 0.0f, 0.0f, 0.0f), vec4(0.0f, 2.0f / (top - bottom), 0.0f, 0.0f),
+      vec4(0.0f, 0.0f, -2.0f / (z_far - z_near), 0.0f),
+      vec4(-(right + left) / (right - left), -(top + bottom) / (top - bottom),
+          -(z_far + z_near) / (z_far - z_near), 1.0f));
+}
+
+constexpr vec3 transform_point(const mat4& m, const vec3& p) {
+  return vec3(m[0].x * p.x + m[1].x * p.y + m[2].x * p.z + m[3].x,
+      m[0].y * p.x + m[1].y * p.y + m[2].y * p.z + m[3].y,
+      m[0].z * p.x + m[1].z * p.y + m[2].z * p.z + m[3].z);
+}
+
+mat4 inverse(const mat4& m) noexcept;
+mat4 perspective(float fovy, float aspect, float z_near, float z_far) noexcept;
+mat4 look_at(const vec3& eye, const vec3& target, const vec3& up) noexcept;
+
+MYOPENGL_MATH_CONSTEXPR quat operator*(const quat& a, const quat& b) {
+#ifdef MYOPENGL_MATH_SSE
+  if (!MYOPENGL_MATH_CONSTANT_EVALUATED()) {
+    __m128 qa = _mm_load_ps(&a.x);
+    __m128 qb = _mm_load_ps(&b.x);
+
+    __m128 r = _mm_mul_ps(splat(qa, 3), qb);
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(splat(qa, 0), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 1, 2, 3))),
+        _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(splat(qa, 1), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 0, 3, 2))),
+        _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(splat(qa, 2), _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 3, 0, 1))),
+        _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f)));
+
+    quat result;
+    _mm_store_ps(&result.x, r);
+
+    return result;
+  }
+#endif
+
+  return quat(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+      a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+constexpr quat conjugate(const quat& q) {
+  return quat(-q.x, -q.y, -q.z, q.w);
+}
+
+constexpr vec3 rotate(const quat& q, const vec3& v) {
+  const vec3 u(q.x, q.y, q.z);
+  const vec3 t = cross(u, v) * 2.0f;
+
+  return v + t * q.w + cross(u, t);
+}
+
+constexpr mat4 rotation(const quat& q) {
+  return mat4(
+      vec4(1.0f - 2.0f * (q.y * q.y + q.z * q.z), 2.0f * (q.x * q.y + q.z * q.w), 2.0f * (q.x * q.z - q.y * q.w), 0.0f),
+      vec4(2.0f * (q.x * q.y - q.z * q.w), 1.0f - 2.0f * (q.x * q.x + q.z * q.z), 2.0f * (q.y * q.z + q.x * q.w), 0.0f),
+      vec4(2.0f * (q.x * q.z + q.y * q.w), 2.0f * (q.y * q.z - q.x * q.w), 1.0f - 2.0f * (q.x * q.x + q.y * q.y), 0.0f),
+      vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+quat axis_angle(const vec3& axis, float radians) noexcept;
+quat normalize(const quat& q) noexcept;
+quat slerp(const quat& a, const quat& b, float t) noexcept;
+mat4 compose(const vec3& position, const quat& q, const vec3& scale) noexcept;
+
+void transform_points(const mat4& m, const float* x, const float* y, const float* z, float* out_x, float* out_y,
+    float* out_z, size_t count) noexcept;
+void compose_transforms(const vec3* positions, const quat* rotations, const vec3* scales, mat4* result,
+    size_t count) noexcept;
+void multiply_matrices(const mat4* a, const mat4* b, mat4* result, size_t count) noexcept;
+void multiply_matrices(const mat4& a, const mat4* b, mat4* result, size_t count) noexcept;
+
+}
+
+}
+
+#endif
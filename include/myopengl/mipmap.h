@@ -0,0 +1,28 @@
+#ifndef MYOPENGL_MIPMAP_H
+#define MYOPENGL_MIPMAP_H
+
+#include <vector>
+
+#include "myopengl/image.h"
+
+namespace myopengl {
+
+enum class mip_filter {
+  box,
+  kaiser
+};
+
+struct mip_options {
+  mip_filter filter = mip_filter::box;
+  colour_space space = colour_space::srgb;
+  bool alpha_weighted = true;
+  bool use_simd = true;
+  int max_levels = 0;
+};
+
+int mip_level_count(int width, int height) noexcept;
+std::vector<image> generate_mip_chain(const image& base, const mip_options& options = mip_options());
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MYOPENGL_PIXEL_PIPELINE_H
+#define MYOPENGL_PIXEL_PIPELINE_H
+
+#include "myopengl/image.h"
+
+namespace myopengl {
+
+struct pixel_operations {
+  bool flip_vertically = false;
+  bool expand_to_rgba = false;
+  bool swizzle_bgr = false;
+  bool premultiply_alpha = false;
+  bool use_simd = true;
+};
+
+int processed_channels(int channels, const pixel_operations& operations) noexcept;
+void process_pixels(const unsigned char* source, int width, int height, int channels,
+    const pixel_operations& operations, image& destination);
+image process_pixels(const image& source, const pixel_operations& operations);
+
+}
+
+#endif
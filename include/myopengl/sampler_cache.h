@@ -0,0 +1,49 @@
+#ifndef MYOPENGL_SAMPLER_CACHE_H
+#define MYOPENGL_SAMPLER_CACHE_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace myopengl {
+
+struct sampler_descriptor {
+  unsigned int wrap_s;
+  unsigned int wrap_t;
+  unsigned int min_filter;
+  unsigned int mag_filter;
+  float max_anisotropy = 1.0f;
+
+  bool operator==(const sampler_descriptor& other) const noexcept;
+};
+
+struct sampler_descriptor_hash {
+  size_t operator()(const sampler_descriptor& descriptor) const noexcept;
+};
+
+class sampler_cache {
+
+  public:
+  sampler_cache();
+  ~sampler_cache();
+
+  sampler_cache(const sampler_cache&) = delete;
+  sampler_cache& operator=(const sampler_cache&) = delete;
+
+  unsigned int get(const sampler_descriptor& descriptor);
+  void bind(unsigned int unit, const sampler_descriptor& descriptor);
+  void unbind(unsigned int unit) noexcept;
+  void invalidate() noexcept;
+
+  size_t size() const noexcept;
+  float max_anisotropy() const noexcept;
+
+  private:
+  std::unordered_map<sampler_descriptor, unsigned int, sampler_descriptor_hash> _samplers;
+  std::vector<unsigned int> _bound;
+  float _max_anisotropy;
+};
+
+}
+
+#endif
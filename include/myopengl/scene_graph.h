@@ -0,0 +1,66 @@
+#ifndef MYOPENGL_SCENE_GRAPH_H
+#define MYOPENGL_SCENE_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "myopengl/job_system.h"
+#include "myopengl/math.h"
+
+namespace myopengl {
+
+typedef uint32_t scene_node_t;
+
+const scene_node_t no_scene_node = 0xFFFFFFFFu;
+
+class scene_graph {
+
+  public:
+  scene_graph();
+
+  scene_node_t add(scene_node_t parent = no_scene_node);
+  void remove(scene_node_t node);
+
+  void set_position(scene_node_t node, const math::vec3& position);
+  void set_rotation(scene_node_t node, const math::quat& rotation);
+  void set_scale(scene_node_t node, const math::vec3& scale);
+
+  const math::vec3& position(scene_node_t node) const noexcept;
+  const math::quat& rotation(scene_node_t node) const noexcept;
+  const math::vec3& scale(scene_node_t node) const noexcept;
+  const math::mat4& world(scene_node_t node) const noexcept;
+  scene_node_t parent(scene_node_t node) const noexcept;
+  bool contains(scene_node_t node) const noexcept;
+
+  size_t update(job_system* jobs = NULL, size_t grain = 4096);
+
+  const std::vector<math::mat4>& worlds() const noexcept;
+  const std::vector<scene_node_t>& nodes() const noexcept;
+  size_t size() const noexcept;
+  size_t levels() const noexcept;
+
+  private:
+  void mark_dirty(scene_node_t node);
+  void sort();
+  void rebuild_levels();
+  size_t update_range(size_t first, size_t last) noexcept;
+
+  std::vector<uint32_t> _parents;
+  std::vector<uint32_t> _depths;
+  std::vector<math::vec3> _positions;
+  std::vector<math::quat> _rotations;
+  std::vector<math::vec3> _scales;
+  std::vector<math::mat4> _worlds;
+  std::vector<uint8_t> _dirty;
+  std::vector<scene_node_t> _nodes;
+  std::vector<uint32_t> _indices;
+  std::vector<scene_node_t> _free;
+  std::vector<size_t> _levels;
+  bool _changed;
+  bool _any_dirty;
+};
+
+}
+
+#endif
@@ -13,6 +13,10 @@ class shader {
 
   void set_int(const std::string& name, int value) const noexcept;
   void set_float(const std::string& name, float value) const noexcept;
+  void set_vec2(const std::string& name, float x, float y) const noexcept;
+
+  int uniform_location(const std::string& name) const noexcept;
+  unsigned int id() const noexcept;
 
   void use();
 
@@ -0,0 +1,50 @@
+#ifndef MYOPENGL_TEXTURE_H
+#define MYOPENGL_TEXTURE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "myopengl/image.h"
+#include "myopengl/pixel_pipeline.h"
+#include "myopengl/texture_format.h"
+
+namespace myopengl {
+
+image load_image(const char* path, const pixel_operations& operations = pixel_operations(), int desired_channels = 0);
+image load_image_from_memory(const unsigned char* data, size_t size,
+    const pixel_operations& operations = pixel_operations(), int desired_channels = 0);
+unsigned int create_texture(const std::vector<image>& mips, colour_space space);
+void allocate_texture_storage(unsigned int target, int levels, const texture_format& format, int width, int height,
+    int layers);
+void bind_texture(unsigned int unit, unsigned int target, unsigned int texture) noexcept;
+
+class texture_array {
+
+  public:
+  texture_array(int width, int height, int channels, int layers, colour_space space = colour_space::srgb);
+  ~texture_array();
+
+  texture_array(const texture_array&) = delete;
+  texture_array& operator=(const texture_array&) = delete;
+
+  int add_layer(const image& source);
+  void bind(unsigned int unit) const noexcept;
+
+  unsigned int id() const noexcept;
+  int layers() const noexcept;
+  int capacity() const noexcept;
+
+  private:
+  unsigned int _id;
+  int _width;
+  int _height;
+  int _channels;
+  colour_space _space;
+  int _levels;
+  int _layers;
+  int _capacity;
+};
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MYOPENGL_TEXTURE_EXCEPTION_H
+#define MYOPENGL_TEXTURE_EXCEPTION_H
+
+#include <exception>
+#include <string>
+
+namespace myopengl {
+
+class texture_exception : public std::exception {
+
+  public:
+  texture_exception() = delete;
+  texture_exception(const std::string& message) noexcept;
+
+  const char* what() const noexcept override;
+
+  private:
+  std::string _message;
+};
+
+}
+
+#endif
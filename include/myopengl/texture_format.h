@@ -0,0 +1,18 @@
+#ifndef MYOPENGL_TEXTURE_FORMAT_H
+#define MYOPENGL_TEXTURE_FORMAT_H
+
+#include "myopengl/image.h"
+
+namespace myopengl {
+
+struct texture_format {
+  unsigned int internal_format;
+  unsigned int format;
+  unsigned int type;
+};
+
+texture_format select_texture_format(int channels, colour_space space) noexcept;
+
+}
+
+#endif
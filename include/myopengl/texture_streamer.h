@@ -0,0 +1,77 @@
+#ifndef MYOPENGL_TEXTURE_STREAMER_H
+#define MYOPENGL_TEXTURE_STREAMER_H
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "myopengl/image.h"
+#include "myopengl/job_system.h"
+#include "myopengl/pixel_pipeline.h"
+#include "myopengl/texture_format.h"
+
+namespace myopengl {
+
+typedef std::function<std::vector<image>()> mip_chain_loader_t;
+
+class texture_streamer {
+
+  public:
+  texture_streamer(size_t frame_budget, int thumbnail_size = 32, job_system* jobs = NULL);
+  ~texture_streamer();
+
+  texture_streamer(const texture_streamer&) = delete;
+  texture_streamer& operator=(const texture_streamer&) = delete;
+
+  unsigned int add(std::vector<image> mips, colour_space space);
+  unsigned int add(int width, int height, int channels, colour_space space, mip_chain_loader_t loader);
+  unsigned int add(const char* path, colour_space space, const pixel_operations& operations = pixel_operations(),
+      int desired_channels = 0);
+  void remove(unsigned int texture) noexcept;
+  size_t update();
+
+  void set_frame_budget(size_t frame_budget) noexcept;
+  bool idle() const noexcept;
+  bool loading(unsigned int texture) const noexcept;
+  size_t pending_bytes() const noexcept;
+  int base_level(unsigned int texture) const noexcept;
+
+  private:
+  struct stream {
+    unsigned int texture;
+    texture_format format;
+    std::vector<image> mips;
+    int width;
+    int height;
+    int channels;
+    int levels;
+    int base_level;
+    size_t load;
+    bool loading;
+  };
+
+  struct loaded_chain {
+    size_t load;
+    std::vector<image> mips;
+    std::exception_ptr error;
+  };
+
+  size_t _frame_budget;
+  int _thumbnail_size;
+  job_system* _jobs;
+  std::vector<stream> _streams;
+  size_t _next_load;
+  job_counter _loads;
+  std::mutex _mutex;
+  std::vector<loaded_chain> _loaded;
+
+  size_t receive_loaded();
+  size_t upload_thumbnail(stream& s);
+  void upload_next_level(stream& s);
+};
+
+}
+
+#endif
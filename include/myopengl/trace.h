@@ -0,0 +1,54 @@
+#ifndef MYOPENGL_TRACE_H
+#define MYOPENGL_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace myopengl {
+
+struct trace_event {
+  const char* name;
+  int64_t begin_ns;
+  int64_t end_ns;
+};
+
+class trace_scope {
+
+  public:
+  trace_scope(const char* name) noexcept;
+  ~trace_scope();
+
+  trace_scope(const trace_scope&) = delete;
+  trace_scope& operator=(const trace_scope&) = delete;
+
+  private:
+  const char* _name;
+  int64_t _begin_ns;
+};
+
+int64_t trace_clock() noexcept;
+void record_trace_event(const char* name, int64_t begin_ns, int64_t end_ns) noexcept;
+
+void set_trace_enabled(bool enabled) noexcept;
+bool trace_enabled() noexcept;
+void set_trace_buffer_capacity(size_t events) noexcept;
+void set_trace_thread_name(const std::string& name);
+void clear_trace() noexcept;
+
+void write_chrome_trace(std::ostream& stream);
+void write_chrome_trace(const std::string& path);
+
+}
+
+#define MYOPENGL_TRACE_CONCAT_INNER(a, b) a##b
+#define MYOPENGL_TRACE_CONCAT(a, b) MYOPENGL_TRACE_CONCAT_INNER(a, b)
+
+#ifdef MYOPENGL_TRACE
+#define MYOPENGL_TRACE_SCOPE(name) myopengl::trace_scope MYOPENGL_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define MYOPENGL_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform float Scale;
+uniform vec2 Offset;
+
+void main()
+{
+    gl_Position = vec4(aPos.xy * Scale + Offset, aPos.z, 1.0);
+}
@@ -0,0 +1,14 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+
+uniform float Scale;
+uniform vec2 Offset;
+
+out vec2 TexCoord;
+
+void main()
+{
+    gl_Position = vec4(aPos.xy * Scale + Offset, aPos.z, 1.0);
+    TexCoord = aTexCoord;
+}
@@ -0,0 +1,11 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+flat in float Layer;
+
+uniform sampler2DArray Textures;
+
+void main() {
+    FragColor = texture(Textures, vec3(TexCoord, Layer));
+}
@@ -0,0 +1,17 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec2 aOffset;
+layout (location = 3) in float aLayer;
+
+uniform float Scale;
+
+out vec2 TexCoord;
+flat out float Layer;
+
+void main()
+{
+    gl_Position = vec4(aPos.xy * Scale + aOffset, aPos.z, 1.0);
+    TexCoord = aTexCoord;
+    Layer = aLayer;
+}
@@ -5,9 +5,14 @@ in vec3 Colour;
 in vec2 TexCoord;
 
 uniform float Mix;
-uniform sampler2D Texture1;
-uniform sampler2D Texture2;
+uniform sampler2D Atlas;
+uniform vec2 Offset1;
+uniform vec2 Scale1;
+uniform vec2 Offset2;
+uniform vec2 Scale2;
 
 void main() {
-    FragColor = mix(texture(Texture1, TexCoord), texture(Texture2, vec2(-TexCoord.x, TexCoord.y)), Mix);
+    vec4 first = texture(Atlas, Offset1 + TexCoord * Scale1);
+    vec4 second = texture(Atlas, Offset2 + vec2(1.0 - TexCoord.x, TexCoord.y) * Scale2);
+    FragColor = mix(first, second, Mix);
 } 
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <cstdlib>
+#include <cstring>
+
+#include "myopengl/app_options.h"
+
+namespace myopengl {
+
+// Builds the options of the examples and benchmarks from the command line.  Recognises --stats PATH, the file frame
+// statistics are written to, --profile, to report the time spent in each pass, --trace PATH, the file a CPU trace is
+// written to in builds with MYOPENGL_TRACE, and --gl-timing, to time every OpenGL call in builds with
+// MYOPENGL_GL_INTERCEPT.  Frame pacing is controlled with --fps N, a frame rate to limit to, and --pacing PATH, the
+// file pacing statistics are written to.  --gpu-budget MS sets a GPU frame time for dynamic resolution to keep within.
+// Options for the context are left to parse_context_options.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+//
+// Returns the options parsed
+app_options parse_app_options(int argc, char* argv[]) {
+  app_options options;
+
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+
+    if (std::strcmp(argv[i], "--gl-timing") == 0) {
+      options.gl_timing = true;
+    } else if (std::strcmp(argv[i], "--profile") == 0) {
+      options.profile = true;
+    } else if (std::strcmp(argv[i], "--stats") == 0 && has_value) {
+      options.stats_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--trace") == 0 && has_value) {
+      options.trace_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--fps") == 0 && has_value) {
+      options.target_fps = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--pacing") == 0 && has_value) {
+      options.pacing_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--gpu-budget") == 0 && has_value) {
+      options.gpu_budget_ms = std::atof(argv[++i]);
+    }
+  }
+
+  return options;
+}
+
+}
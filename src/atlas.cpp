@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+#include <string>
+
+#include "myopengl/atlas.h"
+#include "myopengl/texture_exception.h"
+
+namespace myopengl {
+
+namespace {
+
+// Rounds a value up to the next multiple of alignment.
+int round_up(int value, int alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+}
+
+// Construct an atlas builder.
+//
+// Parameters
+// options - page size, padding and the number of mip levels the atlas must remain safe for
+atlas_builder::atlas_builder(const atlas_options& options)
+    : _options(options)
+    , _built(false) {
+  assert(options.page_size > 0);
+  assert(options.padding >= 0);
+  assert(options.mip_levels >= 1);
+}
+
+// Adds an image to be packed.  All images in an atlas must share a channel count.
+//
+// Parameters
+// source - the image to be packed
+//
+// Throws
+// texture_exception - if the atlas has already been built or the channel count does not match earlier images
+//
+// Returns the index used to look up the packed region of the image
+size_t atlas_builder::add(image source) {
+  if (_built) {
+    throw texture_exception("Cannot add images to an atlas which has already been built");
+  }
+
+  if (!_sources.empty() && _sources.front().channels != source.channels) {
+    throw texture_exception("Atlas images must share a channel count, expected [" + std::to_string(_sources.front().channels)
+        + "] but got [" + std::to_string(source.channels) + "]");
+  }
+
+  _sources.push_back(std::move(source));
+
+  return _sources.size() - 1;
+}
+
+// Packs every added image into as few pages as possible using a bottom left skyline packer.  Each image is
+// surrounded by a gutter of extruded edge texels and placed on a boundary aligned to the lowest mip level, so
+// filtering at any level of the chain never samples a neighbouring image.
+//
+// Throws
+// texture_exception - if an image, including its gutter, is larger than a page
+void atlas_builder::build() {
+  assert(!_built);
+
+  const int alignment = 1 << (_options.mip_levels - 1);
+  const int padding = round_up(_options.padding, alignment);
+
+  std::vector<size_t> order(_sources.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    if (_sources[a].height != _sources[b].height) {
+      return _sources[a].height > _sources[b].height;
+    }
+
+    return _sources[a].width > _sources[b].width;
+  });
+
+  _regions.assign(_sources.size(), atlas_region());
+
+  for (size_t index : order) {
+    const image& source = _sources[index];
+    const int width = round_up(source.width + 2 * padding, alignment);
+    const int height = round_up(source.height + 2 * padding, alignment);
+
+    if (width > _options.page_size || height > _options.page_size) {
+      throw texture_exception("Image of [" + std::to_string(source.width) + "x" + std::to_string(source.height)
+          + "] does not fit an atlas page of [" + std::to_string(_options.page_size) + "]");
+    }
+
+    int x = 0;
+    int y = 0;
+    size_t node = 0;
+    size_t page = 0;
+
+    while (page < _skylines.size() && !find_position(_skylines[page], width, height, x, y, node)) {
+      ++page;
+    }
+
+    if (page == _skylines.size()) {
+      _skylines.push_back({ { 0, 0, _options.page_size } });
+
+      image blank;
+      blank.width = _options.page_size;
+      blank.height = _options.page_size;
+      blank.channels = source.channels;
+      blank.pixels.assign(static_cast<size_t>(blank.width) * blank.height * blank.channels, 0);
+      _pages.push_back(std::move(blank));
+
+      find_position(_skylines[page], width, height, x, y, node);
+    }
+
+    place(_skylines[page], node, x, y, width, height);
+
+    atlas_region& region = _regions[index];
+    region.page = static_cast<int>(page);
+    region.x = x + padding;
+    region.y = y + padding;
+    region.width = source.width;
+    region.height = source.height;
+    region.uv_offset[0] = static_cast<float>(region.x) / _options.page_size;
+    region.uv_offset[1] = static_cast<float>(region.y) / _options.page_size;
+    region.uv_scale[0] = static_cast<float>(region.width) / _options.page_size;
+    region.uv_scale[1] = static_cast<float>(region.height) / _options.page_size;
+
+    blit(source, region, x, y, width, height);
+  }
+
+  _sources.clear();
+  _sources.shrink_to_fit();
+  _skylines.clear();
+  _built = true;
+}
+
+// Returns the number of images added to the atlas.
+size_t atlas_builder::size() const noexcept {
+  return _regions.empty() ? _sources.size() : _regions.size();
+}
+
+// Returns the packed pages, each ready to be uploaded as a single texture.
+const std::vector<image>& atlas_builder::pages() const noexcept {
+  return _pages;
+}
+
+// Returns the packed rectangle and UV transform of an image.
+//
+// Parameters
+// index - the index returned when the image was added
+//
+// Throws
+// texture_exception - if the atlas has not been built
+const atlas_region& atlas_builder::region(size_t index) const {
+  if (!_built) {
+    throw texture_exception("Atlas regions are not available until the atlas has been built");
+  }
+
+  return _regions.at(index);
+}
+
+// Remaps texture coordinates in an interleaved vertex array from the [0, 1] space of an image into the space of the
+// atlas page which holds it.
+//
+// Parameters
+// index - the index returned when the image was added
+// vertices - interleaved vertex data to be remapped in place
+// count - the number of vertices
+// stride - the number of floats between consecutive vertices
+// offset - the offset in floats of the texture coordinate within a vertex
+//
+// Throws
+// texture_exception - if the atlas has not been built
+void atlas_builder::remap_uvs(size_t index, float* vertices, size_t count, size_t stride, size_t offset) const {
+  assert(vertices != NULL);
+  assert(offset + 2 <= stride);
+
+  const atlas_region& r = region(index);
+
+  for (size_t i = 0; i < count; ++i) {
+    float* uv = vertices + i * stride + offset;
+    uv[0] = r.uv_offset[0] + uv[0] * r.uv_scale[0];
+    uv[1] = r.uv_offset[1] + uv[1] * r.uv_scale[1];
+  }
+}
+
+// Finds the lowest position on a skyline at which a rectangle fits, preferring the narrowest segment on ties.
+//
+// Parameters
+// skyline - the skyline of the page being searched
+// width - width of the rectangle
+// height - height of the rectangle
+// x - set to the horizontal position found
+// y - set to the vertical position found
+// node - set to the index of the skyline segment the rectangle starts on
+//
+// Returns true if a position was found
+bool atlas_builder::find_position(const std::vector<skyline_node>& skyline, int width, int height, int& x, int& y, size_t& node) const {
+  int best_top = _options.page_size + 1;
+  int best_width = 0;
+  bool found = false;
+
+  for (size_t i = 0; i < skyline.size(); ++i) {
+    if (skyline[i].x + width > _options.page_size) {
+      break;
+    }
+
+    int top = 0;
+    int remaining = width;
+    size_t j = i;
+
+    while (remaining > 0 && j < skyline.size()) {
+      top = std::max(top, skyline[j].y);
+      remaining -= skyline[j].width;
+      ++j;
+    }
+
+    if (remaining > 0 || top + height > _options.page_size) {
+      continue;
+    }
+
+    if (top + height < best_top || (top + height == best_top && skyline[i].width < best_width)) {
+      best_top = top + height;
+      best_width = skyline[i].width;
+      x = skyline[i].x;
+      y = top;
+      node = i;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+// Raises the skyline to cover a newly placed rectangle and merges segments of equal height.
+//
+// Parameters
+// skyline - the skyline of the page the rectangle was placed on
+// node - index of the skyline segment the rectangle starts on
+// x - horizontal position of the rectangle
+// y - vertical position of the rectangle
+// width - width of the rectangle
+// height - height of the rectangle
+void atlas_builder::place(std::vector<skyline_node>& skyline, size_t node, int x, int y, int width, int height) {
+  skyline.insert(skyline.begin() + node, skyline_node { x, y + height, width });
+
+  for (size_t i = node + 1; i < skyline.size();) {
+    const skyline_node& previous = skyline[i - 1];
+    skyline_node& current = skyline[i];
+    int overlap = previous.x + previous.width - current.x;
+
+    if (overlap <= 0) {
+      break;
+    }
+
+    current.x += overlap;
+    current.width -= overlap;
+
+    if (current.width > 0) {
+      break;
+    }
+
+    skyline.erase(skyline.begin() + i);
+  }
+
+  for (size_t i = 0; i + 1 < skyline.size();) {
+    if (skyline[i].y == skyline[i + 1].y) {
+      skyline[i].width += skyline[i + 1].width;
+      skyline.erase(skyline.begin() + i + 1);
+    } else {
+      ++i;
+    }
+  }
+}
+
+// Copies an image into its page and fills the rest of its cell, the gutter and the remainder left by aligning the
+// cell to the lowest mip level, by extruding its edge texels.
+//
+// Parameters
+// source - the image being copied
+// region - the region the image was packed into
+// x - horizontal position of the cell
+// y - vertical position of the cell
+// width - width of the cell
+// height - height of the cell
+void atlas_builder::blit(const image& source, const atlas_region& region, int x, int y, int width, int height) {
+  image& page = _pages[region.page];
+  const size_t texel = page.channels;
+  const int right = region.x + region.width;
+
+  for (int py = y; py < y + height; ++py) {
+    int sy = std::min(std::max(py - region.y, 0), source.height - 1);
+    const unsigned char* src_row = &source.pixels[static_cast<size_t>(sy) * source.width * texel];
+    unsigned char* dst_row = &page.pixels[static_cast<size_t>(py) * page.width * texel];
+
+    std::memcpy(dst_row + region.x * texel, src_row, source.width * texel);
+
+    for (int px = x; px < region.x; ++px) {
+      std::memcpy(dst_row + px * texel, src_row, texel);
+    }
+
+    for (int px = right; px < x + width; ++px) {
+      std::memcpy(dst_row + px * texel, src_row + (source.width - 1) * texel, texel);
+    }
+  }
+}
+
+}
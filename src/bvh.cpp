@@ -0,0 +1,515 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "myopengl/bvh.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+namespace {
+
+const int max_depth = 64;
+const int max_bins = 64;
+
+enum class containment {
+  outside,
+  intersecting,
+  inside
+};
+
+struct build_state {
+  const bvh_options& options;
+  job_system* jobs;
+  std::vector<math::vec3> mins;
+  std::vector<math::vec3> maxs;
+  std::vector<math::vec3> centroids;
+  std::vector<uint32_t>& objects;
+};
+
+struct bin {
+  math::vec3 min;
+  math::vec3 max;
+  size_t count;
+};
+
+// Returns half the surface area of a box, proportional to the chance a random ray hits it.
+//
+// Parameters
+// min - the minimum corner of the box
+// max - the maximum corner of the box
+float half_area(const math::vec3& min, const math::vec3& max) {
+  const math::vec3 d = max - min;
+
+  return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+// Returns an empty box which any point grows.
+bin empty_bin() {
+  const float m = std::numeric_limits<float>::max();
+
+  return bin { math::vec3(m, m, m), math::vec3(-m, -m, -m), 0 };
+}
+
+// Classifies a box against a frustum.
+//
+// Parameters
+// f - the frustum
+// min - the minimum corner of the box
+// max - the maximum corner of the box
+//
+// Returns whether the box is outside, inside, or intersecting the frustum
+containment classify(const frustum& f, const math::vec3& min, const math::vec3& max) {
+  const math::vec3 centre = (min + max) * 0.5f;
+  const math::vec3 extent = (max - min) * 0.5f;
+  containment result = containment::inside;
+
+  for (const math::vec4& p : f.planes) {
+    const float d = p.x * centre.x + p.y * centre.y + p.z * centre.z + p.w;
+    const float r = std::fabs(p.x) * extent.x + std::fabs(p.y) * extent.y + std::fabs(p.z) * extent.z;
+
+    if (d + r < 0.0f) {
+      return containment::outside;
+    }
+
+    if (d - r < 0.0f) {
+      result = containment::intersecting;
+    }
+  }
+
+  return result;
+}
+
+// Intersects a ray with a box using the slab method.
+//
+// Parameters
+// origin - the origin of the ray
+// inverse - the reciprocal of each component of the ray's direction
+// min - the minimum corner of the box
+// max - the maximum corner of the box
+// limit - the distance beyond which hits are ignored
+//
+// Returns the distance along the ray at which it enters the box, 0 if it starts inside, or infinity on a miss
+float intersect_box(const math::vec3& origin, const math::vec3& inverse, const math::vec3& min, const math::vec3& max,
+    float limit) {
+  const float x1 = (min.x - origin.x) * inverse.x;
+  const float x2 = (max.x - origin.x) * inverse.x;
+  const float y1 = (min.y - origin.y) * inverse.y;
+  const float y2 = (max.y - origin.y) * inverse.y;
+  const float z1 = (min.z - origin.z) * inverse.z;
+  const float z2 = (max.z - origin.z) * inverse.z;
+
+  const float enter = std::fmax(std::fmax(std::fmin(x1, x2), std::fmin(y1, y2)), std::fmax(std::fmin(z1, z2), 0.0f));
+  const float exit = std::fmin(std::fmin(std::fmax(x1, x2), std::fmax(y1, y2)), std::fmin(std::fmax(z1, z2), limit));
+
+  return enter <= exit ? enter : std::numeric_limits<float>::infinity();
+}
+
+// Finds the best split of a range of objects by the surface area heuristic, binning centroids along each axis.
+//
+// Parameters
+// state - the build state
+// first - the first object in the range
+// last - one past the last object in the range
+// centroid_min - the minimum of the centroids in the range
+// centroid_max - the maximum of the centroids in the range
+// axis - receives the axis to split along
+// split - receives the number of bins which go to the left child
+//
+// Returns false if every centroid is at the same point so no split is possible
+bool find_split(const build_state& state, size_t first, size_t last, const math::vec3& centroid_min,
+    const math::vec3& centroid_max, int& axis, int& split) {
+  const int bins = state.options.bins;
+  const float extents[3] = { centroid_max.x - centroid_min.x, centroid_max.y - centroid_min.y,
+      centroid_max.z - centroid_min.z };
+  const float mins[3] = { centroid_min.x, centroid_min.y, centroid_min.z };
+
+  float best_cost = std::numeric_limits<float>::max();
+  axis = -1;
+
+  bin binned[max_bins];
+  float left_costs[max_bins];
+
+  for (int a = 0; a < 3; ++a) {
+    if (extents[a] <= 0.0f) {
+      continue;
+    }
+
+    std::fill(binned, binned + bins, empty_bin());
+    const float scale = bins / extents[a];
+
+    for (size_t i = first; i < last; ++i) {
+      const uint32_t object = state.objects[i];
+      const float c = a == 0 ? state.centroids[object].x
+          : a == 1 ? state.centroids[object].y : state.centroids[object].z;
+      const int b = std::min(bins - 1, static_cast<int>((c - mins[a]) * scale));
+
+      binned[b].min = math::min(binned[b].min, state.mins[object]);
+      binned[b].max = math::max(binned[b].max, state.maxs[object]);
+      ++binned[b].count;
+    }
+
+    bin left = empty_bin();
+
+    for (int b = 0; b < bins - 1; ++b) {
+      left.min = math::min(left.min, binned[b].min);
+      left.max = math::max(left.max, binned[b].max);
+      left.count += binned[b].count;
+      left_costs[b] = left.count > 0 ? half_area(left.min, left.max) * left.count : 0.0f;
+    }
+
+    bin right = empty_bin();
+
+    for (int b = bins - 1; b > 0; --b) {
+      right.min = math::min(right.min, binned[b].min);
+      right.max = math::max(right.max, binned[b].max);
+      right.count += binned[b].count;
+
+      const float cost = left_costs[b - 1] + (right.count > 0 ? half_area(right.min, right.max) * right.count : 0.0f);
+
+      if (right.count > 0 && right.count < last - first && cost < best_cost) {
+        best_cost = cost;
+        axis = a;
+        split = b;
+      }
+    }
+  }
+
+  return axis >= 0;
+}
+
+// Builds the subtree over a range of objects, appending its nodes to an array in depth first order so each interior
+// node is followed by its left child.  Ranges larger than the parallel threshold build their left child as a job
+// into a separate array, which is spliced in once both children are done.
+//
+// Parameters
+// state - the build state
+// first - the first object in the range
+// last - one past the last object in the range
+// depth - the depth of the subtree's root
+// nodes - the array to append to
+//
+// Returns the depth of the deepest leaf
+int build_subtree(build_state& state, size_t first, size_t last, int depth, std::vector<bvh_node>& nodes) {
+  bin bounds = empty_bin();
+  bin centroids = empty_bin();
+
+  for (size_t i = first; i < last; ++i) {
+    const uint32_t object = state.objects[i];
+
+    bounds.min = math::min(bounds.min, state.mins[object]);
+    bounds.max = math::max(bounds.max, state.maxs[object]);
+    centroids.min = math::min(centroids.min, state.centroids[object]);
+    centroids.max = math::max(centroids.max, state.centroids[object]);
+  }
+
+  const size_t index = nodes.size();
+  nodes.push_back(bvh_node { bounds.min, static_cast<uint32_t>(first), bounds.max,
+      static_cast<uint32_t>(last - first) });
+
+  if (last - first <= static_cast<size_t>(state.options.max_leaf_size) || depth + 1 >= max_depth) {
+    return depth;
+  }
+
+  int axis = 0;
+  int split = 0;
+  size_t middle = first + (last - first) / 2;
+
+  if (find_split(state, first, last, centroids.min, centroids.max, axis, split)) {
+    const float centroid_min = axis == 0 ? centroids.min.x : axis == 1 ? centroids.min.y : centroids.min.z;
+    const float extent = (axis == 0 ? centroids.max.x : axis == 1 ? centroids.max.y : centroids.max.z) - centroid_min;
+    const float scale = state.options.bins / extent;
+
+    auto it = std::partition(state.objects.begin() + first, state.objects.begin() + last, [&](uint32_t object) {
+      const math::vec3& c = state.centroids[object];
+      const float value = axis == 0 ? c.x : axis == 1 ? c.y : c.z;
+
+      return std::min(state.options.bins - 1, static_cast<int>((value - centroid_min) * scale)) < split;
+    });
+
+    middle = static_cast<size_t>(it - state.objects.begin());
+  }
+
+  nodes[index].count = 0;
+
+  if (state.jobs == NULL || last - first < state.options.parallel_threshold) {
+    const int left_depth = build_subtree(state, first, middle, depth + 1, nodes);
+    nodes[index].first = static_cast<uint32_t>(nodes.size());
+    const int right_depth = build_subtree(state, middle, last, depth + 1, nodes);
+
+    return std::max(left_depth, right_depth);
+  }
+
+  std::vector<bvh_node> left;
+  int left_depth = 0;
+  job_counter counter;
+
+  state.jobs->run([&state, &left, &left_depth, first, middle, depth]() {
+    left_depth = build_subtree(state, first, middle, depth + 1, left);
+  }, &counter);
+
+  std::vector<bvh_node> right;
+  const int right_depth = build_subtree(state, middle, last, depth + 1, right);
+
+  state.jobs->wait(counter);
+
+  const uint32_t left_offset = static_cast<uint32_t>(nodes.size());
+  const uint32_t right_offset = left_offset + static_cast<uint32_t>(left.size());
+  nodes[index].first = right_offset;
+
+  for (bvh_node& node : left) {
+    node.first += node.count == 0 ? left_offset : 0;
+  }
+
+  for (bvh_node& node : right) {
+    node.first += node.count == 0 ? right_offset : 0;
+  }
+
+  nodes.insert(nodes.end(), left.begin(), left.end());
+  nodes.insert(nodes.end(), right.begin(), right.end());
+
+  return std::max(left_depth, right_depth);
+}
+
+}
+
+// Construct a bounding volume hierarchy over a set of boxes, building with binned surface area heuristic splits.
+// Nodes are stored in one array in depth first order: an interior node's left child follows it and first holds the
+// index of its right child, while a leaf holds a range of objects in first and count.  The bounds of each object are
+// copied into leaf order so a leaf's objects are contiguous in memory.
+//
+// Parameters
+// boxes - the bounds of each object
+// options - bins per axis, the largest leaf, and the size of range built in parallel
+// jobs - the job system to build on, which the calling thread must belong to, or NULL to build on the calling thread
+bvh::bvh(const bounding_boxes& boxes, const bvh_options& options, job_system* jobs)
+    : _depth(0) {
+  assert(options.bins >= 2 && options.bins <= max_bins);
+  assert(options.max_leaf_size >= 1);
+
+  MYOPENGL_TRACE_SCOPE("bvh::build");
+
+  const size_t count = boxes.centre_x.size();
+
+  _objects.resize(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    _objects[i] = static_cast<uint32_t>(i);
+  }
+
+  build_state state { options, jobs, {}, {}, {}, _objects };
+  state.mins.resize(count);
+  state.maxs.resize(count);
+  state.centroids.resize(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    const math::vec3 centre(boxes.centre_x[i], boxes.centre_y[i], boxes.centre_z[i]);
+    const math::vec3 extent(boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]);
+
+    state.mins[i] = centre - extent;
+    state.maxs[i] = centre + extent;
+    state.centroids[i] = centre;
+  }
+
+  if (count > 0) {
+    _nodes.reserve(2 * count / options.max_leaf_size + 1);
+    _depth = build_subtree(state, 0, count, 0, _nodes);
+  }
+
+  _mins.resize(count);
+  _maxs.resize(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    _mins[i] = state.mins[_objects[i]];
+    _maxs[i] = state.maxs[_objects[i]];
+  }
+}
+
+// Updates the bounds of every node after objects have moved, keeping the structure of the tree.  Children follow
+// their parents, so a single reverse pass over the nodes refits each one from finished children.  Queries stay
+// correct however far objects move but slow as the tree drifts from their layout, so rebuild after large changes.
+//
+// Parameters
+// boxes - the new bounds of each object, with the same number of objects the hierarchy was built over
+void bvh::refit(const bounding_boxes& boxes) {
+  assert(boxes.centre_x.size() == _objects.size());
+
+  MYOPENGL_TRACE_SCOPE("bvh::refit");
+
+  for (size_t i = 0; i < _objects.size(); ++i) {
+    const uint32_t object = _objects[i];
+    const math::vec3 centre(boxes.centre_x[object], boxes.centre_y[object], boxes.centre_z[object]);
+    const math::vec3 extent(boxes.extent_x[object], boxes.extent_y[object], boxes.extent_z[object]);
+
+    _mins[i] = centre - extent;
+    _maxs[i] = centre + extent;
+  }
+
+  for (size_t n = _nodes.size(); n-- > 0;) {
+    bvh_node& node = _nodes[n];
+
+    if (node.count > 0) {
+      node.min = _mins[node.first];
+      node.max = _maxs[node.first];
+
+      for (uint32_t i = node.first + 1; i < node.first + node.count; ++i) {
+        node.min = math::min(node.min, _mins[i]);
+        node.max = math::max(node.max, _maxs[i]);
+      }
+    } else {
+      node.min = math::min(_nodes[n + 1].min, _nodes[node.first].min);
+      node.max = math::max(_nodes[n + 1].max, _nodes[node.first].max);
+    }
+  }
+}
+
+// Finds the objects whose boxes intersect a frustum.  Subtrees wholly inside the frustum are added without testing
+// their boxes.
+//
+// Parameters
+// f - the frustum
+// visible - the indices of visible objects are appended to this
+//
+// Returns the number of visible objects
+size_t bvh::query(const frustum& f, std::vector<uint32_t>& visible) const {
+  if (_nodes.empty()) {
+    return 0;
+  }
+
+  const size_t start = visible.size();
+  uint32_t stack[max_depth];
+  bool inside[max_depth];
+  int top = 0;
+
+  stack[top] = 0;
+  inside[top++] = false;
+
+  while (top > 0) {
+    --top;
+    const bvh_node& node = _nodes[stack[top]];
+    bool contained = inside[top];
+
+    if (!contained) {
+      const containment c = classify(f, node.min, node.max);
+
+      if (c == containment::outside) {
+        continue;
+      }
+
+      contained = c == containment::inside;
+    }
+
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        if (contained || classify(f, _mins[i], _maxs[i]) != containment::outside) {
+          visible.push_back(_objects[i]);
+        }
+      }
+
+      continue;
+    }
+
+    stack[top] = node.first;
+    inside[top++] = contained;
+    stack[top] = static_cast<uint32_t>(&node - _nodes.data()) + 1;
+    inside[top++] = contained;
+  }
+
+  return visible.size() - start;
+}
+
+// Finds the nearest object whose box a ray hits.  Children are visited nearest first and skipped once they are
+// further than the closest hit, which makes picking logarithmic in the number of objects.
+//
+// Parameters
+// r - the ray, whose direction need not be unit length
+// max_distance - the furthest distance along the ray to consider, in multiples of the direction, which must be finite
+//                as a miss is reported as infinity
+// hit - receives the nearest object and the distance along the ray at which its box is entered
+//
+// Returns true if the ray hit a box
+bool bvh::raycast(const ray& r, float max_distance, ray_hit& hit) const noexcept {
+  if (_nodes.empty()) {
+    return false;
+  }
+
+  assert(std::isfinite(max_distance));
+
+  const math::vec3 inverse(1.0f / r.direction.x, 1.0f / r.direction.y, 1.0f / r.direction.z);
+  float nearest = max_distance;
+  bool found = false;
+
+  const float root_distance = intersect_box(r.origin, inverse, _nodes[0].min, _nodes[0].max, nearest);
+
+  if (root_distance == std::numeric_limits<float>::infinity()) {
+    return false;
+  }
+
+  uint32_t stack[max_depth];
+  float distances[max_depth];
+  int top = 0;
+
+  stack[top] = 0;
+  distances[top++] = 0.0f;
+
+  while (top > 0) {
+    --top;
+
+    if (distances[top] >= nearest) {
+      continue;
+    }
+
+    const bvh_node& node = _nodes[stack[top]];
+
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const float t = intersect_box(r.origin, inverse, _mins[i], _maxs[i], nearest);
+
+        if (t < nearest) {
+          nearest = t;
+          hit.object = _objects[i];
+          hit.distance = t;
+          found = true;
+        }
+      }
+
+      continue;
+    }
+
+    const uint32_t left = static_cast<uint32_t>(&node - _nodes.data()) + 1;
+    const uint32_t right = node.first;
+    const float left_distance = intersect_box(r.origin, inverse, _nodes[left].min, _nodes[left].max, nearest);
+    const float right_distance = intersect_box(r.origin, inverse, _nodes[right].min, _nodes[right].max, nearest);
+    const bool left_first = left_distance <= right_distance;
+
+    if (std::max(left_distance, right_distance) < nearest) {
+      stack[top] = left_first ? right : left;
+      distances[top++] = std::max(left_distance, right_distance);
+    }
+
+    if (std::min(left_distance, right_distance) < nearest) {
+      stack[top] = left_first ? left : right;
+      distances[top++] = std::min(left_distance, right_distance);
+    }
+  }
+
+  return found;
+}
+
+// Returns the nodes of the hierarchy in depth first order, the root first.
+const std::vector<bvh_node>& bvh::nodes() const noexcept {
+  return _nodes;
+}
+
+// Returns the number of objects in the hierarchy.
+size_t bvh::size() const noexcept {
+  return _objects.size();
+}
+
+// Returns the depth of the deepest leaf, 0 when the root is a leaf.
+int bvh::depth() const noexcept {
+  return _depth;
+}
+
+}
@@ -0,0 +1,354 @@
+#include <cassert>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "myopengl/command_buffer.h"
+#include "myopengl/frame_recorder.h"
+
+namespace myopengl {
+
+namespace {
+
+// Commands are stored back to back, each starting with its type.  Every command is plain data so recording is a
+// copy into the buffer and replay is a copy out of it, which also keeps reads free of alignment concerns.
+
+struct use_program_command {
+  command_type type;
+  unsigned int program;
+};
+
+struct bind_vertex_array_command {
+  command_type type;
+  unsigned int vertex_array;
+};
+
+struct bind_texture_command {
+  command_type type;
+  unsigned int unit;
+  unsigned int target;
+  unsigned int texture;
+};
+
+struct uniform_int_command {
+  command_type type;
+  int location;
+  int value;
+};
+
+struct uniform_float_command {
+  command_type type;
+  int location;
+  float value[4];
+};
+
+struct uniform_mat4_command {
+  command_type type;
+  int location;
+  float value[16];
+};
+
+struct draw_arrays_command {
+  command_type type;
+  unsigned int mode;
+  int first;
+  int count;
+};
+
+struct draw_elements_command {
+  command_type type;
+  unsigned int mode;
+  int count;
+  unsigned int index_type;
+  uint64_t offset;
+  int instances;
+};
+
+// Copies a command out of the buffer and advances past it.
+//
+// Parameters
+// data - the position of the command, advanced past it
+//
+// Returns the command
+template <typename command_t>
+command_t read(const unsigned char*& data) {
+  command_t command;
+  std::memcpy(&command, data, sizeof(command));
+  data += sizeof(command);
+
+  return command;
+}
+
+}
+
+// Construct an empty command buffer.  Each thread recording commands should own its buffer.
+//
+// Parameters
+// reserve_bytes - the capacity reserved up front so recording a typical frame does not allocate
+command_buffer::command_buffer(size_t reserve_bytes)
+    : _commands(0) {
+  _data.reserve(reserve_bytes);
+}
+
+// Records a program to use for the following draws.
+//
+// Parameters
+// program - the OpenGL id of the program, i.e. from shader::id
+void command_buffer::use_program(unsigned int program) {
+  push(use_program_command { command_type::use_program, program });
+}
+
+// Records a vertex array to bind for the following draws.
+//
+// Parameters
+// vertex_array - the OpenGL id of the vertex array
+void command_buffer::bind_vertex_array(unsigned int vertex_array) {
+  push(bind_vertex_array_command { command_type::bind_vertex_array, vertex_array });
+}
+
+// Records a texture to bind to a texture unit.
+//
+// Parameters
+// unit - the index of the texture unit, i.e. 0 for GL_TEXTURE0
+// target - the texture target, i.e. GL_TEXTURE_2D
+// texture - the OpenGL id of the texture
+void command_buffer::bind_texture(unsigned int unit, unsigned int target, unsigned int texture) {
+  push(bind_texture_command { command_type::bind_texture, unit, target, texture });
+}
+
+// Records setting an integer uniform of the program in use.
+//
+// Parameters
+// location - the location of the uniform, i.e. from shader::uniform_location
+// value - the value to be set
+void command_buffer::set_uniform(int location, int value) {
+  push(uniform_int_command { command_type::uniform_int, location, value });
+}
+
+// Records setting a float uniform of the program in use.
+//
+// Parameters
+// location - the location of the uniform
+// value - the value to be set
+void command_buffer::set_uniform(int location, float value) {
+  push(uniform_float_command { command_type::uniform_float, location, { value, 0.0f, 0.0f, 0.0f } });
+}
+
+// Records setting a vec2 uniform of the program in use.
+//
+// Parameters
+// location - the location of the uniform
+// x - the first component of the value to be set
+// y - the second component of the value to be set
+void command_buffer::set_uniform(int location, float x, float y) {
+  push(uniform_float_command { command_type::uniform_vec2, location, { x, y, 0.0f, 0.0f } });
+}
+
+// Records setting a vec4 uniform of the program in use.
+//
+// Parameters
+// location - the location of the uniform
+// x, y, z, w - the components of the value to be set
+void command_buffer::set_uniform(int location, float x, float y, float z, float w) {
+  push(uniform_float_command { command_type::uniform_vec4, location, { x, y, z, w } });
+}
+
+// Records setting a mat4 uniform of the program in use.
+//
+// Parameters
+// location - the location of the uniform
+// matrix - 16 floats in column major order, copied into the buffer
+void command_buffer::set_uniform_matrix(int location, const float* matrix) {
+  assert(matrix != NULL);
+
+  uniform_mat4_command command;
+  command.type = command_type::uniform_mat4;
+  command.location = location;
+  std::memcpy(command.value, matrix, sizeof(command.value));
+
+  push(command);
+}
+
+// Records drawing from the bound vertex array.
+//
+// Parameters
+// mode - the primitive type, i.e. GL_TRIANGLES
+// first - the first vertex to draw
+// count - the number of vertices to draw
+void command_buffer::draw_arrays(unsigned int mode, int first, int count) {
+  push(draw_arrays_command { command_type::draw_arrays, mode, first, count });
+}
+
+// Records drawing with the element buffer of the bound vertex array.
+//
+// Parameters
+// mode - the primitive type, i.e. GL_TRIANGLES
+// count - the number of indices to draw
+// type - the type of the indices, i.e. GL_UNSIGNED_INT
+// offset - the byte offset of the first index in the element buffer
+void command_buffer::draw_elements(unsigned int mode, int count, unsigned int type, size_t offset) {
+  push(draw_elements_command { command_type::draw_elements, mode, count, type, offset, 1 });
+}
+
+// Records an instanced draw with the element buffer of the bound vertex array.
+//
+// Parameters
+// mode - the primitive type, i.e. GL_TRIANGLES
+// count - the number of indices to draw
+// type - the type of the indices, i.e. GL_UNSIGNED_INT
+// offset - the byte offset of the first index in the element buffer
+// instances - the number of instances to draw
+void command_buffer::draw_elements_instanced(unsigned int mode, int count, unsigned int type, size_t offset, int instances) {
+  push(draw_elements_command { command_type::draw_elements_instanced, mode, count, type, offset, instances });
+}
+
+// Discards every command, keeping the memory for the next frame.
+void command_buffer::clear() noexcept {
+  _data.clear();
+  _commands = 0;
+}
+
+// Returns the number of bytes of commands recorded.
+size_t command_buffer::size() const noexcept {
+  return _data.size();
+}
+
+// Returns the number of commands recorded.
+size_t command_buffer::commands() const noexcept {
+  return _commands;
+}
+
+// Issues every command in the order recorded.  Must be called on the thread owning the OpenGL context.
+void command_buffer::replay() const {
+  replay_state state;
+  replay(state);
+}
+
+// Appends a command to the buffer.
+//
+// Parameters
+// command - the command to append
+template <typename command_t>
+void command_buffer::push(const command_t& command) {
+  size_t offset = _data.size();
+
+  _data.resize(offset + sizeof(command));
+  std::memcpy(_data.data() + offset, &command, sizeof(command));
+
+  ++_commands;
+}
+
+// Issues every command in the order recorded, skipping program, vertex array and texture unit changes which would
+// not change the state left by earlier commands.  Replay stops at an unknown command type, since the size of the
+// command, and so the position of the next, cannot be known.
+//
+// Parameters
+// state - the state left by earlier commands, updated as commands are issued
+void command_buffer::replay(replay_state& state) const {
+  const unsigned char* data = _data.data();
+  const unsigned char* end = data + _data.size();
+
+  while (data < end) {
+    command_type type;
+    std::memcpy(&type, data, sizeof(type));
+
+    switch (type) {
+      case command_type::use_program: {
+        use_program_command c = read<use_program_command>(data);
+
+        if (c.program != state.program) {
+          glUseProgram(c.program);
+          record_state_change();
+          state.program = c.program;
+        }
+
+        break;
+      }
+      case command_type::bind_vertex_array: {
+        bind_vertex_array_command c = read<bind_vertex_array_command>(data);
+
+        if (c.vertex_array != state.vertex_array) {
+          glBindVertexArray(c.vertex_array);
+          record_state_change();
+          state.vertex_array = c.vertex_array;
+        }
+
+        break;
+      }
+      case command_type::bind_texture: {
+        bind_texture_command c = read<bind_texture_command>(data);
+
+        if (c.unit != state.active_unit) {
+          glActiveTexture(GL_TEXTURE0 + c.unit);
+          state.active_unit = c.unit;
+        }
+
+        glBindTexture(c.target, c.texture);
+        record_state_change();
+        break;
+      }
+      case command_type::uniform_int: {
+        uniform_int_command c = read<uniform_int_command>(data);
+        glUniform1i(c.location, c.value);
+        break;
+      }
+      case command_type::uniform_float: {
+        uniform_float_command c = read<uniform_float_command>(data);
+        glUniform1f(c.location, c.value[0]);
+        break;
+      }
+      case command_type::uniform_vec2: {
+        uniform_float_command c = read<uniform_float_command>(data);
+        glUniform2f(c.location, c.value[0], c.value[1]);
+        break;
+      }
+      case command_type::uniform_vec4: {
+        uniform_float_command c = read<uniform_float_command>(data);
+        glUniform4f(c.location, c.value[0], c.value[1], c.value[2], c.value[3]);
+        break;
+      }
+      case command_type::uniform_mat4: {
+        uniform_mat4_command c = read<uniform_mat4_command>(data);
+        glUniformMatrix4fv(c.location, 1, GL_FALSE, c.value);
+        break;
+      }
+      case command_type::draw_arrays: {
+        draw_arrays_command c = read<draw_arrays_command>(data);
+        glDrawArrays(c.mode, c.first, c.count);
+        record_draw_call();
+        break;
+      }
+      case command_type::draw_elements: {
+        draw_elements_command c = read<draw_elements_command>(data);
+        glDrawElements(c.mode, c.count, c.index_type, reinterpret_cast<const void*>(c.offset));
+        record_draw_call();
+        break;
+      }
+      case command_type::draw_elements_instanced: {
+        draw_elements_command c = read<draw_elements_command>(data);
+        glDrawElementsInstanced(c.mode, c.count, c.index_type, reinterpret_cast<const void*>(c.offset), c.instances);
+        record_draw_call();
+        break;
+      }
+      default:
+        assert(false && "Unknown command type");
+        data = end;
+        break;
+    }
+  }
+}
+
+// Issues the commands of several buffers, i.e. one per worker thread, one buffer after another.  Redundant binds are
+// skipped across buffers as well as within them.  Must be called on the thread owning the OpenGL context.
+//
+// Parameters
+// buffers - the buffers to replay, in order
+void replay(const std::vector<command_buffer>& buffers) {
+  command_buffer::replay_state state;
+
+  for (const command_buffer& buffer : buffers) {
+    buffer.replay(state);
+  }
+}
+
+}
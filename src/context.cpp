@@ -0,0 +1,177 @@
+#include <cstdlib>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/gl_intercept.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+#ifdef MYOPENGL_HAS_GLFW
+std::unique_ptr<context> create_glfw_context(const context_options& options);
+#endif
+
+#ifdef MYOPENGL_HAS_EGL
+std::unique_ptr<context> create_headless_context(const context_options& options);
+#endif
+
+// Construct the shared state of a context.
+//
+// Parameters
+// options - the options the context was created with
+context::context(const context_options& options)
+    : _frame_limit(options.frame_limit)
+    , _frame(0)
+    , _close_requested(false) {
+}
+
+// Returns the framebuffer the application should render into.  0 is the default framebuffer of a window.
+unsigned int context::framebuffer() const noexcept {
+  return 0;
+}
+
+// Sets the number of display refreshes swap_buffers waits for, 0 to present immediately and -1 for adaptive vsync,
+// which waits unless the frame is already late.  Contexts without a display never wait.
+//
+// Parameters
+// interval - the swap interval
+//
+// Returns true if the interval is supported
+bool context::set_swap_interval(int interval) {
+  return interval == 0;
+}
+
+// Returns the rate in frames per second at which swap_buffers presents when synchronised to the display, or 0 when
+// presentation is not synchronised or the rate is unknown.
+double context::presentation_rate() const {
+  return 0.0;
+}
+
+// Called by create_context once OpenGL is loaded, for backends which create OpenGL objects of their own.  The base
+// context has none.
+//
+// Throws
+// context_exception - if the backend's objects could not be created
+void context::gl_loaded() {
+}
+
+// Returns true once the user has asked to close the context or the frame limit has been reached.
+bool context::should_close() const noexcept {
+  return _close_requested || (_frame_limit > 0 && _frame >= _frame_limit);
+}
+
+// Asks for the render loop to end.
+void context::request_close() noexcept {
+  _close_requested = true;
+}
+
+// Returns the number of frames which have been presented.
+int context::frame() const noexcept {
+  return _frame;
+}
+
+// Counts a presented frame.  Called by backends from swap_buffers.
+void context::end_frame() noexcept {
+  ++_frame;
+}
+
+// Builds context options from the command line.  Recognises --headless, --frames N, --width N, --height N,
+// --swap-interval N and --lazy-gl, to resolve OpenGL functions on first use.  Builds without a windowing backend
+// always run headless.  Options for the application are left to parse_app_options.
+//
+// Parameters
+// argc - count of command line argumnets
+// argv - array of command line arguments
+// title - the window title to use
+//
+// Returns the options parsed
+context_options parse_context_options(int argc, char* argv[], const char* title) {
+  context_options options;
+  options.title = title;
+
+#ifndef MYOPENGL_HAS_GLFW
+  options.headless = true;
+#endif
+
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+
+    if (std::strcmp(argv[i], "--headless") == 0) {
+      options.headless = true;
+    } else if (std::strcmp(argv[i], "--lazy-gl") == 0) {
+      options.loading = gl_loading::lazy;
+    } else if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+      options.frame_limit = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--width") == 0 && has_value) {
+      options.width = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--height") == 0 && has_value) {
+      options.height = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--swap-interval") == 0 && has_value) {
+      options.swap_interval = std::atoi(argv[++i]);
+    }
+  }
+
+  return options;
+}
+
+// Creates an OpenGL 3.3 core context, makes it current and loads OpenGL and the extensions the library uses, wrapping
+// OpenGL calls with counting hooks in builds with MYOPENGL_GL_INTERCEPT.  The swap interval is applied, falling back
+// to vsync where adaptive vsync is unsupported.  A window is created through GLFW unless
+// headless rendering is requested, in which case an EGL surfaceless context renders into an offscreen framebuffer.
+//
+// Parameters
+// options - size, title and backend options
+//
+// Throws
+// context_exception - if the requested backend is unavailable or the context could not be created
+//
+// Returns the context
+std::unique_ptr<context> create_context(const context_options& options) {
+  MYOPENGL_TRACE_SCOPE("create_context");
+
+  std::unique_ptr<context> result;
+
+  if (options.headless) {
+#ifdef MYOPENGL_HAS_EGL
+    result = create_headless_context(options);
+#else
+    throw context_exception("Headless rendering requires a build with MYOPENGL_HEADLESS");
+#endif
+  } else {
+#ifdef MYOPENGL_HAS_GLFW
+    result = create_glfw_context(options);
+#else
+    throw context_exception("Windowed rendering requires GLFW");
+#endif
+  }
+
+  if (!load_gl(result->proc_loader(), options.loading)) {
+    throw context_exception("Failed to initialise GLAD");
+  }
+
+  install_gl_interception();
+
+  load_extensions(result->proc_loader());
+
+  result->gl_loaded();
+
+  result->set_swap_interval(options.swap_interval);
+
+  if (options.srgb) {
+    glEnable(GL_FRAMEBUFFER_SRGB);
+  }
+
+  int width = 0;
+  int height = 0;
+  result->framebuffer_size(width, height);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, result->framebuffer());
+  glViewport(0, 0, width, height);
+
+  return result;
+}
+
+}
@@ -0,0 +1,18 @@
+#include "myopengl/context_exception.h"
+
+namespace myopengl {
+
+// Construct a new instance of a context_exception
+//
+// Parameters
+// message - the message to be associated with the exception
+myopengl::context_exception::context_exception(const std::string& message) noexcept
+    : _message(message) {
+}
+
+// Returns the message associated with this exception
+const char* myopengl::context_exception::what() const noexcept {
+  return _message.c_str();
+}
+
+}
@@ -0,0 +1,392 @@
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#ifdef __AVX__
+#define MYOPENGL_CULLING_AVX
+#include <immintrin.h>
+#endif
+
+#include "myopengl/culling.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+namespace {
+
+// Culls a range of spheres one at a time.
+//
+// Parameters
+// f - the frustum
+// spheres - the bounding spheres
+// first - the index of the first sphere
+// last - one past the index of the last sphere
+// visible - receives the indices of visible spheres
+//
+// Returns the number of visible spheres
+size_t cull_spheres_scalar(const frustum& f, const bounding_spheres& spheres, size_t first, size_t last,
+    uint32_t* visible) {
+  size_t count = 0;
+
+  for (size_t i = first; i < last; ++i) {
+    visible[count] = static_cast<uint32_t>(i);
+    count += intersects(f, math::vec3(spheres.x[i], spheres.y[i], spheres.z[i]), spheres.radius[i]) ? 1 : 0;
+  }
+
+  return count;
+}
+
+// Culls a range of boxes one at a time.
+//
+// Parameters
+// f - the frustum
+// boxes - the bounding boxes
+// first - the index of the first box
+// last - one past the index of the last box
+// visible - receives the indices of visible boxes
+//
+// Returns the number of visible boxes
+size_t cull_boxes_scalar(const frustum& f, const bounding_boxes& boxes, size_t first, size_t last,
+    uint32_t* visible) {
+  size_t count = 0;
+
+  for (size_t i = first; i < last; ++i) {
+    const math::vec3 centre(boxes.centre_x[i], boxes.centre_y[i], boxes.centre_z[i]);
+    const math::vec3 extent(boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]);
+
+    visible[count] = static_cast<uint32_t>(i);
+    count += intersects(f, centre, extent) ? 1 : 0;
+  }
+
+  return count;
+}
+
+// Appends the indices of the lanes clear in an outside mask without branching.  Every index is written at the current
+// count, which never passes the lane's own position in the output, and the count only advances for visible lanes.
+//
+// Parameters
+// outside - a bit per lane, set when the object is outside the frustum
+// lanes - the number of lanes
+// base - the index of the object in the first lane
+// visible - receives the indices of visible objects
+// count - the number of indices written so far, advanced by the number of visible lanes
+void compact(int outside, int lanes, size_t base, uint32_t* visible, size_t& count) {
+  for (int lane = 0; lane < lanes; ++lane) {
+    visible[count] = static_cast<uint32_t>(base + lane);
+    count += ((outside >> lane) & 1) ^ 1;
+  }
+}
+
+#ifdef MYOPENGL_MATH_SSE
+
+// Culls a range of spheres four at a time, with a scalar tail.  With AVX the range is culled eight at a time before
+// falling back to four.
+//
+// Returns the number of visible spheres
+size_t cull_spheres_simd(const frustum& f, const bounding_spheres& spheres, size_t first, size_t last,
+    uint32_t* visible) {
+  size_t count = 0;
+  size_t i = first;
+
+#ifdef MYOPENGL_CULLING_AVX
+  for (; i + 8 <= last; i += 8) {
+    const __m256 x = _mm256_loadu_ps(&spheres.x[i]);
+    const __m256 y = _mm256_loadu_ps(&spheres.y[i]);
+    const __m256 z = _mm256_loadu_ps(&spheres.z[i]);
+    const __m256 r = _mm256_loadu_ps(&spheres.radius[i]);
+
+    __m256 outside = _mm256_setzero_ps();
+
+    for (const math::vec4& p : f.planes) {
+      __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.x), x), _mm256_mul_ps(_mm256_set1_ps(p.y), y));
+      d = _mm256_add_ps(_mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(p.z), z)), _mm256_set1_ps(p.w));
+      outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_setzero_ps(), _CMP_LT_OQ));
+    }
+
+    compact(_mm256_movemask_ps(outside), 8, i, visible, count);
+  }
+#endif
+
+  for (; i + 4 <= last; i += 4) {
+    const __m128 x = _mm_loadu_ps(&spheres.x[i]);
+    const __m128 y = _mm_loadu_ps(&spheres.y[i]);
+    const __m128 z = _mm_loadu_ps(&spheres.z[i]);
+    const __m128 r = _mm_loadu_ps(&spheres.radius[i]);
+
+    __m128 outside = _mm_setzero_ps();
+
+    for (const math::vec4& p : f.planes) {
+      __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), x), _mm_mul_ps(_mm_set1_ps(p.y), y));
+      d = _mm_add_ps(_mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(p.z), z)), _mm_set1_ps(p.w));
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+    }
+
+    compact(_mm_movemask_ps(outside), 4, i, visible, count);
+  }
+
+  return count + cull_spheres_scalar(f, spheres, i, last, visible + count);
+}
+
+// Culls a range of boxes four at a time, with a scalar tail.  Each plane is tested against the box's projected
+// radius, the extent dotted with the absolute plane normal.  With AVX the range is culled eight at a time before
+// falling back to four.
+//
+// Returns the number of visible boxes
+size_t cull_boxes_simd(const frustum& f, const bounding_boxes& boxes, size_t first, size_t last,
+    uint32_t* visible) {
+  size_t count = 0;
+  size_t i = first;
+
+#ifdef MYOPENGL_CULLING_AVX
+  for (; i + 8 <= last; i += 8) {
+    const __m256 cx = _mm256_loadu_ps(&boxes.centre_x[i]);
+    const __m256 cy = _mm256_loadu_ps(&boxes.centre_y[i]);
+    const __m256 cz = _mm256_loadu_ps(&boxes.centre_z[i]);
+    const __m256 ex = _mm256_loadu_ps(&boxes.extent_x[i]);
+    const __m256 ey = _mm256_loadu_ps(&boxes.extent_y[i]);
+    const __m256 ez = _mm256_loadu_ps(&boxes.extent_z[i]);
+
+    __m256 outside = _mm256_setzero_ps();
+
+    for (const math::vec4& p : f.planes) {
+      __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.x), cx), _mm256_mul_ps(_mm256_set1_ps(p.y), cy));
+      d = _mm256_add_ps(_mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(p.z), cz)), _mm256_set1_ps(p.w));
+
+      __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::fabs(p.x)), ex),
+          _mm256_mul_ps(_mm256_set1_ps(std::fabs(p.y)), ey));
+      r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(std::fabs(p.z)), ez));
+
+      outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_setzero_ps(), _CMP_LT_OQ));
+    }
+
+    compact(_mm256_movemask_ps(outside), 8, i, visible, count);
+  }
+#endif
+
+  for (; i + 4 <= last; i += 4) {
+    const __m128 cx = _mm_loadu_ps(&boxes.centre_x[i]);
+    const __m128 cy = _mm_loadu_ps(&boxes.centre_y[i]);
+    const __m128 cz = _mm_loadu_ps(&boxes.centre_z[i]);
+    const __m128 ex = _mm_loadu_ps(&boxes.extent_x[i]);
+    const __m128 ey = _mm_loadu_ps(&boxes.extent_y[i]);
+    const __m128 ez = _mm_loadu_ps(&boxes.extent_z[i]);
+
+    __m128 outside = _mm_setzero_ps();
+
+    for (const math::vec4& p : f.planes) {
+      __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), cx), _mm_mul_ps(_mm_set1_ps(p.y), cy));
+      d = _mm_add_ps(_mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(p.z), cz)), _mm_set1_ps(p.w));
+
+      __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(p.x)), ex),
+          _mm_mul_ps(_mm_set1_ps(std::fabs(p.y)), ey));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(std::fabs(p.z)), ez));
+
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+    }
+
+    compact(_mm_movemask_ps(outside), 4, i, visible, count);
+  }
+
+  return count + cull_boxes_scalar(f, boxes, i, last, visible + count);
+}
+
+#endif
+
+// Runs a culling kernel over every object, splitting the objects into chunks across the job system when there are
+// more than the grain.  Each chunk writes its visible indices at the start of its own range of the output, and the
+// ranges are then moved together, so the output is in index order whatever the number of threads.
+//
+// Parameters
+// count - the number of objects
+// options - the grain of each job
+// jobs - the job system to cull on, or NULL
+// visible - receives the indices of visible objects
+// kernel - culls a range of objects, returning the number visible
+//
+// Returns the number of visible objects
+template <typename K>
+size_t cull_chunks(size_t count, const cull_options& options, job_system* jobs, uint32_t* visible, K kernel) {
+  assert(options.grain > 0);
+
+  if (jobs == NULL || count <= options.grain) {
+    return kernel(0, count, visible);
+  }
+
+  const size_t grain = options.grain;
+  std::vector<size_t> counts((count + grain - 1) / grain);
+
+  jobs->parallel_for(count, grain, [&](size_t first, size_t last) {
+    counts[first / grain] = kernel(first, last, visible + first);
+  });
+
+  size_t total = counts[0];
+
+  for (size_t chunk = 1; chunk < counts.size(); ++chunk) {
+    std::memmove(visible + total, visible + chunk * grain, counts[chunk] * sizeof(uint32_t));
+    total += counts[chunk];
+  }
+
+  return total;
+}
+
+}
+
+// Extracts the six planes of a view frustum from a view projection matrix, normalized so distances are in world
+// units.  A point is inside a plane when its dot product with the plane's normal plus the plane's w is not negative.
+//
+// Parameters
+// view_projection - the projection multiplied by the view, mapping world space to OpenGL clip space
+//
+// Returns the frustum
+frustum extract_frustum(const math::mat4& view_projection) noexcept {
+  const math::mat4 rows = math::transpose(view_projection);
+
+  frustum result;
+  result.planes[0] = rows[3] + rows[0];
+  result.planes[1] = rows[3] - rows[0];
+  result.planes[2] = rows[3] + rows[1];
+  result.planes[3] = rows[3] - rows[1];
+  result.planes[4] = rows[3] + rows[2];
+  result.planes[5] = rows[3] - rows[2];
+
+  for (math::vec4& plane : result.planes) {
+    const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+    plane = plane * (1.0f / length);
+  }
+
+  return result;
+}
+
+// Tests whether a sphere is at least partly inside a frustum.  Spheres near a corner of the frustum may be reported
+// visible when they are not, which is conservative.
+//
+// Parameters
+// f - the frustum
+// centre - the centre of the sphere
+// radius - the radius of the sphere
+//
+// Returns true if the sphere is not wholly outside any plane
+bool intersects(const frustum& f, const math::vec3& centre, float radius) noexcept {
+  for (const math::vec4& p : f.planes) {
+    const float d = p.x * centre.x + p.y * centre.y + p.z * centre.z + p.w;
+
+    if (d + radius < 0.0f) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Tests whether an axis aligned box is at least partly inside a frustum, conservatively as for spheres.
+//
+// Parameters
+// f - the frustum
+// centre - the centre of the box
+// extent - half the size of the box along each axis
+//
+// Returns true if the box is not wholly outside any plane
+bool intersects(const frustum& f, const math::vec3& centre, const math::vec3& extent) noexcept {
+  for (const math::vec4& p : f.planes) {
+    const float d = p.x * centre.x + p.y * centre.y + p.z * centre.z + p.w;
+    const float r = std::fabs(p.x) * extent.x + std::fabs(p.y) * extent.y + std::fabs(p.z) * extent.z;
+
+    if (d + r < 0.0f) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Appends a sphere to a set of bounding spheres.
+//
+// Parameters
+// spheres - the set to append to
+// centre - the centre of the sphere
+// radius - the radius of the sphere
+void add_sphere(bounding_spheres& spheres, const math::vec3& centre, float radius) {
+  spheres.x.push_back(centre.x);
+  spheres.y.push_back(centre.y);
+  spheres.z.push_back(centre.z);
+  spheres.radius.push_back(radius);
+}
+
+// Appends an axis aligned box to a set of bounding boxes, stored as its centre and extent.
+//
+// Parameters
+// boxes - the set to append to
+// min - the minimum corner of the box
+// max - the maximum corner of the box
+void add_box(bounding_boxes& boxes, const math::vec3& min, const math::vec3& max) {
+  boxes.centre_x.push_back((min.x + max.x) * 0.5f);
+  boxes.centre_y.push_back((min.y + max.y) * 0.5f);
+  boxes.centre_z.push_back((min.z + max.z) * 0.5f);
+  boxes.extent_x.push_back((max.x - min.x) * 0.5f);
+  boxes.extent_y.push_back((max.y - min.y) * 0.5f);
+  boxes.extent_z.push_back((max.z - min.z) * 0.5f);
+}
+
+// Culls bounding spheres against a frustum, producing a compact list of the indices of visible spheres in ascending
+// order.
+//
+// Parameters
+// f - the frustum
+// spheres - the bounding spheres
+// visible - receives the indices of visible spheres, with room for every sphere
+// options - the grain of each job and whether to use the SIMD kernels
+// jobs - the job system to cull on, which the calling thread must belong to, or NULL to cull on the calling thread
+//
+// Returns the number of visible spheres
+size_t cull(const frustum& f, const bounding_spheres& spheres, uint32_t* visible, const cull_options& options,
+    job_system* jobs) {
+  assert(spheres.y.size() == spheres.x.size() && spheres.z.size() == spheres.x.size());
+  assert(spheres.radius.size() == spheres.x.size());
+  assert(visible != NULL || spheres.x.empty());
+
+  MYOPENGL_TRACE_SCOPE("cull_spheres");
+
+  return cull_chunks(spheres.x.size(), options, jobs, visible, [&](size_t first, size_t last, uint32_t* out) {
+#ifdef MYOPENGL_MATH_SSE
+    if (options.use_simd) {
+      return cull_spheres_simd(f, spheres, first, last, out);
+    }
+#endif
+
+    return cull_spheres_scalar(f, spheres, first, last, out);
+  });
+}
+
+// Culls axis aligned bounding boxes against a frustum, producing a compact list of the indices of visible boxes in
+// ascending order.
+//
+// Parameters
+// f - the frustum
+// boxes - the bounding boxes
+// visible - receives the indices of visible boxes, with room for every box
+// options - the grain of each job and whether to use the SIMD kernels
+// jobs - the job system to cull on, which the calling thread must belong to, or NULL to cull on the calling thread
+//
+// Returns the number of visible boxes
+size_t cull(const frustum& f, const bounding_boxes& boxes, uint32_t* visible, const cull_options& options,
+    job_system* jobs) {
+  const size_t count = boxes.centre_x.size();
+
+  assert(boxes.centre_y.size() == count && boxes.centre_z.size() == count);
+  assert(boxes.extent_x.size() == count && boxes.extent_y.size() == count && boxes.extent_z.size() == count);
+  assert(visible != NULL || count == 0);
+
+  MYOPENGL_TRACE_SCOPE("cull_boxes");
+
+  return cull_chunks(count, options, jobs, visible, [&](size_t first, size_t last, uint32_t* out) {
+#ifdef MYOPENGL_MATH_SSE
+    if (options.use_simd) {
+      return cull_boxes_simd(f, boxes, first, last, out);
+    }
+#endif
+
+    return cull_boxes_scalar(f, boxes, first, last, out);
+  });
+}
+
+}
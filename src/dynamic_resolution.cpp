@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <string>
+
+#include <glad/glad.h>
+
+#include "myopengl/context_exception.h"
+#include "myopengl/dynamic_resolution.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+namespace {
+
+// The fraction of the budget the scale aims for, leaving room for frame to frame variation.
+const double budget_headroom = 0.9;
+
+}
+
+// Construct a dynamic resolution renderer.  The scene is rendered into an offscreen framebuffer at a fraction of the
+// output size which is adjusted each frame from the measured GPU time, then upscaled into the output framebuffer.
+// GPU time is measured with GL_TIMESTAMP queries read back several frames later, so it can be used alongside a
+// frame_recorder's elapsed time queries without stalling the pipeline.  Storage is allocated at the largest scale so
+// changing the scale only changes the viewport.
+//
+// Parameters
+// options - the GPU time budget and the range the scale is kept within
+dynamic_resolution::dynamic_resolution(const dynamic_resolution_options& options)
+    : _options(options)
+    , _queries((options.query_latency + 1) * 2)
+    , _next_query(0)
+    , _pending(0)
+    , _framebuffer(0)
+    , _colour(0)
+    , _depth_stencil(0)
+    , _output_width(0)
+    , _output_height(0)
+    , _render_width(0)
+    , _render_height(0)
+    , _scale(options.max_scale)
+    , _gpu_ms(0.0)
+    , _in_frame(false) {
+  assert(options.budget_ms > 0.0);
+  assert(options.min_scale > 0.0f && options.min_scale <= options.max_scale);
+  assert(options.smoothing > 0.0f && options.smoothing <= 1.0f);
+  assert(options.query_latency >= 0);
+
+  glGenQueries(static_cast<int>(_queries.size()), _queries.data());
+}
+
+// Deconstructs a dynamic resolution renderer, releasing its framebuffer and queries.
+dynamic_resolution::~dynamic_resolution() {
+  release();
+  glDeleteQueries(static_cast<int>(_queries.size()), _queries.data());
+}
+
+// Starts rendering a frame.  GPU times of earlier frames which are ready are applied to the scale, the offscreen
+// framebuffer is bound and the viewport is set to the scaled size.  The framebuffer is reallocated when the output
+// size changes.
+//
+// Parameters
+// output_width - the width of the framebuffer the frame will be upscaled into
+// output_height - the height of the framebuffer the frame will be upscaled into
+//
+// Throws
+// context_exception - if the offscreen framebuffer is incomplete
+void dynamic_resolution::begin_frame(int output_width, int output_height) {
+  assert(!_in_frame);
+  assert(output_width > 0 && output_height > 0);
+
+  while (read_oldest(false)) {
+  }
+
+  if (_pending == _queries.size() / 2) {
+    read_oldest(true);
+  }
+
+  if (output_width != _output_width || output_height != _output_height) {
+    allocate(output_width, output_height);
+  }
+
+  _render_width = std::max(1, static_cast<int>(std::lround(output_width * _scale)));
+  _render_height = std::max(1, static_cast<int>(std::lround(output_height * _scale)));
+
+  glQueryCounter(_queries[_next_query * 2], GL_TIMESTAMP);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+  glViewport(0, 0, _render_width, _render_height);
+
+  _in_frame = true;
+}
+
+// Ends rendering a frame, upscaling it with linear filtering into the output framebuffer, which is left bound with
+// the viewport covering it.
+//
+// Parameters
+// output_framebuffer - the framebuffer to upscale into, i.e. context::framebuffer
+void dynamic_resolution::end_frame(unsigned int output_framebuffer) {
+  assert(_in_frame);
+
+  MYOPENGL_TRACE_SCOPE("dynamic_resolution::end_frame");
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, output_framebuffer);
+  glBlitFramebuffer(0, 0, _render_width, _render_height, 0, 0, _output_width, _output_height, GL_COLOR_BUFFER_BIT,
+      GL_LINEAR);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, output_framebuffer);
+  glViewport(0, 0, _output_width, _output_height);
+
+  glQueryCounter(_queries[_next_query * 2 + 1], GL_TIMESTAMP);
+
+  _next_query = (_next_query + 1) % (_queries.size() / 2);
+  ++_pending;
+  _in_frame = false;
+}
+
+// Returns the fraction of the output size the scene is rendered at.
+float dynamic_resolution::scale() const noexcept {
+  return _scale;
+}
+
+// Retrieves the size the current frame is rendered at.
+//
+// Parameters
+// width - receives the width in pixels
+// height - receives the height in pixels
+void dynamic_resolution::render_size(int& width, int& height) const noexcept {
+  width = _render_width;
+  height = _render_height;
+}
+
+// Returns the most recently measured GPU time of a frame in milliseconds.
+double dynamic_resolution::gpu_ms() const noexcept {
+  return _gpu_ms;
+}
+
+// Returns the offscreen framebuffer the scene is rendered into.
+unsigned int dynamic_resolution::framebuffer() const noexcept {
+  return _framebuffer;
+}
+
+// Returns the colour texture of the offscreen framebuffer, i.e. for an upscaling shader in place of the blit.
+unsigned int dynamic_resolution::texture() const noexcept {
+  return _colour;
+}
+
+// Allocates the offscreen framebuffer for an output size, with a colour texture and a combined depth stencil
+// renderbuffer large enough for the largest scale.
+//
+// Parameters
+// output_width - the width of the output framebuffer
+// output_height - the height of the output framebuffer
+//
+// Throws
+// context_exception - if the framebuffer is incomplete
+void dynamic_resolution::allocate(int output_width, int output_height) {
+  release();
+
+  _output_width = output_width;
+  _output_height = output_height;
+
+  int width = std::max(1, static_cast<int>(std::ceil(output_width * _options.max_scale)));
+  int height = std::max(1, static_cast<int>(std::ceil(output_height * _options.max_scale)));
+
+  glGenTextures(1, &_colour);
+  glBindTexture(GL_TEXTURE_2D, _colour);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexImage2D(GL_TEXTURE_2D, 0, _options.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8, width, height, 0, GL_RGBA,
+      GL_UNSIGNED_BYTE, NULL);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenRenderbuffers(1, &_depth_stencil);
+  glBindRenderbuffer(GL_RENDERBUFFER, _depth_stencil);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &_framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _colour, 0);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _depth_stencil);
+
+  GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+  if (status != GL_FRAMEBUFFER_COMPLETE) {
+    throw context_exception("Dynamic resolution framebuffer is incomplete, status [" + std::to_string(status) + "]");
+  }
+}
+
+// Releases the offscreen framebuffer and its attachments.
+void dynamic_resolution::release() {
+  if (_framebuffer != 0) {
+    glDeleteFramebuffers(1, &_framebuffer);
+    glDeleteTextures(1, &_colour);
+    glDeleteRenderbuffers(1, &_depth_stencil);
+  }
+
+  _framebuffer = 0;
+  _colour = 0;
+  _depth_stencil = 0;
+}
+
+// Reads the GPU time of the oldest frame in flight and adjusts the scale from it.
+//
+// Parameters
+// wait - true to wait for the result, false to return if it is not yet available
+//
+// Returns true if a result was read
+bool dynamic_resolution::read_oldest(bool wait) {
+  if (_pending == 0) {
+    return false;
+  }
+
+  const size_t frames = _queries.size() / 2;
+  size_t oldest = (_next_query + frames - _pending) % frames;
+
+  if (!wait) {
+    int available = 0;
+    glGetQueryObjectiv(_queries[oldest * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (!available) {
+      return false;
+    }
+  }
+
+  GLuint64 begin = 0;
+  GLuint64 end = 0;
+  glGetQueryObjectui64v(_queries[oldest * 2], GL_QUERY_RESULT, &begin);
+  glGetQueryObjectui64v(_queries[oldest * 2 + 1], GL_QUERY_RESULT, &end);
+
+  --_pending;
+  adjust(end > begin ? static_cast<double>(end - begin) / 1000000.0 : 0.0);
+
+  return true;
+}
+
+// Moves the scale towards the size which would bring a frame's GPU time just under the budget.  Fill rate bound
+// frames cost roughly in proportion to their pixel count, the square of the scale, so the correction is the square
+// root of the ratio of the budget to the time taken.  Only part of the correction is applied each frame to avoid
+// oscillating on noisy timings.
+//
+// Parameters
+// gpu_ms - the GPU time of a frame in milliseconds
+void dynamic_resolution::adjust(double gpu_ms) {
+  _gpu_ms = gpu_ms;
+
+  if (gpu_ms <= 0.0) {
+    return;
+  }
+
+  double desired = _scale * std::sqrt(_options.budget_ms * budget_headroom / gpu_ms);
+  double scale = _scale + (desired - _scale) * _options.smoothing;
+
+  _scale = std::clamp(static_cast<float>(scale), _options.min_scale, _options.max_scale);
+}
+
+}
@@ -0,0 +1,124 @@
+#include <cassert>
+#include <string>
+#include <unordered_set>
+
+#include <glad/glad.h>
+
+#include "myopengl/extensions.h"
+
+namespace myopengl {
+
+namespace {
+
+const GLenum max_texture_max_anisotropy = 0x84FF;
+
+typedef void(APIENTRYP tex_storage_2d_t)(GLenum target, GLsizei levels, GLenum internal_format, GLsizei width,
+    GLsizei height);
+typedef void(APIENTRYP tex_storage_3d_t)(GLenum target, GLsizei levels, GLenum internal_format, GLsizei width,
+    GLsizei height, GLsizei depth);
+
+// Extension state resolved by load_extensions.  glad is generated for the 3.3 core profile without extensions, so
+// anything beyond it is resolved here.
+struct extension_state {
+  std::unordered_set<std::string> names;
+  tex_storage_2d_t tex_storage_2d = NULL;
+  tex_storage_3d_t tex_storage_3d = NULL;
+  float max_anisotropy = 1.0f;
+};
+
+extension_state& state() {
+  static extension_state instance;
+  return instance;
+}
+
+}
+
+// Queries the extensions supported by the current context and resolves the entry points of the ones the library
+// uses.  Must be called on the context thread after glad has been loaded.
+//
+// Parameters
+// load - function used to resolve OpenGL entry points, i.e. glfwGetProcAddress
+void load_extensions(proc_loader_t load) {
+  assert(load != NULL);
+
+  extension_state& s = state();
+  s = extension_state();
+
+  int count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+  for (int i = 0; i < count; ++i) {
+    const GLubyte* name = glGetStringi(GL_EXTENSIONS, i);
+
+    if (name != NULL) {
+      s.names.insert(reinterpret_cast<const char*>(name));
+    }
+  }
+
+  bool core_storage = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 2);
+
+  if (core_storage || has_extension("GL_ARB_texture_storage")) {
+    s.tex_storage_2d = reinterpret_cast<tex_storage_2d_t>(load("glTexStorage2D"));
+    s.tex_storage_3d = reinterpret_cast<tex_storage_3d_t>(load("glTexStorage3D"));
+  }
+
+  bool core_anisotropy = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 6);
+
+  if (core_anisotropy || has_extension("GL_ARB_texture_filter_anisotropic")
+      || has_extension("GL_EXT_texture_filter_anisotropic")) {
+    glGetFloatv(max_texture_max_anisotropy, &s.max_anisotropy);
+  }
+}
+
+// Returns true if the current context supports an extension.
+//
+// Parameters
+// name - name of the extension, i.e. GL_ARB_texture_storage
+bool has_extension(const char* name) {
+  assert(name != NULL);
+
+  return state().names.count(name) != 0;
+}
+
+// Returns the largest anisotropy supported by samplers, 1 if anisotropic filtering is unavailable.
+float max_texture_anisotropy() noexcept {
+  return state().max_anisotropy;
+}
+
+// Returns true if immutable texture storage is available through OpenGL 4.2 or ARB_texture_storage.
+bool has_texture_storage() noexcept {
+  return state().tex_storage_2d != NULL && state().tex_storage_3d != NULL;
+}
+
+// Allocates immutable storage for every level of a 2D texture.  Only valid when has_texture_storage is true.
+//
+// Parameters
+// target - the texture target, i.e. GL_TEXTURE_2D
+// levels - the number of mip levels
+// internal_format - a sized internal format, i.e. GL_SRGB8_ALPHA8
+// width - width of the base level
+// height - height of the base level
+void texture_storage_2d(unsigned int target, int levels, unsigned int internal_format, int width, int height) noexcept {
+  assert(state().tex_storage_2d != NULL);
+
+  state().tex_storage_2d(target, levels, internal_format, width, height);
+}
+
+// Allocates immutable storage for every level of a 3D or array texture.  Only valid when has_texture_storage is
+// true.
+//
+// Parameters
+// target - the texture target, i.e. GL_TEXTURE_2D_ARRAY
+// levels - the number of mip levels
+// internal_format - a sized internal format, i.e. GL_SRGB8_ALPHA8
+// width - width of the base level
+// height - height of the base level
+// depth - depth of the texture or number of array layers
+void texture_storage_3d(unsigned int target, int levels, unsigned int internal_format, int width, int height,
+    int depth) noexcept {
+  assert(state().tex_storage_3d != NULL);
+
+  state().tex_storage_3d(target, levels, internal_format, width, height, depth);
+}
+
+}
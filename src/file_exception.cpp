@@ -0,0 +1,18 @@
+#include "myopengl/file_exception.h"
+
+namespace myopengl {
+
+// Construct a new instance of a file_exception
+//
+// Parameters
+// message - the message to be associated with the exception
+myopengl::file_exception::file_exception(const std::string& message) noexcept
+    : _message(message) {
+}
+
+// Returns the message associated with this exception
+const char* myopengl::file_exception::what() const noexcept {
+  return _message.c_str();
+}
+
+}
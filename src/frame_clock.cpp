@@ -0,0 +1,113 @@
+#include <cassert>
+
+#include "myopengl/frame_clock.h"
+
+namespace myopengl {
+
+// Construct a frame clock, which turns real frame times into a whole number of fixed simulation steps so that
+// simulation behaves the same, and costs the same per second, whatever the frame rate.  Time left over after the
+// steps is carried into the next frame and exposed as alpha, for rendering to interpolate between the last two
+// simulated states.
+//
+// Parameters
+// step - the length of a simulation step in seconds
+// max_steps - the most steps to run for one frame.  Time beyond this is dropped rather than caught up, so a long
+//             frame cannot snowball into ever longer frames
+frame_clock::frame_clock(double step, int max_steps)
+    : _step(step)
+    , _max_steps(max_steps)
+    , _accumulator(0.0)
+    , _steps(0)
+    , _dropped(0.0)
+    , _started(false) {
+  assert(step > 0.0);
+  assert(max_steps > 0);
+}
+
+// Adds the real time elapsed since the previous call.  The first call starts the clock and runs no steps.
+//
+// Returns the number of simulation steps to run this frame
+int frame_clock::advance() {
+  auto now = std::chrono::steady_clock::now();
+
+  if (!_started) {
+    _started = true;
+    _last = now;
+    return 0;
+  }
+
+  std::chrono::duration<double> elapsed = now - _last;
+  _last = now;
+
+  return advance(elapsed.count());
+}
+
+// Adds a length of time, i.e. a fixed frame time when rendering offline or benchmarking.
+//
+// Parameters
+// elapsed - the time to add in seconds
+//
+// Returns the number of simulation steps to run this frame
+int frame_clock::advance(double elapsed) {
+  assert(elapsed >= 0.0);
+
+  _accumulator += elapsed;
+
+  int steps = static_cast<int>(_accumulator / _step);
+  _accumulator -= steps * _step;
+
+  if (steps > _max_steps) {
+    _dropped += (steps - _max_steps) * _step;
+    steps = _max_steps;
+  }
+
+  _steps += steps;
+
+  return steps;
+}
+
+// Restarts the clock, discarding accumulated time.  Call after a pause such as loading so the time spent is not
+// simulated.
+void frame_clock::reset() {
+  _accumulator = 0.0;
+  _started = false;
+}
+
+// Returns the length of a simulation step in seconds.
+double frame_clock::step() const noexcept {
+  return _step;
+}
+
+// Returns how far between the previous and current simulation steps the rendered frame falls, from 0 up to 1.
+double frame_clock::alpha() const noexcept {
+  return _accumulator / _step;
+}
+
+// Returns the simulated time in seconds.
+double frame_clock::time() const noexcept {
+  return _steps * _step;
+}
+
+// Returns the number of simulation steps run.
+uint64_t frame_clock::steps() const noexcept {
+  return _steps;
+}
+
+// Returns the time in seconds dropped because frames took longer than the most steps allowed.
+double frame_clock::dropped() const noexcept {
+  return _dropped;
+}
+
+// Interpolates between the previous and current simulated values of a property for rendering.
+//
+// Parameters
+// previous - the value after the previous step
+// current - the value after the current step
+// alpha - the interpolation factor, from frame_clock::alpha
+//
+// Returns the value to render
+float interpolate(float previous, float current, double alpha) noexcept {
+  return previous + (current - previous) * static_cast<float>(alpha);
+}
+
+}
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include "myopengl/file_exception.h"
+#include "myopengl/frame_pacer.h"
+#include "myopengl/trace.h"
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace myopengl {
+
+namespace {
+
+// A frame counts as a missed deadline when it is presented more than half a period late.
+const double missed_deadline_factor = 1.5;
+
+// Bounds of the time left to spin at the end of a sleep, adapted to how far the operating system oversleeps.
+const std::chrono::microseconds min_sleep_margin(100);
+const std::chrono::microseconds max_sleep_margin(4000);
+
+#ifdef _WIN32
+// Owns a high resolution waitable timer, closing it when destroyed, i.e. when the thread owning it exits.
+class waitable_timer {
+
+  public:
+  waitable_timer() noexcept
+      : _handle(CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS)) {
+  }
+
+  ~waitable_timer() {
+    if (_handle != NULL) {
+      CloseHandle(_handle);
+    }
+  }
+
+  waitable_timer(const waitable_timer&) = delete;
+  waitable_timer& operator=(const waitable_timer&) = delete;
+
+  // Returns the timer, or NULL if a high resolution timer is not available
+  HANDLE handle() const noexcept {
+    return _handle;
+  }
+
+  private:
+  HANDLE _handle;
+};
+#endif
+
+// Sleeps the calling thread for a duration.  On Windows a high resolution waitable timer is used where available,
+// as Sleep is only as precise as the scheduler tick.
+//
+// Parameters
+// duration - the time to sleep for
+void sleep_for(std::chrono::steady_clock::duration duration) {
+#ifdef _WIN32
+  static thread_local waitable_timer owner;
+  HANDLE timer = owner.handle();
+
+  if (timer != NULL) {
+    LARGE_INTEGER due;
+    due.QuadPart = -static_cast<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 100);
+
+    if (SetWaitableTimerEx(timer, &due, 0, NULL, NULL, NULL, 0)) {
+      WaitForSingleObject(timer, INFINITE);
+      return;
+    }
+  }
+#endif
+
+  std::this_thread::sleep_for(duration);
+}
+
+// Writes statistics as a JSON object.
+//
+// Parameters
+// stream - the stream to write to
+// key - the name of the object
+// statistics - the statistics to write
+void write_statistics(std::ostream& stream, const char* key, const frame_statistics& statistics) {
+  stream << "  \"" << key << "\": { \"mean\": " << statistics.mean << ", \"p50\": " << statistics.p50
+         << ", \"p95\": " << statistics.p95 << ", \"p99\": " << statistics.p99 << ", \"max\": " << statistics.max
+         << " },\n";
+}
+
+}
+
+// Construct a frame pacer, which presents frames for a context at a steady rate and measures how steadily they are
+// delivered.  Frames can be limited to a target rate, in addition to any swap interval set on the context.
+//
+// Parameters
+// ctx - the context to present
+// target_fps - the frame rate to limit to, or 0 for no limit
+frame_pacer::frame_pacer(context& ctx, double target_fps)
+    : _context(ctx)
+    , _target_fps(target_fps)
+    , _sleep_margin(std::chrono::microseconds(1000))
+    , _missed_deadlines(0)
+    , _presented(false)
+    , _polled(false) {
+  assert(target_fps >= 0.0);
+}
+
+// Sets the frame rate to limit to.
+//
+// Parameters
+// target_fps - the frame rate, or 0 for no limit
+void frame_pacer::set_target_fps(double target_fps) noexcept {
+  assert(target_fps >= 0.0);
+
+  _target_fps = target_fps;
+  _next_frame = _last_present;
+}
+
+// Processes pending events on the context, marking when input was sampled so the latency to the frame presenting it
+// can be measured.
+void frame_pacer::poll_events() {
+  _context.poll_events();
+
+  _last_poll = std::chrono::steady_clock::now();
+  _polled = true;
+}
+
+// Presents the frame and, when limiting, waits until the next frame is due.  The wait comes after the swap and
+// before the next poll, so input is sampled as late as possible.  The interval since the previous frame and the
+// latency since input was polled are recorded, and a frame more than half a period late counts as a missed deadline.
+void frame_pacer::present() {
+  MYOPENGL_TRACE_SCOPE("frame_pacer::present");
+
+  _context.swap_buffers();
+
+  auto now = std::chrono::steady_clock::now();
+  double period = target_period();
+
+  if (_presented) {
+    std::chrono::duration<double, std::milli> interval = now - _last_present;
+    _intervals.push_back(interval.count());
+
+    if (period > 0.0 && interval.count() > period * 1000.0 * missed_deadline_factor) {
+      ++_missed_deadlines;
+    }
+  } else {
+    _next_frame = now;
+  }
+
+  if (_polled) {
+    std::chrono::duration<double, std::milli> latency = now - _last_poll;
+    _latencies.push_back(latency.count());
+    _polled = false;
+  }
+
+  _last_present = now;
+  _presented = true;
+
+  if (_target_fps <= 0.0) {
+    return;
+  }
+
+  std::chrono::duration<double> frame_time(1.0 / _target_fps);
+  _next_frame += std::chrono::duration_cast<std::chrono::steady_clock::duration>(frame_time);
+
+  if (_next_frame <= now) {
+    _next_frame = now;
+    return;
+  }
+
+  sleep_until(_next_frame);
+}
+
+// Calculates statistics for every frame presented.
+//
+// Returns the statistics
+frame_pacing_statistics frame_pacer::statistics() const {
+  frame_pacing_statistics result;
+  result.frames = static_cast<unsigned int>(_intervals.size());
+  result.target_ms = target_period() * 1000.0;
+  result.interval_ms = summarise(_intervals);
+  result.missed_deadlines = _missed_deadlines;
+  result.latency_ms = summarise(_latencies);
+
+  double variance = 0.0;
+
+  for (double interval : _intervals) {
+    variance += (interval - result.interval_ms.mean) * (interval - result.interval_ms.mean);
+  }
+
+  result.interval_stddev_ms = _intervals.empty() ? 0.0 : std::sqrt(variance / _intervals.size());
+
+  return result;
+}
+
+// Writes pacing statistics as JSON.
+//
+// Parameters
+// stream - the stream to write to
+void frame_pacer::write_json(std::ostream& stream) const {
+  frame_pacing_statistics s = statistics();
+
+  stream << "{\n";
+  stream << "  \"frames\": " << s.frames << ",\n";
+  stream << "  \"target_ms\": " << s.target_ms << ",\n";
+  write_statistics(stream, "interval_ms", s.interval_ms);
+  stream << "  \"interval_stddev_ms\": " << s.interval_stddev_ms << ",\n";
+  write_statistics(stream, "latency_ms", s.latency_ms);
+  stream << "  \"missed_deadlines\": " << s.missed_deadlines << "\n";
+  stream << "}\n";
+}
+
+// Writes pacing statistics as JSON to a file.
+//
+// Parameters
+// path - path on the filesystem to write to
+//
+// Throws
+// file_exception - if the file could not be written
+void frame_pacer::write_json(const std::string& path) const {
+  std::ofstream file(path);
+
+  if (!file) {
+    throw file_exception("Unable to open [" + path + "] for writing");
+  }
+
+  write_json(file);
+}
+
+// Returns the period frames are expected to be presented at in seconds, from the target rate or else the rate the
+// context presents at when synchronised to the display, or 0 when neither is known.
+double frame_pacer::target_period() const {
+  if (_target_fps > 0.0) {
+    return 1.0 / _target_fps;
+  }
+
+  double rate = _context.presentation_rate();
+
+  return rate > 0.0 ? 1.0 / rate : 0.0;
+}
+
+// Waits until a point in time by sleeping for most of the wait and spinning for the rest.  The time left to spin is
+// adapted to how far sleeps overshoot, so the wait ends close to the deadline without spinning for all of it.
+//
+// Parameters
+// deadline - the time to wait until
+void frame_pacer::sleep_until(std::chrono::steady_clock::time_point deadline) {
+  auto now = std::chrono::steady_clock::now();
+
+  if (deadline - now > _sleep_margin) {
+    auto requested = deadline - now - _sleep_margin;
+    sleep_for(requested);
+
+    auto after = std::chrono::steady_clock::now();
+    auto overshoot = (after - now) - requested;
+
+    std::chrono::steady_clock::duration margin = std::max(overshoot * 2, _sleep_margin * 15 / 16);
+    _sleep_margin = std::clamp(margin, std::chrono::steady_clock::duration(min_sleep_margin),
+        std::chrono::steady_clock::duration(max_sleep_margin));
+  }
+
+  while (std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+}
+
+}
@@ -0,0 +1,158 @@
+#include <cassert>
+
+#include "myopengl/frame_pipeline.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+// Construct a frame pipeline, which overlaps the update of the next frame with the rendering of the current one.
+// Frame data is held by the caller in one slot per buffer, frame N living in slot N % buffers.  The update of frame
+// N reads the slot of frame N - 1 and writes its own, running as a job while the render thread reads the slot of
+// an earlier frame.  A slot is never written while it is being rendered, so rendering sees an immutable snapshot.
+//
+// With two buffers the update runs at most one frame ahead of rendering.  With three it may run two ahead, absorbing
+// frames where one side takes longer than the other.  Slot 0 must hold the initial state, which is rendered as
+// frame 0, before the first call to begin_frame.
+//
+// Parameters
+// jobs - the job system running updates, constructed on the render thread
+// update - called with the frame number and the slots of the previous and next frames
+// buffers - the number of slots of frame data, 2 or 3
+frame_pipeline::frame_pipeline(job_system& jobs, frame_update_t update, int buffers)
+    : _jobs(jobs)
+    , _update(std::move(update))
+    , _buffers(buffers)
+    , _counters(new job_counter[buffers])
+    , _scheduled(1)
+    , _rendered(0)
+    , _updating(false)
+    , _stopping(false)
+    , _failed(false) {
+  assert(buffers >= 2);
+}
+
+// Deconstructs a frame pipeline, waiting for any update in flight.
+frame_pipeline::~frame_pipeline() {
+  try {
+    finish();
+  } catch (...) {
+  }
+}
+
+// Begins rendering a frame, starting the update of a following frame if a slot is free and waiting until the
+// frame to render has been updated.  Rendering must only read the returned slot.
+//
+// Throws
+// the exception thrown by the update of the frame
+//
+// Returns the slot of the frame to render
+int frame_pipeline::begin_frame() {
+  MYOPENGL_TRACE_SCOPE("frame_pipeline::begin_frame");
+
+  const size_t frame = _rendered;
+
+  while (true) {
+    schedule();
+
+    size_t scheduled = 0;
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      assert(!_stopping);
+      assert(!_failed || _scheduled > frame);
+      scheduled = _scheduled;
+    }
+
+    if (scheduled > frame) {
+      break;
+    }
+
+    _jobs.wait(_counters[(scheduled - 1) % _buffers]);
+  }
+
+  _jobs.wait(_counters[frame % _buffers]);
+
+  return static_cast<int>(frame % _buffers);
+}
+
+// Ends rendering a frame, releasing its slot to be written by a later update.
+void frame_pipeline::end_frame() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_rendered;
+  }
+
+  schedule();
+}
+
+// Stops starting updates and waits for any in flight.  Frame data may be released once this returns.
+//
+// Throws
+// the exception thrown by an update which has not been rendered
+void frame_pipeline::finish() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+
+  for (int i = 0; i < _buffers; ++i) {
+    _jobs.wait(_counters[i]);
+  }
+}
+
+// Returns the number of slots of frame data.
+int frame_pipeline::buffers() const noexcept {
+  return _buffers;
+}
+
+// Returns the number of the frame being rendered, or to be rendered next.
+size_t frame_pipeline::frame() const noexcept {
+  return _rendered;
+}
+
+// Starts the update of the next frame unless one is in flight or its slot has not finished rendering.  Called from
+// the render thread and from updates as they finish, so updates run back to back while slots are free.
+void frame_pipeline::schedule() {
+  size_t frame = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_updating || _stopping || _failed || _scheduled >= _rendered + _buffers) {
+      return;
+    }
+
+    _updating = true;
+    frame = _scheduled++;
+  }
+
+  _jobs.run([this, frame]() {
+    update(frame);
+  }, &_counters[frame % _buffers]);
+}
+
+// Updates a frame on a job thread and starts the update of the next.
+//
+// Parameters
+// frame - the number of the frame to update
+void frame_pipeline::update(size_t frame) {
+  MYOPENGL_TRACE_SCOPE("frame_pipeline::update");
+
+  try {
+    _update(frame, static_cast<int>((frame - 1) % _buffers), static_cast<int>(frame % _buffers));
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _updating = false;
+    _failed = true;
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _updating = false;
+  }
+
+  schedule();
+}
+
+}
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+
+#include <glad/glad.h>
+
+#include "myopengl/file_exception.h"
+#include "myopengl/frame_recorder.h"
+#include "myopengl/gl_intercept.h"
+
+namespace myopengl {
+
+namespace {
+
+thread_local unsigned int draw_calls_total = 0;
+thread_local unsigned int state_changes_total = 0;
+
+// Returns the value at a percentile of sorted values using the nearest rank method.
+//
+// Parameters
+// sorted - the values in ascending order
+// percentile - the percentile, between 0 and 1
+double nearest_rank(const std::vector<double>& sorted, double percentile) {
+  size_t rank = static_cast<size_t>(std::ceil(percentile * sorted.size()));
+
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+// Writes statistics as a JSON object.
+//
+// Parameters
+// stream - the stream to write to
+// key - the name of the object
+// statistics - the statistics to write
+// last - true if no member follows the object
+void write_statistics(std::ostream& stream, const char* key, const frame_statistics& statistics, bool last) {
+  stream << "  \"" << key << "\": { \"mean\": " << statistics.mean << ", \"p50\": " << statistics.p50
+         << ", \"p95\": " << statistics.p95 << ", \"p99\": " << statistics.p99 << ", \"max\": " << statistics.max
+         << " }" << (last ? "\n" : ",\n");
+}
+
+}
+
+// Counts draw calls towards the frame being recorded on the calling thread.
+//
+// Parameters
+// count - the number of draw calls issued
+void record_draw_call(unsigned int count) noexcept {
+  draw_calls_total += count;
+}
+
+// Counts changes of OpenGL state, such as program or sampler binds, towards the frame being recorded on the calling
+// thread.
+//
+// Parameters
+// count - the number of state changes made
+void record_state_change(unsigned int count) noexcept {
+  state_changes_total += count;
+}
+
+// Calculates the mean, percentiles and maximum of a set of values.
+//
+// Parameters
+// values - the values to summarise
+//
+// Returns the statistics, all zero if there are no values
+frame_statistics summarise(std::vector<double> values) {
+  frame_statistics statistics;
+
+  if (values.empty()) {
+    return statistics;
+  }
+
+  std::sort(values.begin(), values.end());
+
+  double total = 0.0;
+
+  for (double value : values) {
+    total += value;
+  }
+
+  statistics.mean = total / values.size();
+  statistics.p50 = nearest_rank(values, 0.50);
+  statistics.p95 = nearest_rank(values, 0.95);
+  statistics.p99 = nearest_rank(values, 0.99);
+  statistics.max = values.back();
+
+  return statistics;
+}
+
+// Construct a frame recorder.  Each frame is timed on the CPU with a steady clock and on the GPU with a
+// GL_TIME_ELAPSED query, whose result is read back several frames later so recording does not stall the pipeline.
+//
+// Parameters
+// name - the name written with the results, i.e. the example being measured
+// query_latency - the number of frames a query result may lag behind before the recorder waits for it
+frame_recorder::frame_recorder(const std::string& name, int query_latency)
+    : _name(name)
+    , _queries(query_latency + 1)
+    , _query_frames(query_latency + 1)
+    , _next_query(0)
+    , _pending(0)
+    , _draw_calls(0)
+    , _state_changes(0)
+    , _in_frame(false) {
+  assert(query_latency >= 0);
+
+  glGenQueries(static_cast<int>(_queries.size()), _queries.data());
+}
+
+// Deconstructs a frame recorder, releasing its queries.
+frame_recorder::~frame_recorder() {
+  glDeleteQueries(static_cast<int>(_queries.size()), _queries.data());
+}
+
+// Starts recording a frame.  Results of earlier frames which are ready are collected first, waiting only when every
+// query is still in flight.
+void frame_recorder::begin_frame() {
+  assert(!_in_frame);
+
+  while (read_oldest(false)) {
+  }
+
+  if (_pending == _queries.size()) {
+    read_oldest(true);
+  }
+
+  _query_frames[_next_query] = _samples.size();
+  glBeginQuery(GL_TIME_ELAPSED, _queries[_next_query]);
+
+  _draw_calls = draw_calls_total;
+  _state_changes = state_changes_total;
+  reset_gl_call_counts();
+  _frame_start = std::chrono::steady_clock::now();
+  _in_frame = true;
+}
+
+// Ends recording a frame.  Call after the buffers have been swapped so the CPU time includes any wait in the swap.
+// When OpenGL calls are intercepted, the calls made during the frame are added to the totals of each function.
+void frame_recorder::end_frame() {
+  assert(_in_frame);
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - _frame_start;
+
+  frame_sample sample;
+  sample.cpu_ms = elapsed.count();
+  sample.draw_calls = draw_calls_total - _draw_calls;
+  sample.state_changes = state_changes_total - _state_changes;
+
+  _samples.push_back(sample);
+
+  for (const gl_call_count& count : gl_call_counts()) {
+    auto total = std::find_if(_gl_calls.begin(), _gl_calls.end(), [&count](const call_total& t) {
+      return t.name == count.name;
+    });
+
+    if (total == _gl_calls.end()) {
+      _gl_calls.push_back(call_total { count.name, 0, 0.0 });
+      total = _gl_calls.end() - 1;
+    }
+
+    total->calls += count.calls;
+    total->ms += count.ms;
+  }
+
+  glEndQuery(GL_TIME_ELAPSED);
+
+  _next_query = (_next_query + 1) % _queries.size();
+  ++_pending;
+  _in_frame = false;
+}
+
+// Waits for the GPU times of every recorded frame.  Call before reading the samples.
+void frame_recorder::finish() {
+  assert(!_in_frame);
+
+  while (_pending > 0) {
+    read_oldest(true);
+  }
+}
+
+// Returns the frames recorded so far.  GPU times are zero until their query has been read back.
+const std::vector<frame_sample>& frame_recorder::samples() const noexcept {
+  return _samples;
+}
+
+// Writes statistics for every recorded frame as JSON.  When OpenGL calls are intercepted, the average number of
+// calls to each function per frame, and the time spent in them if timed, are included.
+//
+// Parameters
+// stream - the stream to write to
+void frame_recorder::write_json(std::ostream& stream) const {
+  std::vector<double> cpu;
+  std::vector<double> gpu;
+  std::vector<double> draw_calls;
+  std::vector<double> state_changes;
+
+  for (const frame_sample& sample : _samples) {
+    cpu.push_back(sample.cpu_ms);
+    gpu.push_back(sample.gpu_ms);
+    draw_calls.push_back(sample.draw_calls);
+    state_changes.push_back(sample.state_changes);
+  }
+
+  std::string name;
+
+  for (char c : _name) {
+    if (c == '"' || c == '\\') {
+      name += '\\';
+    }
+
+    name += c;
+  }
+
+  stream << "{\n";
+  stream << "  \"name\": \"" << name << "\",\n";
+  stream << "  \"frames\": " << _samples.size() << ",\n";
+  write_statistics(stream, "cpu_ms", summarise(cpu), false);
+  write_statistics(stream, "gpu_ms", summarise(gpu), false);
+  write_statistics(stream, "draw_calls", summarise(draw_calls), false);
+  write_statistics(stream, "state_changes", summarise(state_changes), !gl_interception_enabled());
+
+  if (gl_interception_enabled()) {
+    double frames = _samples.empty() ? 1.0 : static_cast<double>(_samples.size());
+    std::vector<call_total> totals = _gl_calls;
+
+    std::stable_sort(totals.begin(), totals.end(), [](const call_total& a, const call_total& b) {
+      return a.calls > b.calls;
+    });
+
+    stream << "  \"gl_calls\": {";
+
+    for (size_t i = 0; i < totals.size(); ++i) {
+      stream << (i == 0 ? "\n" : ",\n") << "    \"" << totals[i].name << "\": { \"calls\": " << totals[i].calls / frames
+             << ", \"ms\": " << totals[i].ms / frames << " }";
+    }
+
+    stream << (totals.empty() ? "}\n" : "\n  }\n");
+  }
+
+  stream << "}\n";
+}
+
+// Writes statistics for every recorded frame as JSON to a file.
+//
+// Parameters
+// path - path on the filesystem to write to
+//
+// Throws
+// file_exception - if the file could not be written
+void frame_recorder::write_json(const std::string& path) const {
+  std::ofstream file(path);
+
+  if (!file) {
+    throw file_exception("Unable to open [" + path + "] for writing");
+  }
+
+  write_json(file);
+
+  if (!file) {
+    throw file_exception("Unable to write [" + path + "]");
+  }
+}
+
+// Reads back the result of the oldest query in flight.
+//
+// Parameters
+// wait - true to wait for the result, false to return if it is not yet available
+//
+// Returns true if a result was read
+bool frame_recorder::read_oldest(bool wait) {
+  if (_pending == 0) {
+    return false;
+  }
+
+  size_t oldest = (_next_query + _queries.size() - _pending) % _queries.size();
+  unsigned int query = _queries[oldest];
+
+  if (!wait) {
+    int available = 0;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (!available) {
+      return false;
+    }
+  }
+
+  GLuint64 elapsed = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+
+  _samples[_query_frames[oldest]].gpu_ms = static_cast<double>(elapsed) / 1000000.0;
+  --_pending;
+
+  return true;
+}
+
+}
@@ -0,0 +1,381 @@
+// OpenGL functions loaded by glad, one entry per function in the order of include/glad/glad.h.  Define
+// MYOPENGL_GL_FUNCTION(name, type) before including.  Regenerate after updating glad with
+//
+//   sed -n 's/^#define \(gl[A-Z][A-Za-z0-9_]*\) glad_\1$/\1/p' include/glad/glad.h
+//
+// giving each name its PFN<NAME>PROC type.
+
+MYOPENGL_GL_FUNCTION(glCullFace, PFNGLCULLFACEPROC)
+MYOPENGL_GL_FUNCTION(glFrontFace, PFNGLFRONTFACEPROC)
+MYOPENGL_GL_FUNCTION(glHint, PFNGLHINTPROC)
+MYOPENGL_GL_FUNCTION(glLineWidth, PFNGLLINEWIDTHPROC)
+MYOPENGL_GL_FUNCTION(glPointSize, PFNGLPOINTSIZEPROC)
+MYOPENGL_GL_FUNCTION(glPolygonMode, PFNGLPOLYGONMODEPROC)
+MYOPENGL_GL_FUNCTION(glScissor, PFNGLSCISSORPROC)
+MYOPENGL_GL_FUNCTION(glTexParameterf, PFNGLTEXPARAMETERFPROC)
+MYOPENGL_GL_FUNCTION(glTexParameterfv, PFNGLTEXPARAMETERFVPROC)
+MYOPENGL_GL_FUNCTION(glTexParameteri, PFNGLTEXPARAMETERIPROC)
+MYOPENGL_GL_FUNCTION(glTexParameteriv, PFNGLTEXPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glTexImage1D, PFNGLTEXIMAGE1DPROC)
+MYOPENGL_GL_FUNCTION(glTexImage2D, PFNGLTEXIMAGE2DPROC)
+MYOPENGL_GL_FUNCTION(glDrawBuffer, PFNGLDRAWBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glClear, PFNGLCLEARPROC)
+MYOPENGL_GL_FUNCTION(glClearColor, PFNGLCLEARCOLORPROC)
+MYOPENGL_GL_FUNCTION(glClearStencil, PFNGLCLEARSTENCILPROC)
+MYOPENGL_GL_FUNCTION(glClearDepth, PFNGLCLEARDEPTHPROC)
+MYOPENGL_GL_FUNCTION(glStencilMask, PFNGLSTENCILMASKPROC)
+MYOPENGL_GL_FUNCTION(glColorMask, PFNGLCOLORMASKPROC)
+MYOPENGL_GL_FUNCTION(glDepthMask, PFNGLDEPTHMASKPROC)
+MYOPENGL_GL_FUNCTION(glDisable, PFNGLDISABLEPROC)
+MYOPENGL_GL_FUNCTION(glEnable, PFNGLENABLEPROC)
+MYOPENGL_GL_FUNCTION(glFinish, PFNGLFINISHPROC)
+MYOPENGL_GL_FUNCTION(glFlush, PFNGLFLUSHPROC)
+MYOPENGL_GL_FUNCTION(glBlendFunc, PFNGLBLENDFUNCPROC)
+MYOPENGL_GL_FUNCTION(glLogicOp, PFNGLLOGICOPPROC)
+MYOPENGL_GL_FUNCTION(glStencilFunc, PFNGLSTENCILFUNCPROC)
+MYOPENGL_GL_FUNCTION(glStencilOp, PFNGLSTENCILOPPROC)
+MYOPENGL_GL_FUNCTION(glDepthFunc, PFNGLDEPTHFUNCPROC)
+MYOPENGL_GL_FUNCTION(glPixelStoref, PFNGLPIXELSTOREFPROC)
+MYOPENGL_GL_FUNCTION(glPixelStorei, PFNGLPIXELSTOREIPROC)
+MYOPENGL_GL_FUNCTION(glReadBuffer, PFNGLREADBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glReadPixels, PFNGLREADPIXELSPROC)
+MYOPENGL_GL_FUNCTION(glGetBooleanv, PFNGLGETBOOLEANVPROC)
+MYOPENGL_GL_FUNCTION(glGetDoublev, PFNGLGETDOUBLEVPROC)
+MYOPENGL_GL_FUNCTION(glGetError, PFNGLGETERRORPROC)
+MYOPENGL_GL_FUNCTION(glGetFloatv, PFNGLGETFLOATVPROC)
+MYOPENGL_GL_FUNCTION(glGetIntegerv, PFNGLGETINTEGERVPROC)
+MYOPENGL_GL_FUNCTION(glGetString, PFNGLGETSTRINGPROC)
+MYOPENGL_GL_FUNCTION(glGetTexImage, PFNGLGETTEXIMAGEPROC)
+MYOPENGL_GL_FUNCTION(glGetTexParameterfv, PFNGLGETTEXPARAMETERFVPROC)
+MYOPENGL_GL_FUNCTION(glGetTexParameteriv, PFNGLGETTEXPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glGetTexLevelParameterfv, PFNGLGETTEXLEVELPARAMETERFVPROC)
+MYOPENGL_GL_FUNCTION(glGetTexLevelParameteriv, PFNGLGETTEXLEVELPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glIsEnabled, PFNGLISENABLEDPROC)
+MYOPENGL_GL_FUNCTION(glDepthRange, PFNGLDEPTHRANGEPROC)
+MYOPENGL_GL_FUNCTION(glViewport, PFNGLVIEWPORTPROC)
+MYOPENGL_GL_FUNCTION(glDrawArrays, PFNGLDRAWARRAYSPROC)
+MYOPENGL_GL_FUNCTION(glDrawElements, PFNGLDRAWELEMENTSPROC)
+MYOPENGL_GL_FUNCTION(glPolygonOffset, PFNGLPOLYGONOFFSETPROC)
+MYOPENGL_GL_FUNCTION(glCopyTexImage1D, PFNGLCOPYTEXIMAGE1DPROC)
+MYOPENGL_GL_FUNCTION(glCopyTexImage2D, PFNGLCOPYTEXIMAGE2DPROC)
+MYOPENGL_GL_FUNCTION(glCopyTexSubImage1D, PFNGLCOPYTEXSUBIMAGE1DPROC)
+MYOPENGL_GL_FUNCTION(glCopyTexSubImage2D, PFNGLCOPYTEXSUBIMAGE2DPROC)
+MYOPENGL_GL_FUNCTION(glTexSubImage1D, PFNGLTEXSUBIMAGE1DPROC)
+MYOPENGL_GL_FUNCTION(glTexSubImage2D, PFNGLTEXSUBIMAGE2DPROC)
+MYOPENGL_GL_FUNCTION(glBindTexture, PFNGLBINDTEXTUREPROC)
+MYOPENGL_GL_FUNCTION(glDeleteTextures, PFNGLDELETETEXTURESPROC)
+MYOPENGL_GL_FUNCTION(glGenTextures, PFNGLGENTEXTURESPROC)
+MYOPENGL_GL_FUNCTION(glIsTexture, PFNGLISTEXTUREPROC)
+MYOPENGL_GL_FUNCTION(glDrawRangeElements, PFNGLDRAWRANGEELEMENTSPROC)
+MYOPENGL_GL_FUNCTION(glTexImage3D, PFNGLTEXIMAGE3DPROC)
+MYOPENGL_GL_FUNCTION(glTexSubImage3D, PFNGLTEXSUBIMAGE3DPROC)
+MYOPENGL_GL_FUNCTION(glCopyTexSubImage3D, PFNGLCOPYTEXSUBIMAGE3DPROC)
+MYOPENGL_GL_FUNCTION(glActiveTexture, PFNGLACTIVETEXTUREPROC)
+MYOPENGL_GL_FUNCTION(glSampleCoverage, PFNGLSAMPLECOVERAGEPROC)
+MYOPENGL_GL_FUNCTION(glCompressedTexImage3D, PFNGLCOMPRESSEDTEXIMAGE3DPROC)
+MYOPENGL_GL_FUNCTION(glCompressedTexImage2D, PFNGLCOMPRESSEDTEXIMAGE2DPROC)
+MYOPENGL_GL_FUNCTION(glCompressedTexImage1D, PFNGLCOMPRESSEDTEXIMAGE1DPROC)
+MYOPENGL_GL_FUNCTION(glCompressedTexSubImage3D, PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC)
+MYOPENGL_GL_FUNCTION(glCompressedTexSubImage2D, PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)
+MYOPENGL_GL_FUNCTION(glCompressedTexSubImage1D, PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC)
+MYOPENGL_GL_FUNCTION(glGetCompressedTexImage, PFNGLGETCOMPRESSEDTEXIMAGEPROC)
+MYOPENGL_GL_FUNCTION(glBlendFuncSeparate, PFNGLBLENDFUNCSEPARATEPROC)
+MYOPENGL_GL_FUNCTION(glMultiDrawArrays, PFNGLMULTIDRAWARRAYSPROC)
+MYOPENGL_GL_FUNCTION(glMultiDrawElements, PFNGLMULTIDRAWELEMENTSPROC)
+MYOPENGL_GL_FUNCTION(glPointParameterf, PFNGLPOINTPARAMETERFPROC)
+MYOPENGL_GL_FUNCTION(glPointParameterfv, PFNGLPOINTPARAMETERFVPROC)
+MYOPENGL_GL_FUNCTION(glPointParameteri, PFNGLPOINTPARAMETERIPROC)
+MYOPENGL_GL_FUNCTION(glPointParameteriv, PFNGLPOINTPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glBlendColor, PFNGLBLENDCOLORPROC)
+MYOPENGL_GL_FUNCTION(glBlendEquation, PFNGLBLENDEQUATIONPROC)
+MYOPENGL_GL_FUNCTION(glGenQueries, PFNGLGENQUERIESPROC)
+MYOPENGL_GL_FUNCTION(glDeleteQueries, PFNGLDELETEQUERIESPROC)
+MYOPENGL_GL_FUNCTION(glIsQuery, PFNGLISQUERYPROC)
+MYOPENGL_GL_FUNCTION(glBeginQuery, PFNGLBEGINQUERYPROC)
+MYOPENGL_GL_FUNCTION(glEndQuery, PFNGLENDQUERYPROC)
+MYOPENGL_GL_FUNCTION(glGetQueryiv, PFNGLGETQUERYIVPROC)
+MYOPENGL_GL_FUNCTION(glGetQueryObjectiv, PFNGLGETQUERYOBJECTIVPROC)
+MYOPENGL_GL_FUNCTION(glGetQueryObjectuiv, PFNGLGETQUERYOBJECTUIVPROC)
+MYOPENGL_GL_FUNCTION(glBindBuffer, PFNGLBINDBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glDeleteBuffers, PFNGLDELETEBUFFERSPROC)
+MYOPENGL_GL_FUNCTION(glGenBuffers, PFNGLGENBUFFERSPROC)
+MYOPENGL_GL_FUNCTION(glIsBuffer, PFNGLISBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glBufferData, PFNGLBUFFERDATAPROC)
+MYOPENGL_GL_FUNCTION(glBufferSubData, PFNGLBUFFERSUBDATAPROC)
+MYOPENGL_GL_FUNCTION(glGetBufferSubData, PFNGLGETBUFFERSUBDATAPROC)
+MYOPENGL_GL_FUNCTION(glMapBuffer, PFNGLMAPBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glUnmapBuffer, PFNGLUNMAPBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glGetBufferParameteriv, PFNGLGETBUFFERPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glGetBufferPointerv, PFNGLGETBUFFERPOINTERVPROC)
+MYOPENGL_GL_FUNCTION(glBlendEquationSeparate, PFNGLBLENDEQUATIONSEPARATEPROC)
+MYOPENGL_GL_FUNCTION(glDrawBuffers, PFNGLDRAWBUFFERSPROC)
+MYOPENGL_GL_FUNCTION(glStencilOpSeparate, PFNGLSTENCILOPSEPARATEPROC)
+MYOPENGL_GL_FUNCTION(glStencilFuncSeparate, PFNGLSTENCILFUNCSEPARATEPROC)
+MYOPENGL_GL_FUNCTION(glStencilMaskSeparate, PFNGLSTENCILMASKSEPARATEPROC)
+MYOPENGL_GL_FUNCTION(glAttachShader, PFNGLATTACHSHADERPROC)
+MYOPENGL_GL_FUNCTION(glBindAttribLocation, PFNGLBINDATTRIBLOCATIONPROC)
+MYOPENGL_GL_FUNCTION(glCompileShader, PFNGLCOMPILESHADERPROC)
+MYOPENGL_GL_FUNCTION(glCreateProgram, PFNGLCREATEPROGRAMPROC)
+MYOPENGL_GL_FUNCTION(glCreateShader, PFNGLCREATESHADERPROC)
+MYOPENGL_GL_FUNCTION(glDeleteProgram, PFNGLDELETEPROGRAMPROC)
+MYOPENGL_GL_FUNCTION(glDeleteShader, PFNGLDELETESHADERPROC)
+MYOPENGL_GL_FUNCTION(glDetachShader, PFNGLDETACHSHADERPROC)
+MYOPENGL_GL_FUNCTION(glDisableVertexAttribArray, PFNGLDISABLEVERTEXATTRIBARRAYPROC)
+MYOPENGL_GL_FUNCTION(glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC)
+MYOPENGL_GL_FUNCTION(glGetActiveAttrib, PFNGLGETACTIVEATTRIBPROC)
+MYOPENGL_GL_FUNCTION(glGetActiveUniform, PFNGLGETACTIVEUNIFORMPROC)
+MYOPENGL_GL_FUNCTION(glGetAttachedShaders, PFNGLGETATTACHEDSHADERSPROC)
+MYOPENGL_GL_FUNCTION(glGetAttribLocation, PFNGLGETATTRIBLOCATIONPROC)
+MYOPENGL_GL_FUNCTION(glGetProgramiv, PFNGLGETPROGRAMIVPROC)
+MYOPENGL_GL_FUNCTION(glGetProgramInfoLog, PFNGLGETPROGRAMINFOLOGPROC)
+MYOPENGL_GL_FUNCTION(glGetShaderiv, PFNGLGETSHADERIVPROC)
+MYOPENGL_GL_FUNCTION(glGetShaderInfoLog, PFNGLGETSHADERINFOLOGPROC)
+MYOPENGL_GL_FUNCTION(glGetShaderSource, PFNGLGETSHADERSOURCEPROC)
+MYOPENGL_GL_FUNCTION(glGetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC)
+MYOPENGL_GL_FUNCTION(glGetUniformfv, PFNGLGETUNIFORMFVPROC)
+MYOPENGL_GL_FUNCTION(glGetUniformiv, PFNGLGETUNIFORMIVPROC)
+MYOPENGL_GL_FUNCTION(glGetVertexAttribdv, PFNGLGETVERTEXATTRIBDVPROC)
+MYOPENGL_GL_FUNCTION(glGetVertexAttribfv, PFNGLGETVERTEXATTRIBFVPROC)
+MYOPENGL_GL_FUNCTION(glGetVertexAttribiv, PFNGLGETVERTEXATTRIBIVPROC)
+MYOPENGL_GL_FUNCTION(glGetVertexAttribPointerv, PFNGLGETVERTEXATTRIBPOINTERVPROC)
+MYOPENGL_GL_FUNCTION(glIsProgram, PFNGLISPROGRAMPROC)
+MYOPENGL_GL_FUNCTION(glIsShader, PFNGLISSHADERPROC)
+MYOPENGL_GL_FUNCTION(glLinkProgram, PFNGLLINKPROGRAMPROC)
+MYOPENGL_GL_FUNCTION(glShaderSource, PFNGLSHADERSOURCEPROC)
+MYOPENGL_GL_FUNCTION(glUseProgram, PFNGLUSEPROGRAMPROC)
+MYOPENGL_GL_FUNCTION(glUniform1f, PFNGLUNIFORM1FPROC)
+MYOPENGL_GL_FUNCTION(glUniform2f, PFNGLUNIFORM2FPROC)
+MYOPENGL_GL_FUNCTION(glUniform3f, PFNGLUNIFORM3FPROC)
+MYOPENGL_GL_FUNCTION(glUniform4f, PFNGLUNIFORM4FPROC)
+MYOPENGL_GL_FUNCTION(glUniform1i, PFNGLUNIFORM1IPROC)
+MYOPENGL_GL_FUNCTION(glUniform2i, PFNGLUNIFORM2IPROC)
+MYOPENGL_GL_FUNCTION(glUniform3i, PFNGLUNIFORM3IPROC)
+MYOPENGL_GL_FUNCTION(glUniform4i, PFNGLUNIFORM4IPROC)
+MYOPENGL_GL_FUNCTION(glUniform1fv, PFNGLUNIFORM1FVPROC)
+MYOPENGL_GL_FUNCTION(glUniform2fv, PFNGLUNIFORM2FVPROC)
+MYOPENGL_GL_FUNCTION(glUniform3fv, PFNGLUNIFORM3FVPROC)
+MYOPENGL_GL_FUNCTION(glUniform4fv, PFNGLUNIFORM4FVPROC)
+MYOPENGL_GL_FUNCTION(glUniform1iv, PFNGLUNIFORM1IVPROC)
+MYOPENGL_GL_FUNCTION(glUniform2iv, PFNGLUNIFORM2IVPROC)
+MYOPENGL_GL_FUNCTION(glUniform3iv, PFNGLUNIFORM3IVPROC)
+MYOPENGL_GL_FUNCTION(glUniform4iv, PFNGLUNIFORM4IVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix2fv, PFNGLUNIFORMMATRIX2FVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix3fv, PFNGLUNIFORMMATRIX3FVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC)
+MYOPENGL_GL_FUNCTION(glValidateProgram, PFNGLVALIDATEPROGRAMPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib1d, PFNGLVERTEXATTRIB1DPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib1dv, PFNGLVERTEXATTRIB1DVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib1f, PFNGLVERTEXATTRIB1FPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib1fv, PFNGLVERTEXATTRIB1FVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib1s, PFNGLVERTEXATTRIB1SPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib1sv, PFNGLVERTEXATTRIB1SVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib2d, PFNGLVERTEXATTRIB2DPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib2dv, PFNGLVERTEXATTRIB2DVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib2f, PFNGLVERTEXATTRIB2FPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib2fv, PFNGLVERTEXATTRIB2FVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib2s, PFNGLVERTEXATTRIB2SPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib2sv, PFNGLVERTEXATTRIB2SVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib3d, PFNGLVERTEXATTRIB3DPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib3dv, PFNGLVERTEXATTRIB3DVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib3f, PFNGLVERTEXATTRIB3FPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib3fv, PFNGLVERTEXATTRIB3FVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib3s, PFNGLVERTEXATTRIB3SPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib3sv, PFNGLVERTEXATTRIB3SVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4Nbv, PFNGLVERTEXATTRIB4NBVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4Niv, PFNGLVERTEXATTRIB4NIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4Nsv, PFNGLVERTEXATTRIB4NSVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4Nub, PFNGLVERTEXATTRIB4NUBPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4Nubv, PFNGLVERTEXATTRIB4NUBVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4Nuiv, PFNGLVERTEXATTRIB4NUIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4Nusv, PFNGLVERTEXATTRIB4NUSVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4bv, PFNGLVERTEXATTRIB4BVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4d, PFNGLVERTEXATTRIB4DPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4dv, PFNGLVERTEXATTRIB4DVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4f, PFNGLVERTEXATTRIB4FPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4fv, PFNGLVERTEXATTRIB4FVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4iv, PFNGLVERTEXATTRIB4IVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4s, PFNGLVERTEXATTRIB4SPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4sv, PFNGLVERTEXATTRIB4SVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4ubv, PFNGLVERTEXATTRIB4UBVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4uiv, PFNGLVERTEXATTRIB4UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttrib4usv, PFNGLVERTEXATTRIB4USVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix2x3fv, PFNGLUNIFORMMATRIX2X3FVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix3x2fv, PFNGLUNIFORMMATRIX3X2FVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix2x4fv, PFNGLUNIFORMMATRIX2X4FVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix4x2fv, PFNGLUNIFORMMATRIX4X2FVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix3x4fv, PFNGLUNIFORMMATRIX3X4FVPROC)
+MYOPENGL_GL_FUNCTION(glUniformMatrix4x3fv, PFNGLUNIFORMMATRIX4X3FVPROC)
+MYOPENGL_GL_FUNCTION(glColorMaski, PFNGLCOLORMASKIPROC)
+MYOPENGL_GL_FUNCTION(glGetBooleani_v, PFNGLGETBOOLEANI_VPROC)
+MYOPENGL_GL_FUNCTION(glGetIntegeri_v, PFNGLGETINTEGERI_VPROC)
+MYOPENGL_GL_FUNCTION(glEnablei, PFNGLENABLEIPROC)
+MYOPENGL_GL_FUNCTION(glDisablei, PFNGLDISABLEIPROC)
+MYOPENGL_GL_FUNCTION(glIsEnabledi, PFNGLISENABLEDIPROC)
+MYOPENGL_GL_FUNCTION(glBeginTransformFeedback, PFNGLBEGINTRANSFORMFEEDBACKPROC)
+MYOPENGL_GL_FUNCTION(glEndTransformFeedback, PFNGLENDTRANSFORMFEEDBACKPROC)
+MYOPENGL_GL_FUNCTION(glBindBufferRange, PFNGLBINDBUFFERRANGEPROC)
+MYOPENGL_GL_FUNCTION(glBindBufferBase, PFNGLBINDBUFFERBASEPROC)
+MYOPENGL_GL_FUNCTION(glTransformFeedbackVaryings, PFNGLTRANSFORMFEEDBACKVARYINGSPROC)
+MYOPENGL_GL_FUNCTION(glGetTransformFeedbackVarying, PFNGLGETTRANSFORMFEEDBACKVARYINGPROC)
+MYOPENGL_GL_FUNCTION(glClampColor, PFNGLCLAMPCOLORPROC)
+MYOPENGL_GL_FUNCTION(glBeginConditionalRender, PFNGLBEGINCONDITIONALRENDERPROC)
+MYOPENGL_GL_FUNCTION(glEndConditionalRender, PFNGLENDCONDITIONALRENDERPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribIPointer, PFNGLVERTEXATTRIBIPOINTERPROC)
+MYOPENGL_GL_FUNCTION(glGetVertexAttribIiv, PFNGLGETVERTEXATTRIBIIVPROC)
+MYOPENGL_GL_FUNCTION(glGetVertexAttribIuiv, PFNGLGETVERTEXATTRIBIUIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI1i, PFNGLVERTEXATTRIBI1IPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI2i, PFNGLVERTEXATTRIBI2IPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI3i, PFNGLVERTEXATTRIBI3IPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4i, PFNGLVERTEXATTRIBI4IPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI1ui, PFNGLVERTEXATTRIBI1UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI2ui, PFNGLVERTEXATTRIBI2UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI3ui, PFNGLVERTEXATTRIBI3UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4ui, PFNGLVERTEXATTRIBI4UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI1iv, PFNGLVERTEXATTRIBI1IVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI2iv, PFNGLVERTEXATTRIBI2IVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI3iv, PFNGLVERTEXATTRIBI3IVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4iv, PFNGLVERTEXATTRIBI4IVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI1uiv, PFNGLVERTEXATTRIBI1UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI2uiv, PFNGLVERTEXATTRIBI2UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI3uiv, PFNGLVERTEXATTRIBI3UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4uiv, PFNGLVERTEXATTRIBI4UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4bv, PFNGLVERTEXATTRIBI4BVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4sv, PFNGLVERTEXATTRIBI4SVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4ubv, PFNGLVERTEXATTRIBI4UBVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribI4usv, PFNGLVERTEXATTRIBI4USVPROC)
+MYOPENGL_GL_FUNCTION(glGetUniformuiv, PFNGLGETUNIFORMUIVPROC)
+MYOPENGL_GL_FUNCTION(glBindFragDataLocation, PFNGLBINDFRAGDATALOCATIONPROC)
+MYOPENGL_GL_FUNCTION(glGetFragDataLocation, PFNGLGETFRAGDATALOCATIONPROC)
+MYOPENGL_GL_FUNCTION(glUniform1ui, PFNGLUNIFORM1UIPROC)
+MYOPENGL_GL_FUNCTION(glUniform2ui, PFNGLUNIFORM2UIPROC)
+MYOPENGL_GL_FUNCTION(glUniform3ui, PFNGLUNIFORM3UIPROC)
+MYOPENGL_GL_FUNCTION(glUniform4ui, PFNGLUNIFORM4UIPROC)
+MYOPENGL_GL_FUNCTION(glUniform1uiv, PFNGLUNIFORM1UIVPROC)
+MYOPENGL_GL_FUNCTION(glUniform2uiv, PFNGLUNIFORM2UIVPROC)
+MYOPENGL_GL_FUNCTION(glUniform3uiv, PFNGLUNIFORM3UIVPROC)
+MYOPENGL_GL_FUNCTION(glUniform4uiv, PFNGLUNIFORM4UIVPROC)
+MYOPENGL_GL_FUNCTION(glTexParameterIiv, PFNGLTEXPARAMETERIIVPROC)
+MYOPENGL_GL_FUNCTION(glTexParameterIuiv, PFNGLTEXPARAMETERIUIVPROC)
+MYOPENGL_GL_FUNCTION(glGetTexParameterIiv, PFNGLGETTEXPARAMETERIIVPROC)
+MYOPENGL_GL_FUNCTION(glGetTexParameterIuiv, PFNGLGETTEXPARAMETERIUIVPROC)
+MYOPENGL_GL_FUNCTION(glClearBufferiv, PFNGLCLEARBUFFERIVPROC)
+MYOPENGL_GL_FUNCTION(glClearBufferuiv, PFNGLCLEARBUFFERUIVPROC)
+MYOPENGL_GL_FUNCTION(glClearBufferfv, PFNGLCLEARBUFFERFVPROC)
+MYOPENGL_GL_FUNCTION(glClearBufferfi, PFNGLCLEARBUFFERFIPROC)
+MYOPENGL_GL_FUNCTION(glGetStringi, PFNGLGETSTRINGIPROC)
+MYOPENGL_GL_FUNCTION(glIsRenderbuffer, PFNGLISRENDERBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glBindRenderbuffer, PFNGLBINDRENDERBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glDeleteRenderbuffers, PFNGLDELETERENDERBUFFERSPROC)
+MYOPENGL_GL_FUNCTION(glGenRenderbuffers, PFNGLGENRENDERBUFFERSPROC)
+MYOPENGL_GL_FUNCTION(glRenderbufferStorage, PFNGLRENDERBUFFERSTORAGEPROC)
+MYOPENGL_GL_FUNCTION(glGetRenderbufferParameteriv, PFNGLGETRENDERBUFFERPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glIsFramebuffer, PFNGLISFRAMEBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glBindFramebuffer, PFNGLBINDFRAMEBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glDeleteFramebuffers, PFNGLDELETEFRAMEBUFFERSPROC)
+MYOPENGL_GL_FUNCTION(glGenFramebuffers, PFNGLGENFRAMEBUFFERSPROC)
+MYOPENGL_GL_FUNCTION(glCheckFramebufferStatus, PFNGLCHECKFRAMEBUFFERSTATUSPROC)
+MYOPENGL_GL_FUNCTION(glFramebufferTexture1D, PFNGLFRAMEBUFFERTEXTURE1DPROC)
+MYOPENGL_GL_FUNCTION(glFramebufferTexture2D, PFNGLFRAMEBUFFERTEXTURE2DPROC)
+MYOPENGL_GL_FUNCTION(glFramebufferTexture3D, PFNGLFRAMEBUFFERTEXTURE3DPROC)
+MYOPENGL_GL_FUNCTION(glFramebufferRenderbuffer, PFNGLFRAMEBUFFERRENDERBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glGetFramebufferAttachmentParameteriv, PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glGenerateMipmap, PFNGLGENERATEMIPMAPPROC)
+MYOPENGL_GL_FUNCTION(glBlitFramebuffer, PFNGLBLITFRAMEBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glRenderbufferStorageMultisample, PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC)
+MYOPENGL_GL_FUNCTION(glFramebufferTextureLayer, PFNGLFRAMEBUFFERTEXTURELAYERPROC)
+MYOPENGL_GL_FUNCTION(glMapBufferRange, PFNGLMAPBUFFERRANGEPROC)
+MYOPENGL_GL_FUNCTION(glFlushMappedBufferRange, PFNGLFLUSHMAPPEDBUFFERRANGEPROC)
+MYOPENGL_GL_FUNCTION(glBindVertexArray, PFNGLBINDVERTEXARRAYPROC)
+MYOPENGL_GL_FUNCTION(glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC)
+MYOPENGL_GL_FUNCTION(glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC)
+MYOPENGL_GL_FUNCTION(glIsVertexArray, PFNGLISVERTEXARRAYPROC)
+MYOPENGL_GL_FUNCTION(glDrawArraysInstanced, PFNGLDRAWARRAYSINSTANCEDPROC)
+MYOPENGL_GL_FUNCTION(glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC)
+MYOPENGL_GL_FUNCTION(glTexBuffer, PFNGLTEXBUFFERPROC)
+MYOPENGL_GL_FUNCTION(glPrimitiveRestartIndex, PFNGLPRIMITIVERESTARTINDEXPROC)
+MYOPENGL_GL_FUNCTION(glCopyBufferSubData, PFNGLCOPYBUFFERSUBDATAPROC)
+MYOPENGL_GL_FUNCTION(glGetUniformIndices, PFNGLGETUNIFORMINDICESPROC)
+MYOPENGL_GL_FUNCTION(glGetActiveUniformsiv, PFNGLGETACTIVEUNIFORMSIVPROC)
+MYOPENGL_GL_FUNCTION(glGetActiveUniformName, PFNGLGETACTIVEUNIFORMNAMEPROC)
+MYOPENGL_GL_FUNCTION(glGetUniformBlockIndex, PFNGLGETUNIFORMBLOCKINDEXPROC)
+MYOPENGL_GL_FUNCTION(glGetActiveUniformBlockiv, PFNGLGETACTIVEUNIFORMBLOCKIVPROC)
+MYOPENGL_GL_FUNCTION(glGetActiveUniformBlockName, PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC)
+MYOPENGL_GL_FUNCTION(glUniformBlockBinding, PFNGLUNIFORMBLOCKBINDINGPROC)
+MYOPENGL_GL_FUNCTION(glDrawElementsBaseVertex, PFNGLDRAWELEMENTSBASEVERTEXPROC)
+MYOPENGL_GL_FUNCTION(glDrawRangeElementsBaseVertex, PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC)
+MYOPENGL_GL_FUNCTION(glDrawElementsInstancedBaseVertex, PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC)
+MYOPENGL_GL_FUNCTION(glMultiDrawElementsBaseVertex, PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC)
+MYOPENGL_GL_FUNCTION(glProvokingVertex, PFNGLPROVOKINGVERTEXPROC)
+MYOPENGL_GL_FUNCTION(glFenceSync, PFNGLFENCESYNCPROC)
+MYOPENGL_GL_FUNCTION(glIsSync, PFNGLISSYNCPROC)
+MYOPENGL_GL_FUNCTION(glDeleteSync, PFNGLDELETESYNCPROC)
+MYOPENGL_GL_FUNCTION(glClientWaitSync, PFNGLCLIENTWAITSYNCPROC)
+MYOPENGL_GL_FUNCTION(glWaitSync, PFNGLWAITSYNCPROC)
+MYOPENGL_GL_FUNCTION(glGetInteger64v, PFNGLGETINTEGER64VPROC)
+MYOPENGL_GL_FUNCTION(glGetSynciv, PFNGLGETSYNCIVPROC)
+MYOPENGL_GL_FUNCTION(glGetInteger64i_v, PFNGLGETINTEGER64I_VPROC)
+MYOPENGL_GL_FUNCTION(glGetBufferParameteri64v, PFNGLGETBUFFERPARAMETERI64VPROC)
+MYOPENGL_GL_FUNCTION(glFramebufferTexture, PFNGLFRAMEBUFFERTEXTUREPROC)
+MYOPENGL_GL_FUNCTION(glTexImage2DMultisample, PFNGLTEXIMAGE2DMULTISAMPLEPROC)
+MYOPENGL_GL_FUNCTION(glTexImage3DMultisample, PFNGLTEXIMAGE3DMULTISAMPLEPROC)
+MYOPENGL_GL_FUNCTION(glGetMultisamplefv, PFNGLGETMULTISAMPLEFVPROC)
+MYOPENGL_GL_FUNCTION(glSampleMaski, PFNGLSAMPLEMASKIPROC)
+MYOPENGL_GL_FUNCTION(glBindFragDataLocationIndexed, PFNGLBINDFRAGDATALOCATIONINDEXEDPROC)
+MYOPENGL_GL_FUNCTION(glGetFragDataIndex, PFNGLGETFRAGDATAINDEXPROC)
+MYOPENGL_GL_FUNCTION(glGenSamplers, PFNGLGENSAMPLERSPROC)
+MYOPENGL_GL_FUNCTION(glDeleteSamplers, PFNGLDELETESAMPLERSPROC)
+MYOPENGL_GL_FUNCTION(glIsSampler, PFNGLISSAMPLERPROC)
+MYOPENGL_GL_FUNCTION(glBindSampler, PFNGLBINDSAMPLERPROC)
+MYOPENGL_GL_FUNCTION(glSamplerParameteri, PFNGLSAMPLERPARAMETERIPROC)
+MYOPENGL_GL_FUNCTION(glSamplerParameteriv, PFNGLSAMPLERPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glSamplerParameterf, PFNGLSAMPLERPARAMETERFPROC)
+MYOPENGL_GL_FUNCTION(glSamplerParameterfv, PFNGLSAMPLERPARAMETERFVPROC)
+MYOPENGL_GL_FUNCTION(glSamplerParameterIiv, PFNGLSAMPLERPARAMETERIIVPROC)
+MYOPENGL_GL_FUNCTION(glSamplerParameterIuiv, PFNGLSAMPLERPARAMETERIUIVPROC)
+MYOPENGL_GL_FUNCTION(glGetSamplerParameteriv, PFNGLGETSAMPLERPARAMETERIVPROC)
+MYOPENGL_GL_FUNCTION(glGetSamplerParameterIiv, PFNGLGETSAMPLERPARAMETERIIVPROC)
+MYOPENGL_GL_FUNCTION(glGetSamplerParameterfv, PFNGLGETSAMPLERPARAMETERFVPROC)
+MYOPENGL_GL_FUNCTION(glGetSamplerParameterIuiv, PFNGLGETSAMPLERPARAMETERIUIVPROC)
+MYOPENGL_GL_FUNCTION(glQueryCounter, PFNGLQUERYCOUNTERPROC)
+MYOPENGL_GL_FUNCTION(glGetQueryObjecti64v, PFNGLGETQUERYOBJECTI64VPROC)
+MYOPENGL_GL_FUNCTION(glGetQueryObjectui64v, PFNGLGETQUERYOBJECTUI64VPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP1ui, PFNGLVERTEXATTRIBP1UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP1uiv, PFNGLVERTEXATTRIBP1UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP2ui, PFNGLVERTEXATTRIBP2UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP2uiv, PFNGLVERTEXATTRIBP2UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP3ui, PFNGLVERTEXATTRIBP3UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP3uiv, PFNGLVERTEXATTRIBP3UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP4ui, PFNGLVERTEXATTRIBP4UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexAttribP4uiv, PFNGLVERTEXATTRIBP4UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexP2ui, PFNGLVERTEXP2UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexP2uiv, PFNGLVERTEXP2UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexP3ui, PFNGLVERTEXP3UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexP3uiv, PFNGLVERTEXP3UIVPROC)
+MYOPENGL_GL_FUNCTION(glVertexP4ui, PFNGLVERTEXP4UIPROC)
+MYOPENGL_GL_FUNCTION(glVertexP4uiv, PFNGLVERTEXP4UIVPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP1ui, PFNGLTEXCOORDP1UIPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP1uiv, PFNGLTEXCOORDP1UIVPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP2ui, PFNGLTEXCOORDP2UIPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP2uiv, PFNGLTEXCOORDP2UIVPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP3ui, PFNGLTEXCOORDP3UIPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP3uiv, PFNGLTEXCOORDP3UIVPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP4ui, PFNGLTEXCOORDP4UIPROC)
+MYOPENGL_GL_FUNCTION(glTexCoordP4uiv, PFNGLTEXCOORDP4UIVPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP1ui, PFNGLMULTITEXCOORDP1UIPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP1uiv, PFNGLMULTITEXCOORDP1UIVPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP2ui, PFNGLMULTITEXCOORDP2UIPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP2uiv, PFNGLMULTITEXCOORDP2UIVPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP3ui, PFNGLMULTITEXCOORDP3UIPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP3uiv, PFNGLMULTITEXCOORDP3UIVPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP4ui, PFNGLMULTITEXCOORDP4UIPROC)
+MYOPENGL_GL_FUNCTION(glMultiTexCoordP4uiv, PFNGLMULTITEXCOORDP4UIVPROC)
+MYOPENGL_GL_FUNCTION(glNormalP3ui, PFNGLNORMALP3UIPROC)
+MYOPENGL_GL_FUNCTION(glNormalP3uiv, PFNGLNORMALP3UIVPROC)
+MYOPENGL_GL_FUNCTION(glColorP3ui, PFNGLCOLORP3UIPROC)
+MYOPENGL_GL_FUNCTION(glColorP3uiv, PFNGLCOLORP3UIVPROC)
+MYOPENGL_GL_FUNCTION(glColorP4ui, PFNGLCOLORP4UIPROC)
+MYOPENGL_GL_FUNCTION(glColorP4uiv, PFNGLCOLORP4UIVPROC)
+MYOPENGL_GL_FUNCTION(glSecondaryColorP3ui, PFNGLSECONDARYCOLORP3UIPROC)
+MYOPENGL_GL_FUNCTION(glSecondaryColorP3uiv, PFNGLSECONDARYCOLORP3UIVPROC)
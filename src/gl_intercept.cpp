@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <glad/glad.h>
+
+#include "myopengl/gl_intercept.h"
+
+namespace myopengl {
+
+namespace {
+
+enum gl_function_id {
+#define MYOPENGL_GL_FUNCTION(name, type) id_##name,
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+  gl_function_count
+};
+
+const char* const function_names[] = {
+#define MYOPENGL_GL_FUNCTION(name, type) #name,
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+};
+
+unsigned int call_counts[gl_function_count];
+int64_t call_ns[gl_function_count];
+bool timing = false;
+
+#ifdef MYOPENGL_GL_INTERCEPT
+
+template <gl_function_id id, typename function_t>
+struct hook;
+
+// Stands in for one OpenGL function, counting each call and optionally timing it before forwarding to the function
+// glad loaded.  One instantiation exists per function, so the original pointer and the counters need no lookup.
+template <gl_function_id id, typename result_t, typename... argument_ts>
+struct hook<id, result_t(APIENTRYP)(argument_ts...)> {
+  typedef result_t(APIENTRYP function_t)(argument_ts...);
+
+  static function_t original;
+
+  static result_t APIENTRY call(argument_ts... arguments) {
+    ++call_counts[id];
+
+    if (!timing) {
+      return original(arguments...);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    if constexpr (std::is_void<result_t>::value) {
+      original(arguments...);
+      call_ns[id]
+          += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    } else {
+      result_t result = original(arguments...);
+      call_ns[id]
+          += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+      return result;
+    }
+  }
+};
+
+template <gl_function_id id, typename result_t, typename... argument_ts>
+typename hook<id, result_t(APIENTRYP)(argument_ts...)>::function_t
+    hook<id, result_t(APIENTRYP)(argument_ts...)>::original
+    = NULL;
+
+// Replaces a function pointer loaded by glad with its hook, remembering the loaded function.  Functions the driver
+// did not provide are left NULL and pointers which are already hooked are left alone.
+//
+// Parameters
+// slot - the glad function pointer
+template <gl_function_id id, typename function_t>
+void install(function_t& slot) {
+  if (slot == NULL || slot == &hook<id, function_t>::call) {
+    return;
+  }
+
+  hook<id, function_t>::original = slot;
+  slot = &hook<id, function_t>::call;
+}
+
+#endif
+
+}
+
+// Returns true if the library was built with MYOPENGL_GL_INTERCEPT, so calls through glad can be counted.
+bool gl_interception_enabled() noexcept {
+#ifdef MYOPENGL_GL_INTERCEPT
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Wraps every function pointer glad has loaded with a hook counting calls to it.  Called by create_context once
+// OpenGL is loaded, and again if glad is reloaded.  Does nothing unless built with MYOPENGL_GL_INTERCEPT.
+void install_gl_interception() noexcept {
+#ifdef MYOPENGL_GL_INTERCEPT
+#define MYOPENGL_GL_FUNCTION(name, type) install<id_##name>(glad_##name);
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+#endif
+}
+
+// Enables or disables timing each intercepted call.  Timing adds two clock reads to every call so is off by
+// default.
+//
+// Parameters
+// enabled - true to time calls
+void set_gl_call_timing(bool enabled) noexcept {
+  timing = enabled;
+}
+
+// Zeroes the call counts and times, i.e. at the start of a frame.
+void reset_gl_call_counts() noexcept {
+  std::fill(call_counts, call_counts + gl_function_count, 0u);
+  std::fill(call_ns, call_ns + gl_function_count, 0);
+}
+
+// Returns the count and time of every function called since the counts were last reset, most called first.
+std::vector<gl_call_count> gl_call_counts() {
+  std::vector<gl_call_count> counts;
+
+  for (int i = 0; i < gl_function_count; ++i) {
+    if (call_counts[i] > 0) {
+      counts.push_back(gl_call_count { function_names[i], call_counts[i], call_ns[i] / 1000000.0 });
+    }
+  }
+
+  std::stable_sort(counts.begin(), counts.end(), [](const gl_call_count& a, const gl_call_count& b) {
+    return a.calls > b.calls;
+  });
+
+  return counts;
+}
+
+// Returns the number of calls to a function since the counts were last reset.
+//
+// Parameters
+// name - the name of the function, i.e. glBindTexture
+unsigned int gl_calls(const char* name) noexcept {
+  for (int i = 0; i < gl_function_count; ++i) {
+    if (std::strcmp(function_names[i], name) == 0) {
+      return call_counts[i];
+    }
+  }
+
+  return 0;
+}
+
+}
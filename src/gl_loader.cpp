@@ -0,0 +1,211 @@
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include <glad/glad.h>
+
+#include "myopengl/gl_loader.h"
+
+namespace myopengl {
+
+namespace {
+
+enum gl_function_id {
+#define MYOPENGL_GL_FUNCTION(name, type) id_##name,
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+  gl_function_count
+};
+
+const char* const function_names[] = {
+#define MYOPENGL_GL_FUNCTION(name, type) #name,
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+};
+
+proc_loader_t lazy_loader = NULL;
+size_t resolved_count = 0;
+
+// Resolves a function through the loader given to load_gl.  A missing function is a fatal error since the call
+// which triggered the lookup has nowhere to go.
+//
+// Parameters
+// id - the function to resolve
+//
+// Returns the address of the function
+void* resolve(gl_function_id id) {
+  assert(lazy_loader != NULL);
+
+  void* function = lazy_loader(function_names[id]);
+
+  if (function == NULL) {
+    std::fprintf(stderr, "OpenGL function [%s] is not available\n", function_names[id]);
+    std::abort();
+  }
+
+  ++resolved_count;
+
+  return function;
+}
+
+template <gl_function_id id, auto slot, typename function_t = std::remove_pointer_t<decltype(slot)>>
+struct trampoline;
+
+// Stands in for an OpenGL function until it is first called, at which point it resolves the function and patches
+// glad's pointer so later calls go straight to the driver.  The resolved function is also kept here, so a pointer
+// captured before the patch, such as an interception hook installed over the trampoline, keeps working.
+template <gl_function_id id, auto slot, typename result_t, typename... argument_ts>
+struct trampoline<id, slot, result_t(APIENTRYP)(argument_ts...)> {
+  typedef result_t(APIENTRYP function_t)(argument_ts...);
+
+  static function_t resolved;
+
+  static result_t APIENTRY call(argument_ts... arguments) {
+    if (resolved == NULL) {
+      resolved = reinterpret_cast<function_t>(resolve(id));
+
+      if (*slot == &call) {
+        *slot = resolved;
+      }
+    }
+
+    return resolved(arguments...);
+  }
+
+  static void install() noexcept {
+    resolved = NULL;
+    *slot = &call;
+  }
+};
+
+template <gl_function_id id, auto slot, typename result_t, typename... argument_ts>
+typename trampoline<id, slot, result_t(APIENTRYP)(argument_ts...)>::function_t
+    trampoline<id, slot, result_t(APIENTRYP)(argument_ts...)>::resolved
+    = NULL;
+
+// Reads the version of the current context and sets glad's version flags, as gladLoadGLLoader does before loading.
+//
+// Parameters
+// loader - resolves glGetString
+//
+// Returns true if a version could be read
+bool load_version(proc_loader_t loader) {
+  GLVersion.major = 0;
+  GLVersion.minor = 0;
+
+  glad_glGetString = reinterpret_cast<PFNGLGETSTRINGPROC>(loader("glGetString"));
+
+  if (glad_glGetString == NULL) {
+    return false;
+  }
+
+  const char* version = reinterpret_cast<const char*>(glad_glGetString(GL_VERSION));
+  int major = 0;
+  int minor = 0;
+
+  if (version == NULL || std::sscanf(version, "%d.%d", &major, &minor) != 2) {
+    return false;
+  }
+
+  GLVersion.major = major;
+  GLVersion.minor = minor;
+
+  GLAD_GL_VERSION_1_0 = major >= 1;
+  GLAD_GL_VERSION_1_1 = (major == 1 && minor >= 1) || major > 1;
+  GLAD_GL_VERSION_1_2 = (major == 1 && minor >= 2) || major > 1;
+  GLAD_GL_VERSION_1_3 = (major == 1 && minor >= 3) || major > 1;
+  GLAD_GL_VERSION_1_4 = (major == 1 && minor >= 4) || major > 1;
+  GLAD_GL_VERSION_1_5 = (major == 1 && minor >= 5) || major > 1;
+  GLAD_GL_VERSION_2_0 = major >= 2;
+  GLAD_GL_VERSION_2_1 = (major == 2 && minor >= 1) || major > 2;
+  GLAD_GL_VERSION_3_0 = major >= 3;
+  GLAD_GL_VERSION_3_1 = (major == 3 && minor >= 1) || major > 3;
+  GLAD_GL_VERSION_3_2 = (major == 3 && minor >= 2) || major > 3;
+  GLAD_GL_VERSION_3_3 = (major == 3 && minor >= 3) || major > 3;
+
+  return true;
+}
+
+}
+
+// Loads OpenGL for the current context.  Eager loading is gladLoadGLLoader, resolving every OpenGL 3.3 function up
+// front.  Lazy loading resolves only glGetString to read the version and points every other function at a
+// trampoline which resolves it on first call, so a process pays only for the functions it uses.  Functions a lazily
+// loaded context does not provide abort when called rather than being NULL.
+//
+// Parameters
+// loader - resolves OpenGL functions for the current context
+// mode - whether functions are resolved up front or on first call
+//
+// Returns true if OpenGL was loaded
+bool load_gl(proc_loader_t loader, gl_loading mode) {
+  assert(loader != NULL);
+
+  if (mode == gl_loading::eager) {
+    return gladLoadGLLoader(loader) != 0;
+  }
+
+  if (!load_version(loader)) {
+    return false;
+  }
+
+  lazy_loader = loader;
+
+#define MYOPENGL_GL_FUNCTION(name, type) trampoline<id_##name, &glad_##name>::install();
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+
+  glad_glGetString = reinterpret_cast<PFNGLGETSTRINGPROC>(loader("glGetString"));
+
+  return true;
+}
+
+// Loads only the named OpenGL functions for the current context, leaving every other function NULL.  For tools
+// which declare up front the few functions they call.
+//
+// Parameters
+// loader - resolves OpenGL functions for the current context
+// names - the functions to load, i.e. glClear
+//
+// Returns true if the version could be read and every named function was resolved
+bool load_gl_subset(proc_loader_t loader, const std::vector<std::string>& names) {
+  assert(loader != NULL);
+
+  if (!load_version(loader)) {
+    return false;
+  }
+
+#define MYOPENGL_GL_FUNCTION(name, type) glad_##name = NULL;
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+
+  glad_glGetString = reinterpret_cast<PFNGLGETSTRINGPROC>(loader("glGetString"));
+
+  bool loaded = true;
+
+  for (const std::string& name : names) {
+    void* function = loader(name.c_str());
+    loaded = loaded && function != NULL;
+
+#define MYOPENGL_GL_FUNCTION(gl_name, type)                   \
+  if (name == #gl_name) {                                     \
+    glad_##gl_name = reinterpret_cast<type>(function);        \
+    continue;                                                 \
+  }
+#include "gl_functions.inl"
+#undef MYOPENGL_GL_FUNCTION
+
+    loaded = false;
+  }
+
+  return loaded;
+}
+
+// Returns the number of functions resolved by trampolines since the process started.
+size_t gl_functions_resolved() noexcept {
+  return resolved_count;
+}
+
+}
@@ -0,0 +1,201 @@
+#ifdef MYOPENGL_HAS_GLFW
+
+#include <GLFW/glfw3.h>
+
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+
+namespace myopengl {
+
+namespace {
+
+// A context backed by a GLFW window.
+class glfw_context : public context {
+
+  public:
+  glfw_context(const context_options& options);
+  ~glfw_context() override;
+
+  void swap_buffers() override;
+  void poll_events() override;
+  bool key_pressed(key k) const override;
+  void framebuffer_size(int& width, int& height) const override;
+  void set_resize_callback(resize_callback_t callback) override;
+  proc_loader_t proc_loader() const noexcept override;
+  bool set_swap_interval(int interval) override;
+  double presentation_rate() const override;
+
+  private:
+  static void on_framebuffer_size(GLFWwindow* window, int width, int height);
+
+  GLFWwindow* _window;
+  resize_callback_t _resize_callback;
+  int _swap_interval;
+};
+
+// Maps a key to its GLFW key code.
+int glfw_key(key k) {
+  switch (k) {
+    case key::escape:
+      return GLFW_KEY_ESCAPE;
+    case key::up:
+      return GLFW_KEY_UP;
+    case key::down:
+      return GLFW_KEY_DOWN;
+    case key::left:
+      return GLFW_KEY_LEFT;
+    case key::right:
+      return GLFW_KEY_RIGHT;
+    case key::space:
+      return GLFW_KEY_SPACE;
+  }
+
+  return GLFW_KEY_UNKNOWN;
+}
+
+// Construct a GLFW window with an OpenGL 3.3 core context and make it current.
+//
+// Parameters
+// options - size, title and framebuffer options of the window
+//
+// Throws
+// context_exception - if GLFW could not be initialised or the window could not be created
+glfw_context::glfw_context(const context_options& options)
+    : context(options)
+    , _window(NULL)
+    , _resize_callback(NULL)
+    , _swap_interval(0) {
+  if (!glfwInit()) {
+    throw context_exception("Failed to initialise GLFW");
+  }
+
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  glfwWindowHint(GLFW_SRGB_CAPABLE, options.srgb ? GLFW_TRUE : GLFW_FALSE);
+
+  _window = glfwCreateWindow(options.width, options.height, options.title.c_str(), NULL, NULL);
+
+  if (_window == NULL) {
+    glfwTerminate();
+    throw context_exception("Failed to create window");
+  }
+
+  glfwSetWindowUserPointer(_window, this);
+  glfwMakeContextCurrent(_window);
+  glfwSetFramebufferSizeCallback(_window, on_framebuffer_size);
+}
+
+// Deconstructs the context, destroying the window and terminating GLFW.
+glfw_context::~glfw_context() {
+  glfwDestroyWindow(_window);
+  glfwTerminate();
+}
+
+// Presents the back buffer.
+void glfw_context::swap_buffers() {
+  glfwSwapBuffers(_window);
+  end_frame();
+}
+
+// Processes pending window events, requesting a close if the window has been asked to close.
+void glfw_context::poll_events() {
+  glfwPollEvents();
+
+  if (glfwWindowShouldClose(_window)) {
+    request_close();
+  }
+}
+
+// Returns true if a key is held down.
+//
+// Parameters
+// k - the key to check
+bool glfw_context::key_pressed(key k) const {
+  return glfwGetKey(_window, glfw_key(k)) == GLFW_PRESS;
+}
+
+// Retrieves the size of the framebuffer in pixels.
+//
+// Parameters
+// width - receives the width of the framebuffer
+// height - receives the height of the framebuffer
+void glfw_context::framebuffer_size(int& width, int& height) const {
+  glfwGetFramebufferSize(_window, &width, &height);
+}
+
+// Sets a function to be called when the framebuffer is resized.
+//
+// Parameters
+// callback - the function to call, or NULL to remove it
+void glfw_context::set_resize_callback(resize_callback_t callback) {
+  _resize_callback = callback;
+}
+
+// Returns the function used to resolve OpenGL functions.
+proc_loader_t glfw_context::proc_loader() const noexcept {
+  return (proc_loader_t)glfwGetProcAddress;
+}
+
+// Sets the number of display refreshes swap_buffers waits for.  Adaptive vsync, a negative interval, needs
+// WGL_EXT_swap_control_tear or GLX_EXT_swap_control_tear and falls back to vsync without them.
+//
+// Parameters
+// interval - the swap interval
+//
+// Returns true if the interval is supported
+bool glfw_context::set_swap_interval(int interval) {
+  bool supported = interval >= 0 || glfwExtensionSupported("WGL_EXT_swap_control_tear")
+      || glfwExtensionSupported("GLX_EXT_swap_control_tear");
+
+  _swap_interval = supported ? interval : 1;
+  glfwSwapInterval(_swap_interval);
+
+  return supported;
+}
+
+// Returns the rate at which swap_buffers presents when synchronised to the primary monitor, or 0 without vsync.
+double glfw_context::presentation_rate() const {
+  GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+  const GLFWvidmode* mode = monitor != NULL ? glfwGetVideoMode(monitor) : NULL;
+
+  if (_swap_interval == 0 || mode == NULL || mode->refreshRate <= 0) {
+    return 0.0;
+  }
+
+  return static_cast<double>(mode->refreshRate) / (_swap_interval < 0 ? 1 : _swap_interval);
+}
+
+// Function callback registered with GLFW called when the framebuffer dimensions change.  Forwards to the resize
+// callback of the context owning the window.
+//
+// Parameters
+// window - the window whose dimensions have changed
+// width - the new width of the framebuffer
+// height - the new height of the framebuffer
+void glfw_context::on_framebuffer_size(GLFWwindow* window, int width, int height) {
+  glfw_context* self = static_cast<glfw_context*>(glfwGetWindowUserPointer(window));
+
+  if (self != NULL && self->_resize_callback != NULL) {
+    self->_resize_callback(width, height);
+  }
+}
+
+}
+
+// Creates a context backed by a GLFW window.
+//
+// Parameters
+// options - size, title and framebuffer options of the window
+//
+// Throws
+// context_exception - if the window could not be created
+//
+// Returns the context, made current on the calling thread
+std::unique_ptr<context> create_glfw_context(const context_options& options) {
+  return std::unique_ptr<context>(new glfw_context(options));
+}
+
+}
+
+#endif
@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+
+#include <glad/glad.h>
+
+#include "myopengl/gpu_profiler.h"
+
+namespace myopengl {
+
+namespace {
+
+thread_local gpu_profiler* current_profiler = NULL;
+
+// Writes a node of the profile and its children, indented by depth.
+//
+// Parameters
+// stream - the stream to write to
+// nodes - every node of the profile
+// index - the node to write
+void write_node(std::ostream& stream, const std::vector<gpu_profile_node>& nodes, int index) {
+  const gpu_profile_node& node = nodes[index];
+  double frames = node.frames > 0 ? node.frames : 1;
+
+  stream << std::string(node.depth * 2, ' ') << std::left << std::setw(32 - node.depth * 2) << node.name << std::right
+         << std::fixed << std::setprecision(3) << std::setw(10) << node.total_cpu_ms / frames << std::setw(10)
+         << node.total_gpu_ms / frames << std::endl;
+
+  for (size_t i = index + 1; i < nodes.size(); ++i) {
+    if (nodes[i].parent == index) {
+      write_node(stream, nodes, static_cast<int>(i));
+    }
+  }
+}
+
+}
+
+// Construct a GPU profiler.  Scopes are timed on the GPU with GL_TIMESTAMP queries issued at their start and end,
+// and on the CPU with a steady clock.  Each frame has its own set of queries which are read back when the set is
+// reused, so results lag by the frame latency.  A set whose results are not yet available is kept for later and a
+// new set is added in its place, so reading them never stalls the pipeline.
+//
+// Parameters
+// frame_latency - the number of frames expected to be in flight, the initial number of query sets less one
+gpu_profiler::gpu_profiler(int frame_latency)
+    : _frames(frame_latency + 1)
+    , _frame(0)
+    , _previous(NULL) {
+  assert(frame_latency >= 0);
+}
+
+// Deconstructs a GPU profiler, releasing its queries.
+gpu_profiler::~gpu_profiler() {
+  for (frame& f : _frames) {
+    if (!f.queries.empty()) {
+      glDeleteQueries(static_cast<int>(f.queries.size()), f.queries.data());
+    }
+  }
+}
+
+// Starts profiling a frame and makes the profiler current on the calling thread so gpu_scope can find it.  A root
+// scope named frame is opened which every other scope nests within.
+void gpu_profiler::begin_frame() {
+  assert(_open.empty());
+
+  if (_frames[_frame].pending && !resolve(_frames[_frame], false)) {
+    _frames.insert(_frames.begin() + _frame, frame());
+  }
+
+  frame& f = _frames[_frame];
+  f.events.clear();
+  f.used_queries = 0;
+
+  _previous = current_profiler;
+  current_profiler = this;
+
+  begin_scope("frame");
+}
+
+// Ends profiling a frame, closing its root scope and restoring the previously current profiler.
+void gpu_profiler::end_frame() {
+  end_scope();
+  assert(_open.empty());
+
+  _frames[_frame].pending = true;
+  _frame = (_frame + 1) % _frames.size();
+
+  current_profiler = _previous;
+}
+
+// Opens a scope nested within the innermost open scope.
+//
+// Parameters
+// name - the name of the scope, scopes with the same name and parent are aggregated
+void gpu_profiler::begin_scope(const char* name) {
+  assert(name != NULL);
+
+  frame& f = _frames[_frame];
+  int parent = _open.empty() ? -1 : f.events[_open.back()].node;
+
+  event e;
+  e.node = find_node(parent, name);
+  e.begin_query = issue_timestamp(f);
+  e.end_query = 0;
+  e.cpu_begin = std::chrono::steady_clock::now();
+
+  _open.push_back(f.events.size());
+  f.events.push_back(e);
+}
+
+// Closes the innermost open scope.
+void gpu_profiler::end_scope() {
+  assert(!_open.empty());
+
+  frame& f = _frames[_frame];
+  event& e = f.events[_open.back()];
+
+  e.cpu_end = std::chrono::steady_clock::now();
+  e.end_query = issue_timestamp(f);
+
+  _open.pop_back();
+}
+
+// Waits for the results of every frame in flight.  Call before reading the nodes of a finished run.
+void gpu_profiler::finish() {
+  assert(_open.empty());
+
+  for (size_t i = 0; i < _frames.size(); ++i) {
+    frame& f = _frames[(_frame + i) % _frames.size()];
+
+    if (f.pending) {
+      resolve(f, true);
+    }
+  }
+}
+
+// Returns every scope seen so far.  A node's parent precedes it, and its times are those of the most recently
+// resolved frame alongside totals across every resolved frame the scope appeared in.
+const std::vector<gpu_profile_node>& gpu_profiler::nodes() const noexcept {
+  return _nodes;
+}
+
+// Returns true if frames take longer on the GPU than on the CPU, on average across resolved frames.
+bool gpu_profiler::gpu_bound() const noexcept {
+  return !_nodes.empty() && _nodes.front().total_gpu_ms > _nodes.front().total_cpu_ms;
+}
+
+// Writes the average CPU and GPU time of every scope as an indented tree.
+//
+// Parameters
+// stream - the stream to write to
+void gpu_profiler::write_report(std::ostream& stream) const {
+  stream << std::left << std::setw(32) << "scope" << std::right << std::setw(10) << "cpu ms" << std::setw(10)
+         << "gpu ms" << std::endl;
+
+  for (size_t i = 0; i < _nodes.size(); ++i) {
+    if (_nodes[i].parent == -1) {
+      write_node(stream, _nodes, static_cast<int>(i));
+    }
+  }
+
+  if (!_nodes.empty()) {
+    stream << (gpu_bound() ? "GPU bound" : "CPU bound") << std::endl;
+  }
+}
+
+// Returns the profiler current on the calling thread, or NULL if no frame is being profiled.
+gpu_profiler* gpu_profiler::current() noexcept {
+  return current_profiler;
+}
+
+// Finds the node for a scope, creating it on first use.
+//
+// Parameters
+// parent - the index of the parent node, or -1 for a root
+// name - the name of the scope
+//
+// Returns the index of the node
+int gpu_profiler::find_node(int parent, const char* name) {
+  for (size_t i = 0; i < _nodes.size(); ++i) {
+    if (_nodes[i].parent == parent && _nodes[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+
+  gpu_profile_node node;
+  node.name = name;
+  node.parent = parent;
+  node.depth = parent == -1 ? 0 : _nodes[parent].depth + 1;
+
+  _nodes.push_back(node);
+
+  return static_cast<int>(_nodes.size() - 1);
+}
+
+// Records the GPU time once every command before it has completed, growing the frame's query pool as needed.
+//
+// Parameters
+// f - the frame the query belongs to
+//
+// Returns the index of the query within the frame
+size_t gpu_profiler::issue_timestamp(frame& f) {
+  if (f.used_queries == f.queries.size()) {
+    size_t grow = std::max<size_t>(f.queries.size(), 16);
+
+    f.queries.resize(f.queries.size() + grow);
+    glGenQueries(static_cast<int>(grow), f.queries.data() + f.used_queries);
+  }
+
+  glQueryCounter(f.queries[f.used_queries], GL_TIMESTAMP);
+
+  return f.used_queries++;
+}
+
+// Reads back the queries of a frame and adds its scope times to their nodes.  A scope entered several times in a
+// frame has its times summed.  Timestamps complete in order, so the frame is ready once its last query is.
+//
+// Parameters
+// f - the frame to resolve
+// wait - true to wait for the results, false to leave the frame pending if they are not yet available
+//
+// Returns true if the frame was resolved
+bool gpu_profiler::resolve(frame& f, bool wait) {
+  if (!wait) {
+    int available = 0;
+    glGetQueryObjectiv(f.queries[f.used_queries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (!available) {
+      return false;
+    }
+  }
+
+  std::vector<GLuint64> timestamps(f.used_queries);
+
+  for (size_t i = 0; i < f.used_queries; ++i) {
+    glGetQueryObjectui64v(f.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+  }
+
+  for (gpu_profile_node& node : _nodes) {
+    node.cpu_ms = 0.0;
+    node.gpu_ms = 0.0;
+  }
+
+  std::vector<bool> seen(_nodes.size(), false);
+
+  for (const event& e : f.events) {
+    std::chrono::duration<double, std::milli> cpu = e.cpu_end - e.cpu_begin;
+    gpu_profile_node& node = _nodes[e.node];
+
+    node.cpu_ms += cpu.count();
+    node.gpu_ms += static_cast<double>(timestamps[e.end_query] - timestamps[e.begin_query]) / 1000000.0;
+    seen[e.node] = true;
+  }
+
+  for (size_t i = 0; i < _nodes.size(); ++i) {
+    if (seen[i]) {
+      _nodes[i].total_cpu_ms += _nodes[i].cpu_ms;
+      _nodes[i].total_gpu_ms += _nodes[i].gpu_ms;
+      ++_nodes[i].frames;
+    }
+  }
+
+  f.pending = false;
+
+  return true;
+}
+
+// Opens a scope on the current profiler, closing it when the scope object is destroyed.  Does nothing if no frame
+// is being profiled.
+//
+// Parameters
+// name - the name of the scope
+gpu_scope::gpu_scope(const char* name)
+    : _profiler(gpu_profiler::current()) {
+  if (_profiler != NULL) {
+    _profiler->begin_scope(name);
+  }
+}
+
+// Closes the scope.
+gpu_scope::~gpu_scope() {
+  if (_profiler != NULL) {
+    _profiler->end_scope();
+  }
+}
+
+}
@@ -0,0 +1,238 @@
+#ifdef MYOPENGL_HAS_EGL
+
+#include <string>
+
+#include <glad/glad.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "myopengl/context.h"
+#include "myopengl/context_exception.h"
+#include "myopengl/gl_loader.h"
+
+namespace myopengl {
+
+namespace {
+
+// A context with no window, created on Mesa's surfaceless EGL platform so it runs on machines without a display,
+// i.e. llvmpipe on a build server.  Rendering goes to an offscreen framebuffer of the requested size.
+class headless_context : public context {
+
+  public:
+  headless_context(const context_options& options);
+  ~headless_context() override;
+
+  void swap_buffers() override;
+  void poll_events() override;
+  bool key_pressed(key k) const override;
+  void framebuffer_size(int& width, int& height) const override;
+  void set_resize_callback(resize_callback_t callback) override;
+  proc_loader_t proc_loader() const noexcept override;
+  unsigned int framebuffer() const noexcept override;
+  void gl_loaded() override;
+
+  private:
+  static void* get_proc_address(const char* name);
+
+  EGLDisplay _display;
+  EGLContext _context;
+  int _width;
+  int _height;
+  bool _srgb;
+  unsigned int _framebuffer;
+  unsigned int _colour;
+  unsigned int _depth_stencil;
+};
+
+// Construct a surfaceless EGL display and OpenGL 3.3 core context and make it current.  The offscreen framebuffer is
+// created once create_context has loaded OpenGL.
+//
+// Parameters
+// options - size and framebuffer options of the context
+//
+// Throws
+// context_exception - if the surfaceless platform is unavailable or the context could not be created
+headless_context::headless_context(const context_options& options)
+    : context(options)
+    , _display(EGL_NO_DISPLAY)
+    , _context(EGL_NO_CONTEXT)
+    , _width(options.width)
+    , _height(options.height)
+    , _srgb(options.srgb)
+    , _framebuffer(0)
+    , _colour(0)
+    , _depth_stencil(0) {
+  PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display
+      = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+  if (get_platform_display == NULL) {
+    throw context_exception("EGL_EXT_platform_base is not supported");
+  }
+
+  _display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+  if (_display == EGL_NO_DISPLAY || !eglInitialize(_display, NULL, NULL)) {
+    throw context_exception("Failed to initialise the surfaceless EGL display");
+  }
+
+  const EGLint config_attributes[] = {
+    EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE
+  };
+
+  EGLConfig config;
+  EGLint configs = 0;
+
+  if (!eglChooseConfig(_display, config_attributes, &config, 1, &configs) || configs == 0) {
+    eglTerminate(_display);
+    throw context_exception("No EGL config supports desktop OpenGL");
+  }
+
+  eglBindAPI(EGL_OPENGL_API);
+
+  const EGLint context_attributes[] = {
+    EGL_CONTEXT_MAJOR_VERSION, 3,
+    EGL_CONTEXT_MINOR_VERSION, 3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+  };
+
+  _context = eglCreateContext(_display, config, EGL_NO_CONTEXT, context_attributes);
+
+  if (_context == EGL_NO_CONTEXT || !eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _context)) {
+    EGLint error = eglGetError();
+
+    if (_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(_display, _context);
+    }
+
+    eglTerminate(_display);
+    throw context_exception("Failed to create an OpenGL 3.3 core context, EGL error [" + std::to_string(error) + "]");
+  }
+}
+
+// Deconstructs the context, releasing the offscreen framebuffer, if it was created, and the EGL display.
+headless_context::~headless_context() {
+  if (_framebuffer != 0) {
+    glDeleteFramebuffers(1, &_framebuffer);
+    glDeleteRenderbuffers(1, &_colour);
+    glDeleteRenderbuffers(1, &_depth_stencil);
+  }
+
+  eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  eglDestroyContext(_display, _context);
+  eglTerminate(_display);
+}
+
+// Ends the frame.  There is nothing to present, so the commands are flushed to keep the driver from queueing an
+// unbounded number of frames.
+void headless_context::swap_buffers() {
+  glFlush();
+  end_frame();
+}
+
+// There are no window events to process.
+void headless_context::poll_events() {
+}
+
+// Returns false for every key, there is no keyboard.
+bool headless_context::key_pressed(key) const {
+  return false;
+}
+
+// Retrieves the size of the offscreen framebuffer in pixels.
+//
+// Parameters
+// width - receives the width of the framebuffer
+// height - receives the height of the framebuffer
+void headless_context::framebuffer_size(int& width, int& height) const {
+  width = _width;
+  height = _height;
+}
+
+// The offscreen framebuffer is never resized, so the callback is ignored.
+void headless_context::set_resize_callback(resize_callback_t) {
+}
+
+// Returns the function used to resolve OpenGL functions.
+proc_loader_t headless_context::proc_loader() const noexcept {
+  return get_proc_address;
+}
+
+// Returns the offscreen framebuffer.
+unsigned int headless_context::framebuffer() const noexcept {
+  return _framebuffer;
+}
+
+// Resolves an OpenGL function through EGL.
+//
+// Parameters
+// name - the name of the function
+//
+// Returns the function, or NULL if it is not supported
+void* headless_context::get_proc_address(const char* name) {
+  return (void*)eglGetProcAddress(name);
+}
+
+// Creates the offscreen framebuffer with a colour and a combined depth stencil renderbuffer, clears it and leaves it
+// bound.  An incomplete framebuffer is released before throwing, and the EGL context is released by the destructor
+// as create_context discards the context.
+//
+// Throws
+// context_exception - if the framebuffer is incomplete
+void headless_context::gl_loaded() {
+  glGenRenderbuffers(1, &_colour);
+  glBindRenderbuffer(GL_RENDERBUFFER, _colour);
+  glRenderbufferStorage(GL_RENDERBUFFER, _srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8, _width, _height);
+
+  glGenRenderbuffers(1, &_depth_stencil);
+  glBindRenderbuffer(GL_RENDERBUFFER, _depth_stencil);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, _width, _height);
+
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &_framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _colour);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _depth_stencil);
+
+  GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+  if (status != GL_FRAMEBUFFER_COMPLETE) {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &_framebuffer);
+    glDeleteRenderbuffers(1, &_colour);
+    glDeleteRenderbuffers(1, &_depth_stencil);
+    _framebuffer = 0;
+    _colour = 0;
+    _depth_stencil = 0;
+
+    throw context_exception("Offscreen framebuffer is incomplete, status [" + std::to_string(status) + "]");
+  }
+
+  // llvmpipe reports a meaningless result for an elapsed time query spanning the first rendering of a context, so
+  // the framebuffer is cleared and the work completed before anything is timed.
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+  glFinish();
+}
+
+}
+
+// Creates a headless context rendering to an offscreen framebuffer.
+//
+// Parameters
+// options - size and framebuffer options of the context
+//
+// Throws
+// context_exception - if the context could not be created
+//
+// Returns the context, made current on the calling thread
+std::unique_ptr<context> create_headless_context(const context_options& options) {
+  return std::unique_ptr<context>(new headless_context(options));
+}
+
+}
+
+#endif
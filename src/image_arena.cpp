@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "myopengl/image_arena.h"
+
+namespace myopengl {
+
+namespace {
+
+constexpr size_t arena_alignment = 16;
+
+thread_local image_arena* current_arena = NULL;
+thread_local image_allocation_stats allocation_stats;
+
+// Rounds a size up to the alignment of arena allocations.
+size_t align_size(size_t size) {
+  return (std::max<size_t>(size, 1) + arena_alignment - 1) & ~(arena_alignment - 1);
+}
+
+}
+
+// Makes an arena current for the calling thread until the scope ends, at which point the arena is reset and the
+// previously current arena is restored.
+//
+// Parameters
+// arena - the arena to be made current
+image_arena::scope::scope(image_arena& arena) noexcept
+    : _arena(arena)
+    , _previous(current_arena) {
+  current_arena = &_arena;
+}
+
+// Restores the previously current arena and resets this one, releasing every allocation made within the scope.
+image_arena::scope::~scope() {
+  current_arena = _previous;
+  _arena.reset();
+}
+
+// Construct a bump arena.  Memory is reserved in blocks as allocations are made and kept across resets.
+//
+// Parameters
+// block_size - the size of each block reserved by the arena
+image_arena::image_arena(size_t block_size)
+    : _block_size(block_size)
+    , _block(0)
+    , _offset(0)
+    , _used(0)
+    , _peak(0)
+    , _last(NULL) {
+  assert(block_size > 0);
+}
+
+// Allocates memory from the arena.
+//
+// Parameters
+// size - the number of bytes to allocate
+//
+// Throws
+// std::bad_alloc - if a new block could not be reserved
+//
+// Returns memory aligned to 16 bytes which remains valid until the arena is reset
+void* image_arena::allocate(size_t size) {
+  size = align_size(size);
+
+  while (_block < _blocks.size()) {
+    block& b = _blocks[_block];
+
+    if (_offset + size <= b.size) {
+      void* p = b.data.get() + _offset;
+
+      _offset += size;
+      _used += size;
+      _peak = std::max(_peak, _used);
+      _last = p;
+
+      return p;
+    }
+
+    ++_block;
+    _offset = 0;
+  }
+
+  size_t block_size = std::max(_block_size, size);
+  _blocks.push_back(block { std::unique_ptr<unsigned char[]>(new unsigned char[block_size]), block_size });
+  _block = _blocks.size() - 1;
+  _offset = 0;
+
+  return allocate(size);
+}
+
+// Resizes an allocation.  The most recent allocation is grown in place when its block has room, which covers the
+// common case of a decoder growing its output buffer.
+//
+// Parameters
+// p - the allocation to resize, or NULL to allocate
+// old_size - the size the allocation was made with
+// new_size - the size required
+//
+// Throws
+// std::bad_alloc - if a new block could not be reserved
+//
+// Returns the resized allocation
+void* image_arena::reallocate(void* p, size_t old_size, size_t new_size) {
+  if (p == NULL) {
+    return allocate(new_size);
+  }
+
+  assert(owns(p));
+
+  if (p == _last) {
+    block& b = _blocks[_block];
+    size_t start = static_cast<unsigned char*>(p) - b.data.get();
+    size_t size = align_size(new_size);
+
+    if (start + size <= b.size) {
+      _used = _used - (_offset - start) + size;
+      _peak = std::max(_peak, _used);
+      _offset = start + size;
+
+      return p;
+    }
+  }
+
+  void* q = allocate(new_size);
+  std::memcpy(q, p, std::min(old_size, new_size));
+
+  return q;
+}
+
+// Returns true if memory was allocated from this arena.
+//
+// Parameters
+// p - the memory to check
+bool image_arena::owns(const void* p) const noexcept {
+  const unsigned char* address = static_cast<const unsigned char*>(p);
+
+  for (const block& b : _blocks) {
+    if (address >= b.data.get() && address < b.data.get() + b.size) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Releases every allocation.  If the arena spilled into several blocks they are replaced by a single block large
+// enough to hold them all, so the next image of a similar size is served from one block.
+void image_arena::reset() noexcept {
+  if (_blocks.size() > 1) {
+    size_t total = capacity();
+
+    _blocks.clear();
+
+    unsigned char* data = new (std::nothrow) unsigned char[total];
+
+    if (data != NULL) {
+      _blocks.push_back(block { std::unique_ptr<unsigned char[]>(data), total });
+    }
+  }
+
+  _block = 0;
+  _offset = 0;
+  _used = 0;
+  _last = NULL;
+}
+
+// Returns the number of bytes allocated since the last reset.
+size_t image_arena::used() const noexcept {
+  return _used;
+}
+
+// Returns the largest number of bytes allocated between resets.
+size_t image_arena::peak() const noexcept {
+  return _peak;
+}
+
+// Returns the number of bytes reserved by the arena.
+size_t image_arena::capacity() const noexcept {
+  size_t total = 0;
+
+  for (const block& b : _blocks) {
+    total += b.size;
+  }
+
+  return total;
+}
+
+// Returns an arena owned by the calling thread, created on first use.
+image_arena& image_arena::thread_arena() {
+  thread_local image_arena arena;
+
+  return arena;
+}
+
+// Returns the arena current for the calling thread, or NULL if no scope is active.
+image_arena* image_arena::current() noexcept {
+  return current_arena;
+}
+
+// Returns counters for every image decoder allocation made on the calling thread.
+const image_allocation_stats& thread_image_allocation_stats() noexcept {
+  return allocation_stats;
+}
+
+// Resets the image decoder allocation counters of the calling thread.
+void reset_thread_image_allocation_stats() noexcept {
+  allocation_stats = image_allocation_stats();
+}
+
+// STBI_MALLOC hook.  Allocates from the current arena when a scope is active, otherwise from the heap.
+//
+// Parameters
+// size - the number of bytes to allocate
+//
+// Returns the allocation, or NULL if memory could not be allocated
+void* image_arena_malloc(size_t size) {
+  ++allocation_stats.allocations;
+  allocation_stats.bytes += size;
+
+  image_arena* arena = current_arena;
+
+  if (arena == NULL) {
+    return std::malloc(size);
+  }
+
+  ++allocation_stats.arena_allocations;
+
+  try {
+    return arena->allocate(size);
+  } catch (std::bad_alloc&) {
+    return NULL;
+  }
+}
+
+// STBI_REALLOC_SIZED hook.  Resizes within the current arena when the memory belongs to it, otherwise on the heap.
+//
+// Parameters
+// p - the allocation to resize
+// old_size - the size the allocation was made with
+// new_size - the size required
+//
+// Returns the resized allocation, or NULL if memory could not be allocated
+void* image_arena_realloc(void* p, size_t old_size, size_t new_size) {
+  ++allocation_stats.reallocations;
+  allocation_stats.bytes += new_size;
+
+  image_arena* arena = current_arena;
+
+  if (arena == NULL || (p != NULL && !arena->owns(p))) {
+    return std::realloc(p, new_size);
+  }
+
+  ++allocation_stats.arena_allocations;
+
+  try {
+    return arena->reallocate(p, old_size, new_size);
+  } catch (std::bad_alloc&) {
+    return NULL;
+  }
+}
+
+// STBI_FREE hook.  Arena memory is released when its scope ends, so only heap memory is freed.  Memory allocated
+// within a scope must not be freed after the scope has ended.
+//
+// Parameters
+// p - the allocation to free
+void image_arena_free(void* p) {
+  ++allocation_stats.frees;
+
+  image_arena* arena = current_arena;
+
+  if (arena == NULL || !arena->owns(p)) {
+    std::free(p);
+  }
+}
+
+}
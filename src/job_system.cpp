@@ -0,0 +1,496 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include "myopengl/job_system.h"
+
+namespace myopengl {
+
+struct job {
+  job_function_t function;
+  job_counter* counter;
+};
+
+// A Chase-Lev work stealing deque of fixed capacity.  The owning thread pushes and pops at the bottom while other
+// threads steal from the top, so the owner works depth first on what it most recently spawned and thieves take the
+// oldest, typically largest, work.  Memory orderings follow Lê, Pop, Cohen and Zappa Nardelli, "Correct and
+// Efficient Work-Stealing for Weak Memory Models".
+class job_deque {
+
+  public:
+  job_deque(size_t capacity)
+      : _jobs(capacity)
+      , _mask(static_cast<int64_t>(capacity) - 1)
+      , _top(0)
+      , _bottom(0) {
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  }
+
+  // Pushes a job at the bottom.  Only the owning thread may push.
+  //
+  // Returns false if the deque is full
+  bool push(job* j) noexcept {
+    int64_t b = _bottom.load(std::memory_order_relaxed);
+    int64_t t = _top.load(std::memory_order_acquire);
+
+    if (b - t > _mask) {
+      return false;
+    }
+
+    _jobs[b & _mask].store(j, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(b + 1, std::memory_order_relaxed);
+
+    return true;
+  }
+
+  // Pops the most recently pushed job.  Only the owning thread may pop.
+  //
+  // Returns the job, or NULL if the deque is empty or the last job was stolen
+  job* pop() noexcept {
+    int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = _top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+      _bottom.store(b + 1, std::memory_order_relaxed);
+      return NULL;
+    }
+
+    job* j = _jobs[b & _mask].load(std::memory_order_relaxed);
+
+    if (t == b) {
+      if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        j = NULL;
+      }
+
+      _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return j;
+  }
+
+  // Steals the oldest job.  Any thread may steal.
+  //
+  // Returns the job, or NULL if the deque is empty or another thread took the job first
+  job* steal() noexcept {
+    int64_t t = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = _bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+      return NULL;
+    }
+
+    job* j = _jobs[t & _mask].load(std::memory_order_relaxed);
+
+    if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return NULL;
+    }
+
+    return j;
+  }
+
+  private:
+  std::vector<std::atomic<job*>> _jobs;
+  const int64_t _mask;
+  alignas(64) std::atomic<int64_t> _top;
+  alignas(64) std::atomic<int64_t> _bottom;
+};
+
+namespace {
+
+// The number of job records allocated at once, and moved at once between a thread's free list and the shared one.
+const size_t job_block_size = 256;
+
+// The job system the calling thread belongs to, and its index within it.  The thread constructing a job system is
+// index 0 and its workers follow.
+thread_local const job_system* thread_system = NULL;
+thread_local unsigned int thread_system_index = 0;
+thread_local uint32_t thread_random = 0;
+
+// Returns a pseudo random number from the calling thread's xorshift state, used to pick a victim to steal from.
+uint32_t next_random() noexcept {
+  uint32_t x = thread_random != 0 ? thread_random : 0x9E3779B9u ^ (thread_system_index * 0x85EBCA6Bu);
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  thread_random = x;
+
+  return x;
+}
+
+}
+
+// Construct a job counter with no pending jobs.
+job_counter::job_counter() noexcept
+    : _pending(0)
+    , _failed(false) {
+}
+
+// Returns true when every job run against the counter has finished.
+bool job_counter::done() const noexcept {
+  return _pending.load(std::memory_order_acquire) == 0;
+}
+
+// Construct a job system, starting its worker threads.  The calling thread becomes part of the system and runs jobs
+// while it waits on a counter.
+//
+// Parameters
+// threads - the number of threads running jobs including the calling thread, or 0 for one per hardware thread
+// deque_capacity - the number of jobs each thread can queue, a power of two.  Jobs pushed to a full queue run inline
+job_system::job_system(unsigned int threads, size_t deque_capacity)
+    : _queued(0)
+    , _sleeping(0)
+    , _stopping(false) {
+  assert(thread_system == NULL);
+
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+
+  if (threads == 0) {
+    threads = 1;
+  }
+
+  for (unsigned int i = 0; i < threads; ++i) {
+    _deques.push_back(std::make_unique<job_deque>(deque_capacity));
+  }
+
+  _free.resize(threads);
+
+  thread_system = this;
+  thread_system_index = 0;
+
+  for (unsigned int i = 1; i < threads; ++i) {
+    _workers.emplace_back(&job_system::work, this, i);
+  }
+}
+
+// Deconstructs a job system, running any queued jobs and then stopping its worker threads.
+job_system::~job_system() {
+  while (job* j = find_job(0)) {
+    execute(j);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+
+  _wake.notify_all();
+
+  for (std::thread& worker : _workers) {
+    worker.join();
+  }
+
+  thread_system = NULL;
+}
+
+// Queues a job.  Must be called on the thread which constructed the job system or from within a job.
+//
+// Parameters
+// function - the job to run.  The first exception thrown by a job is rethrown by wait on its counter.  Jobs run
+// without a counter must not throw, an exception escaping one terminates the process as it would escaping a thread
+// counter - incremented now and decremented when the job finishes, or NULL
+// dependency - a counter which must reach zero before the job runs, or NULL
+void job_system::run(job_function_t function, job_counter* counter, job_counter* dependency) {
+  assert(thread_system == this);
+
+  job* j = allocate(std::move(function), counter);
+
+  if (counter != NULL) {
+    counter->_pending.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (dependency != NULL) {
+    std::lock_guard<std::mutex> lock(dependency->_mutex);
+
+    if (!dependency->done()) {
+      dependency->_continuations.push_back(j);
+      return;
+    }
+  }
+
+  push(j);
+}
+
+// Runs queued jobs on the calling thread until every job run against a counter has finished.
+//
+// Parameters
+// counter - the counter to wait on
+//
+// Throws
+// the first exception thrown by a job run against the counter
+void job_system::wait(job_counter& counter) {
+  assert(thread_system == this);
+
+  const unsigned int index = thread_index();
+
+  while (!counter.done()) {
+    job* j = find_job(index);
+
+    if (j != NULL) {
+      execute(j);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(counter._mutex);
+
+  if (counter._failed.load(std::memory_order_acquire)) {
+    std::exception_ptr error = counter._error;
+    counter._error = NULL;
+    counter._failed = false;
+    std::rethrow_exception(error);
+  }
+}
+
+// Splits a range into jobs of a fixed size and waits for them all to finish.
+//
+// Parameters
+// count - the number of items in the range
+// grain - the number of items given to each job
+// function - called with the first and one past the last item of each job
+//
+// Throws
+// the first exception thrown by the function
+void job_system::parallel_for(size_t count, size_t grain, const job_range_function_t& function) {
+  assert(grain > 0);
+
+  if (count <= grain) {
+    if (count > 0) {
+      function(0, count);
+    }
+
+    return;
+  }
+
+  job_counter counter;
+
+  for (size_t first = grain; first < count; first += grain) {
+    size_t last = first + grain < count ? first + grain : count;
+
+    run([&function, first, last]() {
+      function(first, last);
+    }, &counter);
+  }
+
+  std::exception_ptr error;
+
+  try {
+    function(0, grain);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  wait(counter);
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Returns the number of threads running jobs, including the thread which constructed the job system.
+unsigned int job_system::threads() const noexcept {
+  return static_cast<unsigned int>(_deques.size());
+}
+
+// Runs jobs on a worker thread until the job system stops.  A worker finding no work spins briefly before sleeping
+// until a job is queued.
+//
+// Parameters
+// index - the index of the worker's deque
+void job_system::work(unsigned int index) {
+  thread_system = this;
+  thread_system_index = index;
+
+  int idle = 0;
+
+  while (true) {
+    job* j = find_job(index);
+
+    if (j != NULL) {
+      execute(j);
+      idle = 0;
+      continue;
+    }
+
+    if (++idle < 64) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _sleeping.fetch_add(1);
+    _wake.wait(lock, [this]() {
+      return _stopping || _queued.load() > 0;
+    });
+    _sleeping.fetch_sub(1);
+
+    if (_stopping) {
+      return;
+    }
+
+    idle = 0;
+  }
+}
+
+// Takes a job for a thread, first from its own deque and then by stealing from the others starting at a random one.
+//
+// Parameters
+// index - the index of the thread's deque
+//
+// Returns the job, or NULL if none was found
+job* job_system::find_job(unsigned int index) {
+  job* j = _deques[index]->pop();
+
+  if (j == NULL) {
+    const unsigned int count = threads();
+    const unsigned int start = next_random() % count;
+
+    for (unsigned int i = 0; i < count && j == NULL; ++i) {
+      unsigned int victim = (start + i) % count;
+
+      if (victim != index) {
+        j = _deques[victim]->steal();
+      }
+    }
+  }
+
+  if (j != NULL) {
+    _queued.fetch_sub(1);
+  }
+
+  return j;
+}
+
+// Takes a job record from the calling thread's free list, refilling the list from the shared one, or with a newly
+// allocated block, when it is empty.
+//
+// Parameters
+// function - the job to run
+// counter - the counter the job is run against, or NULL
+//
+// Returns the job
+job* job_system::allocate(job_function_t function, job_counter* counter) {
+  std::vector<job*>& free = _free[thread_index()].jobs;
+
+  if (free.empty()) {
+    std::lock_guard<std::mutex> lock(_pool_mutex);
+
+    if (_shared_free.empty()) {
+      _blocks.push_back(std::make_unique<job[]>(job_block_size));
+
+      for (size_t i = 0; i < job_block_size; ++i) {
+        _shared_free.push_back(&_blocks.back()[i]);
+      }
+    }
+
+    size_t count = std::min(job_block_size, _shared_free.size());
+
+    free.insert(free.end(), _shared_free.end() - count, _shared_free.end());
+    _shared_free.resize(_shared_free.size() - count);
+  }
+
+  job* j = free.back();
+  free.pop_back();
+
+  j->function = std::move(function);
+  j->counter = counter;
+
+  return j;
+}
+
+// Returns a job record to the calling thread's free list, releasing what its function captured.  Jobs are usually
+// queued by one thread and run by others, so a list which grows past two blocks hands a block to the shared list.
+//
+// Parameters
+// j - the job to release
+void job_system::release(job* j) {
+  j->function = nullptr;
+
+  std::vector<job*>& free = _free[thread_index()].jobs;
+  free.push_back(j);
+
+  if (free.size() >= 2 * job_block_size) {
+    std::lock_guard<std::mutex> lock(_pool_mutex);
+
+    _shared_free.insert(_shared_free.end(), free.end() - job_block_size, free.end());
+    free.resize(free.size() - job_block_size);
+  }
+}
+
+// Queues a job on the calling thread's deque and wakes a sleeping worker.  A job which does not fit is run inline.
+//
+// Parameters
+// j - the job to queue
+void job_system::push(job* j) {
+  if (!_deques[thread_index()]->push(j)) {
+    execute(j);
+    return;
+  }
+
+  _queued.fetch_add(1);
+
+  if (_sleeping.load() > 0) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _wake.notify_one();
+  }
+}
+
+// Runs a job and releases it.  When the job is the last outstanding against its counter, jobs depending on the
+// counter are queued.  The counter is only touched under its mutex, which wait takes before returning, so a waiter
+// may destroy the counter as soon as wait returns.  An exception escaping a job without a counter has nowhere to be
+// rethrown, so terminates the process.
+//
+// Parameters
+// j - the job to run
+void job_system::execute(job* j) {
+  job_counter* counter = j->counter;
+
+  try {
+    j->function();
+  } catch (...) {
+    if (counter == NULL) {
+      std::terminate();
+    }
+
+    if (!counter->_failed.exchange(true)) {
+      counter->_error = std::current_exception();
+    }
+  }
+
+  release(j);
+
+  if (counter == NULL) {
+    return;
+  }
+
+  std::vector<job*> continuations;
+
+  {
+    std::lock_guard<std::mutex> lock(counter->_mutex);
+
+    if (counter->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      continuations.swap(counter->_continuations);
+    }
+  }
+
+  for (job* continuation : continuations) {
+    push(continuation);
+  }
+}
+
+// Returns the index of the calling thread within the job system.
+unsigned int job_system::thread_index() const noexcept {
+  assert(thread_system == this);
+
+  return thread_system_index;
+}
+
+}
@@ -0,0 +1,154 @@
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "myopengl/file_exception.h"
+#include "myopengl/mapped_file.h"
+
+namespace myopengl {
+
+#ifdef _WIN32
+
+// Maps a file read only into the address space of the process.
+//
+// Parameters
+// path - path on the filesystem to the file
+//
+// Throws
+// file_exception - if the file could not be opened or mapped
+mapped_file::mapped_file(const char* path)
+    : _data(NULL)
+    , _size(0)
+    , _file(INVALID_HANDLE_VALUE)
+    , _mapping(NULL) {
+  assert(path != NULL);
+
+  _file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+  if (_file == INVALID_HANDLE_VALUE) {
+    throw file_exception("Unable to open [" + std::string(path) + "], error [" + std::to_string(GetLastError()) + "]");
+  }
+
+  LARGE_INTEGER size;
+
+  if (!GetFileSizeEx(_file, &size)) {
+    CloseHandle(_file);
+    throw file_exception("Unable to size [" + std::string(path) + "], error [" + std::to_string(GetLastError()) + "]");
+  }
+
+  _size = static_cast<size_t>(size.QuadPart);
+
+  if (_size == 0) {
+    return;
+  }
+
+  _mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+  if (_mapping != NULL) {
+    _data = static_cast<const unsigned char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+  }
+
+  if (_data == NULL) {
+    DWORD error = GetLastError();
+
+    if (_mapping != NULL) {
+      CloseHandle(_mapping);
+    }
+
+    CloseHandle(_file);
+    throw file_exception("Unable to map [" + std::string(path) + "], error [" + std::to_string(error) + "]");
+  }
+}
+
+// Deconstructs a mapped file, unmapping it.
+mapped_file::~mapped_file() {
+  if (_data != NULL) {
+    UnmapViewOfFile(_data);
+  }
+
+  if (_mapping != NULL) {
+    CloseHandle(_mapping);
+  }
+
+  if (_file != INVALID_HANDLE_VALUE) {
+    CloseHandle(_file);
+  }
+}
+
+#else
+
+// Maps a file read only into the address space of the process.
+//
+// Parameters
+// path - path on the filesystem to the file
+//
+// Throws
+// file_exception - if the file could not be opened or mapped
+mapped_file::mapped_file(const char* path)
+    : _data(NULL)
+    , _size(0) {
+  assert(path != NULL);
+
+  int fd = open(path, O_RDONLY);
+
+  if (fd == -1) {
+    throw file_exception("Unable to open [" + std::string(path) + "], [" + std::strerror(errno) + "]");
+  }
+
+  struct stat info;
+
+  if (fstat(fd, &info) == -1) {
+    int error = errno;
+    close(fd);
+    throw file_exception("Unable to size [" + std::string(path) + "], [" + std::strerror(error) + "]");
+  }
+
+  _size = static_cast<size_t>(info.st_size);
+
+  if (_size > 0) {
+    void* data = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED) {
+      int error = errno;
+      close(fd);
+      throw file_exception("Unable to map [" + std::string(path) + "], [" + std::strerror(error) + "]");
+    }
+
+    madvise(data, _size, MADV_SEQUENTIAL);
+    _data = static_cast<const unsigned char*>(data);
+  }
+
+  close(fd);
+}
+
+// Deconstructs a mapped file, unmapping it.
+mapped_file::~mapped_file() {
+  if (_data != NULL) {
+    munmap(const_cast<unsigned char*>(_data), _size);
+  }
+}
+
+#endif
+
+// Returns the contents of the file, or NULL if the file is empty.
+const unsigned char* mapped_file::data() const noexcept {
+  return _data;
+}
+
+// Returns the size of the file in bytes.
+size_t mapped_file::size() const noexcept {
+  return _size;
+}
+
+}
@@ -0,0 +1,443 @@
+#include <cassert>
+#include <cmath>
+
+#ifdef __AVX__
+#define MYOPENGL_MATH_AVX
+#include <immintrin.h>
+#endif
+
+#include "myopengl/math.h"
+
+namespace myopengl {
+
+namespace math {
+
+namespace {
+
+// Multiplies two matrices one column at a time.
+//
+// Parameters
+// a - the left hand matrix
+// b - the right hand matrix
+// result - receives a * b
+void multiply_matrix(const mat4& a, const mat4& b, mat4& result) {
+#ifdef MYOPENGL_MATH_AVX
+  const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[0].x));
+  const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[1].x));
+  const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[2].x));
+  const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a.columns[3].x));
+
+  for (int c = 0; c < 4; c += 2) {
+    const __m256 bc = _mm256_loadu_ps(&b.columns[c].x);
+
+    __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(bc, 0x00));
+    r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_permute_ps(bc, 0x55)));
+    r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_permute_ps(bc, 0xAA)));
+    r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_permute_ps(bc, 0xFF)));
+
+    _mm256_storeu_ps(&result.columns[c].x, r);
+  }
+#else
+  result = a * b;
+#endif
+}
+
+}
+
+// Returns the length of a vector.
+//
+// Parameters
+// v - the vector
+float length(const vec3& v) noexcept {
+  return std::sqrt(dot(v, v));
+}
+
+// Returns a vector scaled to unit length, or the zero vector unchanged.
+//
+// Parameters
+// v - the vector to normalize
+vec3 normalize(const vec3& v) noexcept {
+  const float l = length(v);
+
+  return l > 0.0f ? v * (1.0f / l) : v;
+}
+
+// Returns the length of a vector.
+//
+// Parameters
+// v - the vector
+float length(const vec4& v) noexcept {
+  return std::sqrt(dot(v, v));
+}
+
+// Returns a vector scaled to unit length, or the zero vector unchanged.
+//
+// Parameters
+// v - the vector to normalize
+vec4 normalize(const vec4& v) noexcept {
+  const float l = length(v);
+
+  return l > 0.0f ? v * (1.0f / l) : v;
+}
+
+// Inverts a matrix by cofactor expansion.  A singular matrix has no inverse and the identity is returned.
+//
+// Parameters
+// m - the matrix to invert
+//
+// Returns the inverse of the matrix
+mat4 inverse(const mat4& m) noexcept {
+  const float* a = m.data();
+  float r[16];
+
+  r[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15]
+      + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+  r[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15]
+      - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+  r[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15]
+      + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+  r[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14]
+      - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+  r[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15]
+      - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+  r[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15]
+      + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+  r[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15]
+      - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+  r[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14]
+      + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+  r[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15]
+      + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+  r[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15]
+      - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+  r[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15]
+      + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+  r[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14]
+      - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+  r[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11]
+      - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+  r[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11]
+      + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+  r[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11]
+      - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+  r[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10]
+      + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+  const float determinant = a[0] * r[0] + a[1] * r[4] + a[2] * r[8] + a[3] * r[12];
+
+  if (determinant == 0.0f) {
+    return identity();
+  }
+
+  const float s = 1.0f / determinant;
+
+  return mat4(vec4(r[0], r[1], r[2], r[3]) * s, vec4(r[4], r[5], r[6], r[7]) * s, vec4(r[8], r[9], r[10], r[11]) * s,
+      vec4(r[12], r[13], r[14], r[15]) * s);
+}
+
+// Builds a right handed perspective projection mapping depth to OpenGL's -1 to 1 clip range.
+//
+// Parameters
+// fovy - the vertical field of view in radians
+// aspect - width divided by height of the viewport
+// z_near - distance to the near plane, greater than 0
+// z_far - distance to the far plane, greater than z_near
+//
+// Returns the projection matrix
+mat4 perspective(float fovy, float aspect, float z_near, float z_far) noexcept {
+  assert(aspect > 0.0f);
+  assert(z_near > 0.0f && z_far > z_near);
+
+  const float f = 1.0f / std::tan(fovy * 0.5f);
+
+  return mat4(vec4(f / aspect, 0.0f, 0.0f, 0.0f), vec4(0.0f, f, 0.0f, 0.0f),
+      vec4(0.0f, 0.0f, (z_far + z_near) / (z_near - z_far), -1.0f),
+      vec4(0.0f, 0.0f, 2.0f * z_far * z_near / (z_near - z_far), 0.0f));
+}
+
+// Builds a right handed view matrix looking from a point towards a target.
+//
+// Parameters
+// eye - the position of the viewer
+// target - the point being looked at
+// up - the direction considered up, not parallel to the view direction
+//
+// Returns the view matrix
+mat4 look_at(const vec3& eye, const vec3& target, const vec3& up) noexcept {
+  const vec3 f = normalize(target - eye);
+  const vec3 s = normalize(cross(f, up));
+  const vec3 u = cross(s, f);
+
+  return mat4(vec4(s.x, u.x, -f.x, 0.0f), vec4(s.y, u.y, -f.y, 0.0f), vec4(s.z, u.z, -f.z, 0.0f),
+      vec4(-dot(s, eye), -dot(u, eye), dot(f, eye), 1.0f));
+}
+
+// Builds a rotation about an axis.
+//
+// Parameters
+// axis - the axis of rotation, which need not be unit length
+// radians - the angle of rotation, anticlockwise looking down the axis
+//
+// Returns the rotation as a unit quaternion
+quat axis_angle(const vec3& axis, float radians) noexcept {
+  const vec3 a = normalize(axis) * std::sin(radians * 0.5f);
+
+  return quat(a.x, a.y, a.z, std::cos(radians * 0.5f));
+}
+
+// Returns a quaternion scaled to unit length, or the identity for a zero quaternion.
+//
+// Parameters
+// q - the quaternion to normalize
+quat normalize(const quat& q) noexcept {
+  const vec4 v = normalize(vec4(q.x, q.y, q.z, q.w));
+
+  return v.x == 0.0f && v.y == 0.0f && v.z == 0.0f && v.w == 0.0f ? quat() : quat(v.x, v.y, v.z, v.w);
+}
+
+// Builds a local transform from its position, rotation and scale, equivalent to translation * rotation * scaling.
+// The scaled rotation columns are written directly rather than scaling the columns of a rotation matrix.
+//
+// Parameters
+// position - the translation
+// q - the rotation, a unit quaternion
+// scale - the scale along each axis
+//
+// Returns the local transform
+mat4 compose(const vec3& position, const quat& q, const vec3& scale) noexcept {
+  const float x2 = q.x + q.x;
+  const float y2 = q.y + q.y;
+  const float z2 = q.z + q.z;
+  const float xx = q.x * x2, xy = q.x * y2, xz = q.x * z2;
+  const float yy = q.y * y2, yz = q.y * z2, zz = q.z * z2;
+  const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+  return mat4(vec4((1.0f - (yy + zz)) * scale.x, (xy + wz) * scale.x, (xz - wy) * scale.x, 0.0f),
+      vec4((xy - wz) * scale.y, (1.0f - (xx + zz)) * scale.y, (yz + wx) * scale.y, 0.0f),
+      vec4((xz + wy) * scale.z, (yz - wx) * scale.z, (1.0f - (xx + yy)) * scale.z, 0.0f), vec4(position, 1.0f));
+}
+
+// Spherically interpolates between two rotations along the shortest arc, falling back to a normalized linear
+// interpolation when they are nearly equal.
+//
+// Parameters
+// a - the rotation at t of 0
+// b - the rotation at t of 1
+// t - the interpolation factor
+//
+// Returns the interpolated rotation
+quat slerp(const quat& a, const quat& b, float t) noexcept {
+  vec4 from(a.x, a.y, a.z, a.w);
+  vec4 to(b.x, b.y, b.z, b.w);
+  float cosine = dot(from, to);
+
+  if (cosine < 0.0f) {
+    to = to * -1.0f;
+    cosine = -cosine;
+  }
+
+  vec4 result;
+
+  if (cosine > 0.9995f) {
+    result = normalize(from + (to - from) * t);
+  } else {
+    const float angle = std::acos(cosine);
+    const float s = 1.0f / std::sin(angle);
+    result = from * (std::sin((1.0f - t) * angle) * s) + to * (std::sin(t * angle) * s);
+  }
+
+  return quat(result.x, result.y, result.z, result.w);
+}
+
+// Transforms points held in structure of arrays form by an affine matrix, eight points per iteration with AVX or
+// four with SSE, with a scalar tail.  The output arrays may alias the input arrays.
+//
+// Parameters
+// m - the transform, whose bottom row is assumed to be 0, 0, 0, 1
+// x - x components of the points
+// y - y components of the points
+// z - z components of the points
+// out_x - receives x components of the transformed points
+// out_y - receives y components of the transformed points
+// out_z - receives z components of the transformed points
+// count - the number of points
+void transform_points(const mat4& m, const float* x, const float* y, const float* z, float* out_x, float* out_y,
+    float* out_z, size_t count) noexcept {
+  assert(count == 0 || (x != NULL && y != NULL && z != NULL));
+  assert(count == 0 || (out_x != NULL && out_y != NULL && out_z != NULL));
+
+  size_t i = 0;
+
+#ifdef MYOPENGL_MATH_AVX
+  {
+    const __m256 m00 = _mm256_set1_ps(m[0].x), m01 = _mm256_set1_ps(m[0].y), m02 = _mm256_set1_ps(m[0].z);
+    const __m256 m10 = _mm256_set1_ps(m[1].x), m11 = _mm256_set1_ps(m[1].y), m12 = _mm256_set1_ps(m[1].z);
+    const __m256 m20 = _mm256_set1_ps(m[2].x), m21 = _mm256_set1_ps(m[2].y), m22 = _mm256_set1_ps(m[2].z);
+    const __m256 m30 = _mm256_set1_ps(m[3].x), m31 = _mm256_set1_ps(m[3].y), m32 = _mm256_set1_ps(m[3].z);
+
+    for (; i + 8 <= count; i += 8) {
+      const __m256 px = _mm256_loadu_ps(x + i);
+      const __m256 py = _mm256_loadu_ps(y + i);
+      const __m256 pz = _mm256_loadu_ps(z + i);
+
+      const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, px), _mm256_mul_ps(m10, py)),
+          _mm256_add_ps(_mm256_mul_ps(m20, pz), m30));
+      const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m01, px), _mm256_mul_ps(m11, py)),
+          _mm256_add_ps(_mm256_mul_ps(m21, pz), m31));
+      const __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m02, px), _mm256_mul_ps(m12, py)),
+          _mm256_add_ps(_mm256_mul_ps(m22, pz), m32));
+
+      _mm256_storeu_ps(out_x + i, rx);
+      _mm256_storeu_ps(out_y + i, ry);
+      _mm256_storeu_ps(out_z + i, rz);
+    }
+  }
+#endif
+
+#ifdef MYOPENGL_MATH_SSE
+  {
+    const __m128 m00 = _mm_set1_ps(m[0].x), m01 = _mm_set1_ps(m[0].y), m02 = _mm_set1_ps(m[0].z);
+    const __m128 m10 = _mm_set1_ps(m[1].x), m11 = _mm_set1_ps(m[1].y), m12 = _mm_set1_ps(m[1].z);
+    const __m128 m20 = _mm_set1_ps(m[2].x), m21 = _mm_set1_ps(m[2].y), m22 = _mm_set1_ps(m[2].z);
+    const __m128 m30 = _mm_set1_ps(m[3].x), m31 = _mm_set1_ps(m[3].y), m32 = _mm_set1_ps(m[3].z);
+
+    for (; i + 4 <= count; i += 4) {
+      const __m128 px = _mm_loadu_ps(x + i);
+      const __m128 py = _mm_loadu_ps(y + i);
+      const __m128 pz = _mm_loadu_ps(z + i);
+
+      const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, px), _mm_mul_ps(m10, py)),
+          _mm_add_ps(_mm_mul_ps(m20, pz), m30));
+      const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, px), _mm_mul_ps(m11, py)),
+          _mm_add_ps(_mm_mul_ps(m21, pz), m31));
+      const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, px), _mm_mul_ps(m12, py)),
+          _mm_add_ps(_mm_mul_ps(m22, pz), m32));
+
+      _mm_storeu_ps(out_x + i, rx);
+      _mm_storeu_ps(out_y + i, ry);
+      _mm_storeu_ps(out_z + i, rz);
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    const vec3 p = transform_point(m, vec3(x[i], y[i], z[i]));
+
+    out_x[i] = p.x;
+    out_y[i] = p.y;
+    out_z[i] = p.z;
+  }
+}
+
+// Builds local transforms from arrays of positions, rotations and scales, as compose does, four per iteration with
+// SSE and a scalar tail.  Quaternions are transposed into one register per component so each element of the
+// scaled rotation is computed for four transforms at once, then transposed back into columns.
+//
+// Parameters
+// positions - the translations
+// rotations - the rotations, unit quaternions
+// scales - the scales along each axis
+// result - receives the local transforms
+// count - the number of transforms
+void compose_transforms(const vec3* positions, const quat* rotations, const vec3* scales, mat4* result,
+    size_t count) noexcept {
+  assert(count == 0 || (positions != NULL && rotations != NULL && scales != NULL && result != NULL));
+
+  size_t i = 0;
+
+#ifdef MYOPENGL_MATH_SSE
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (; i + 4 <= count; i += 4) {
+    __m128 qx = _mm_load_ps(&rotations[i].x);
+    __m128 qy = _mm_load_ps(&rotations[i + 1].x);
+    __m128 qz = _mm_load_ps(&rotations[i + 2].x);
+    __m128 qw = _mm_load_ps(&rotations[i + 3].x);
+    _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+    const vec3* s = scales + i;
+    const __m128 sx = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+    const __m128 sy = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+    const __m128 sz = _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z);
+
+    const __m128 x2 = _mm_add_ps(qx, qx);
+    const __m128 y2 = _mm_add_ps(qy, qy);
+    const __m128 z2 = _mm_add_ps(qz, qz);
+    const __m128 xx = _mm_mul_ps(qx, x2), xy = _mm_mul_ps(qx, y2), xz = _mm_mul_ps(qx, z2);
+    const __m128 yy = _mm_mul_ps(qy, y2), yz = _mm_mul_ps(qy, z2), zz = _mm_mul_ps(qz, z2);
+    const __m128 wx = _mm_mul_ps(qw, x2), wy = _mm_mul_ps(qw, y2), wz = _mm_mul_ps(qw, z2);
+
+    __m128 c0x = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+    __m128 c0y = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+    __m128 c0z = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+    __m128 c0w = zero;
+    __m128 c1x = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+    __m128 c1y = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+    __m128 c1z = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+    __m128 c1w = zero;
+    __m128 c2x = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+    __m128 c2y = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+    __m128 c2z = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+    __m128 c2w = zero;
+    _MM_TRANSPOSE4_PS(c0x, c0y, c0z, c0w);
+    _MM_TRANSPOSE4_PS(c1x, c1y, c1z, c1w);
+    _MM_TRANSPOSE4_PS(c2x, c2y, c2z, c2w);
+
+    const __m128 c0[4] = { c0x, c0y, c0z, c0w };
+    const __m128 c1[4] = { c1x, c1y, c1z, c1w };
+    const __m128 c2[4] = { c2x, c2y, c2z, c2w };
+
+    for (int k = 0; k < 4; ++k) {
+      mat4& m = result[i + k];
+      _mm_store_ps(&m.columns[0].x, c0[k]);
+      _mm_store_ps(&m.columns[1].x, c1[k]);
+      _mm_store_ps(&m.columns[2].x, c2[k]);
+      m.columns[3] = vec4(positions[i + k], 1.0f);
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    result[i] = compose(positions[i], rotations[i], scales[i]);
+  }
+}
+
+// Multiplies pairs of matrices, i.e. local transforms by their parents' world transforms.  The result may alias
+// either input.
+//
+// Parameters
+// a - the left hand matrices
+// b - the right hand matrices
+// result - receives a[i] * b[i]
+// count - the number of pairs
+void multiply_matrices(const mat4* a, const mat4* b, mat4* result, size_t count) noexcept {
+  assert(count == 0 || (a != NULL && b != NULL && result != NULL));
+
+  for (size_t i = 0; i < count; ++i) {
+    mat4 r;
+    multiply_matrix(a[i], b[i], r);
+    result[i] = r;
+  }
+}
+
+// Multiplies one matrix by many, i.e. a view projection by model transforms.  The result may alias b.
+//
+// Parameters
+// a - the left hand matrix
+// b - the right hand matrices
+// result - receives a * b[i]
+// count - the number of matrices in b
+void multiply_matrices(const mat4& a, const mat4* b, mat4* result, size_t count) noexcept {
+  assert(count == 0 || (b != NULL && result != NULL));
+
+  for (size_t i = 0; i < count; ++i) {
+    mat4 r;
+    multiply_matrix(a, b[i], r);
+    result[i] = r;
+  }
+}
+
+}
+
+}
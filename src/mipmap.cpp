@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYOPENGL_MIPMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define MYOPENGL_MIPMAP_AVX2
+#include <immintrin.h>
+#endif
+
+#include "myopengl/mipmap.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+namespace {
+
+constexpr int kaiser_taps = 8;
+constexpr int linear_to_srgb_size = 4096;
+
+// A mip level held as linear RGBA floats, premultiplied by alpha when alpha weighting is enabled.
+struct float_level {
+  int width = 0;
+  int height = 0;
+  std::vector<float> texels;
+};
+
+// Returns a lookup table converting 8 bit sRGB encoded values into linear floats.
+const std::array<float, 256>& srgb_to_linear_table() {
+  static const std::array<float, 256> table = [] {
+    std::array<float, 256> values {};
+
+    for (int i = 0; i < 256; ++i) {
+      float c = i / 255.0f;
+      values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    return values;
+  }();
+
+  return table;
+}
+
+// Returns a lookup table converting quantised linear values into 8 bit sRGB encoded values.
+const std::array<unsigned char, linear_to_srgb_size>& linear_to_srgb_table() {
+  static const std::array<unsigned char, linear_to_srgb_size> table = [] {
+    std::array<unsigned char, linear_to_srgb_size> values {};
+
+    for (int i = 0; i < linear_to_srgb_size; ++i) {
+      float l = i / static_cast<float>(linear_to_srgb_size - 1);
+      float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+      values[i] = static_cast<unsigned char>(std::min(std::max(c, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    return values;
+  }();
+
+  return table;
+}
+
+// Zeroth order modified Bessel function of the first kind, used by the Kaiser window.
+double bessel_i0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  double q = x * x / 4.0;
+
+  for (int k = 1; k < 32; ++k) {
+    term *= q / (static_cast<double>(k) * k);
+    sum += term;
+  }
+
+  return sum;
+}
+
+// Returns the normalised weights of a Kaiser windowed sinc kernel for a 2:1 reduction.  Tap k samples the source
+// texel at 2x - 3 + k for destination texel x.
+const std::array<float, kaiser_taps>& kaiser_weights() {
+  static const std::array<float, kaiser_taps> weights = [] {
+    const double pi = 3.14159265358979323846;
+    const double alpha = 4.0;
+    const double radius = kaiser_taps / 2.0;
+
+    std::array<double, kaiser_taps> raw {};
+    double total = 0.0;
+
+    for (int k = 0; k < kaiser_taps; ++k) {
+      double t = k - (kaiser_taps - 1) / 2.0;
+      double x = pi * t / 2.0;
+      double sinc = x == 0.0 ? 1.0 : std::sin(x) / x;
+      double r = t / radius;
+      double window = bessel_i0(alpha * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(alpha);
+
+      raw[k] = sinc * window;
+      total += raw[k];
+    }
+
+    std::array<float, kaiser_taps> values {};
+
+    for (int k = 0; k < kaiser_taps; ++k) {
+      values[k] = static_cast<float>(raw[k] / total);
+    }
+
+    return values;
+  }();
+
+  return weights;
+}
+
+// Converts an 8 bit image into a float level.  Colour is decoded into linear space and alpha is stored in the
+// fourth lane regardless of the channel count of the source.
+float_level to_float_level(const image& source, const mip_options& options) {
+  const auto& decode = srgb_to_linear_table();
+  const bool srgb = options.space == colour_space::srgb;
+  const bool has_alpha = source.channels == 2 || source.channels == 4;
+  const int colour_channels = source.channels >= 3 ? 3 : 1;
+  const size_t count = static_cast<size_t>(source.width) * source.height;
+
+  float_level level;
+  level.width = source.width;
+  level.height = source.height;
+  level.texels.assign(count * 4, 0.0f);
+
+  for (size_t i = 0; i < count; ++i) {
+    const unsigned char* src = &source.pixels[i * source.channels];
+    float* dst = &level.texels[i * 4];
+    float alpha = has_alpha ? src[source.channels - 1] / 255.0f : 1.0f;
+
+    for (int c = 0; c < colour_channels; ++c) {
+      dst[c] = srgb ? decode[src[c]] : src[c] / 255.0f;
+
+      if (options.alpha_weighted) {
+        dst[c] *= alpha;
+      }
+    }
+
+    dst[3] = alpha;
+  }
+
+  return level;
+}
+
+// Converts a float level back into an 8 bit image with the supplied channel count.
+image from_float_level(const float_level& level, int channels, const mip_options& options) {
+  const auto& encode = linear_to_srgb_table();
+  const bool srgb = options.space == colour_space::srgb;
+  const bool has_alpha = channels == 2 || channels == 4;
+  const int colour_channels = channels >= 3 ? 3 : 1;
+  const size_t count = static_cast<size_t>(level.width) * level.height;
+
+  image result;
+  result.width = level.width;
+  result.height = level.height;
+  result.channels = channels;
+  result.pixels.resize(count * channels);
+
+  for (size_t i = 0; i < count; ++i) {
+    const float* src = &level.texels[i * 4];
+    unsigned char* dst = &result.pixels[i * channels];
+    float alpha = std::min(std::max(src[3], 0.0f), 1.0f);
+    float scale = options.alpha_weighted && alpha > 0.0f ? 1.0f / alpha : 1.0f;
+
+    for (int c = 0; c < colour_channels; ++c) {
+      float value = std::min(std::max(src[c] * scale, 0.0f), 1.0f);
+
+      if (srgb) {
+        dst[c] = encode[static_cast<int>(value * (linear_to_srgb_size - 1) + 0.5f)];
+      } else {
+        dst[c] = static_cast<unsigned char>(value * 255.0f + 0.5f);
+      }
+    }
+
+    if (has_alpha) {
+      dst[channels - 1] = static_cast<unsigned char>(alpha * 255.0f + 0.5f);
+    }
+  }
+
+  return result;
+}
+
+// Allocates a level with the given dimensions.
+float_level make_level(int width, int height) {
+  float_level level;
+  level.width = width;
+  level.height = height;
+  level.texels.assign(static_cast<size_t>(width) * height * 4, 0.0f);
+
+  return level;
+}
+
+// Reference 2x2 box filter.  Odd dimensions clamp to the last row or column.
+void downsample_box_scalar(const float_level& src, float_level& dst) {
+  for (int y = 0; y < dst.height; ++y) {
+    const float* row0 = &src.texels[static_cast<size_t>(std::min(2 * y, src.height - 1)) * src.width * 4];
+    const float* row1 = &src.texels[static_cast<size_t>(std::min(2 * y + 1, src.height - 1)) * src.width * 4];
+    float* out = &dst.texels[static_cast<size_t>(y) * dst.width * 4];
+
+    for (int x = 0; x < dst.width; ++x) {
+      int x0 = std::min(2 * x, src.width - 1) * 4;
+      int x1 = std::min(2 * x + 1, src.width - 1) * 4;
+
+      for (int c = 0; c < 4; ++c) {
+        out[x * 4 + c] = 0.25f * ((row0[x0 + c] + row0[x1 + c]) + (row1[x0 + c] + row1[x1 + c]));
+      }
+    }
+  }
+}
+
+// Reference separable Kaiser filter, horizontal reduction.
+void downsample_kaiser_horizontal_scalar(const float_level& src, float_level& dst) {
+  const auto& weights = kaiser_weights();
+
+  for (int y = 0; y < dst.height; ++y) {
+    const float* row = &src.texels[static_cast<size_t>(y) * src.width * 4];
+    float* out = &dst.texels[static_cast<size_t>(y) * dst.width * 4];
+
+    for (int x = 0; x < dst.width; ++x) {
+      float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+      for (int k = 0; k < kaiser_taps; ++k) {
+        int sx = std::min(std::max(2 * x - 3 + k, 0), src.width - 1) * 4;
+
+        for (int c = 0; c < 4; ++c) {
+          acc[c] += weights[k] * row[sx + c];
+        }
+      }
+
+      for (int c = 0; c < 4; ++c) {
+        out[x * 4 + c] = acc[c];
+      }
+    }
+  }
+}
+
+// Reference separable Kaiser filter, vertical reduction.  Results are clamped to [0, 1] to stop ringing from
+// accumulating down the chain.
+void downsample_kaiser_vertical_scalar(const float_level& src, float_level& dst) {
+  const auto& weights = kaiser_weights();
+
+  for (int y = 0; y < dst.height; ++y) {
+    float* out = &dst.texels[static_cast<size_t>(y) * dst.width * 4];
+
+    for (int x = 0; x < dst.width * 4; ++x) {
+      float acc = 0.0f;
+
+      for (int k = 0; k < kaiser_taps; ++k) {
+        int sy = std::min(std::max(2 * y - 3 + k, 0), src.height - 1);
+        acc += weights[k] * src.texels[static_cast<size_t>(sy) * src.width * 4 + x];
+      }
+
+      out[x] = std::min(std::max(acc, 0.0f), 1.0f);
+    }
+  }
+}
+
+#ifdef MYOPENGL_MIPMAP_SSE2
+
+// SSE2 2x2 box filter, one RGBA texel per register.  With AVX2 two destination texels are produced at once.
+void downsample_box_simd(const float_level& src, float_level& dst) {
+  const __m128 quarter = _mm_set1_ps(0.25f);
+
+  for (int y = 0; y < dst.height; ++y) {
+    const float* row0 = &src.texels[static_cast<size_t>(std::min(2 * y, src.height - 1)) * src.width * 4];
+    const float* row1 = &src.texels[static_cast<size_t>(std::min(2 * y + 1, src.height - 1)) * src.width * 4];
+    float* out = &dst.texels[static_cast<size_t>(y) * dst.width * 4];
+
+    int x = 0;
+
+#ifdef MYOPENGL_MIPMAP_AVX2
+    const __m256 quarter8 = _mm256_set1_ps(0.25f);
+
+    for (; x + 1 < dst.width && 2 * x + 3 < src.width; x += 2) {
+      __m256 a = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x), _mm256_loadu_ps(row1 + 8 * x));
+      __m256 b = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x + 8), _mm256_loadu_ps(row1 + 8 * x + 8));
+      __m256 even = _mm256_permute2f128_ps(a, b, 0x20);
+      __m256 odd = _mm256_permute2f128_ps(a, b, 0x31);
+
+      _mm256_storeu_ps(out + 4 * x, _mm256_mul_ps(_mm256_add_ps(even, odd), quarter8));
+    }
+#endif
+
+    for (; x < dst.width; ++x) {
+      int x0 = std::min(2 * x, src.width - 1) * 4;
+      int x1 = std::min(2 * x + 1, src.width - 1) * 4;
+
+      __m128 top = _mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1));
+      __m128 bottom = _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1));
+
+      _mm_storeu_ps(out + 4 * x, _mm_mul_ps(_mm_add_ps(top, bottom), quarter));
+    }
+  }
+}
+
+// SSE2 Kaiser filter, horizontal reduction.  With AVX2 interior texels are produced two at a time.
+void downsample_kaiser_horizontal_simd(const float_level& src, float_level& dst) {
+  const auto& weights = kaiser_weights();
+
+  for (int y = 0; y < dst.height; ++y) {
+    const float* row = &src.texels[static_cast<size_t>(y) * src.width * 4];
+    float* out = &dst.texels[static_cast<size_t>(y) * dst.width * 4];
+
+    int x = 0;
+
+    for (; x < dst.width; ++x) {
+      __m128 acc = _mm_setzero_ps();
+
+#ifdef MYOPENGL_MIPMAP_AVX2
+      if (2 * x - 3 >= 0 && x + 1 < dst.width && 2 * x + 6 < src.width) {
+        __m256 acc8 = _mm256_setzero_ps();
+
+        for (int k = 0; k < kaiser_taps; ++k) {
+          const float* p = row + (2 * x - 3 + k) * 4;
+          __m256 texels = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 8), 1);
+          acc8 = _mm256_add_ps(acc8, _mm256_mul_ps(_mm256_set1_ps(weights[k]), texels));
+        }
+
+        _mm256_storeu_ps(out + 4 * x, acc8);
+        ++x;
+        continue;
+      }
+#endif
+
+      for (int k = 0; k < kaiser_taps; ++k) {
+        int sx = std::min(std::max(2 * x - 3 + k, 0), src.width - 1) * 4;
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(row + sx)));
+      }
+
+      _mm_storeu_ps(out + 4 * x, acc);
+    }
+  }
+}
+
+// SSE2 Kaiser filter, vertical reduction.  With AVX2 two texels are produced at a time.
+void downsample_kaiser_vertical_simd(const float_level& src, float_level& dst) {
+  const auto& weights = kaiser_weights();
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+
+  for (int y = 0; y < dst.height; ++y) {
+    const float* rows[kaiser_taps];
+
+    for (int k = 0; k < kaiser_taps; ++k) {
+      int sy = std::min(std::max(2 * y - 3 + k, 0), src.height - 1);
+      rows[k] = &src.texels[static_cast<size_t>(sy) * src.width * 4];
+    }
+
+    float* out = &dst.texels[static_cast<size_t>(y) * dst.width * 4];
+    int x = 0;
+
+#ifdef MYOPENGL_MIPMAP_AVX2
+    const __m256 zero8 = _mm256_setzero_ps();
+    const __m256 one8 = _mm256_set1_ps(1.0f);
+
+    for (; x + 1 < dst.width; x += 2) {
+      __m256 acc8 = _mm256_setzero_ps();
+
+      for (int k = 0; k < kaiser_taps; ++k) {
+        acc8 = _mm256_add_ps(acc8, _mm256_mul_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(rows[k] + 4 * x)));
+      }
+
+      _mm256_storeu_ps(out + 4 * x, _mm256_min_ps(_mm256_max_ps(acc8, zero8), one8));
+    }
+#endif
+
+    for (; x < dst.width; ++x) {
+      __m128 acc = _mm_setzero_ps();
+
+      for (int k = 0; k < kaiser_taps; ++k) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(rows[k] + 4 * x)));
+      }
+
+      _mm_storeu_ps(out + 4 * x, _mm_min_ps(_mm_max_ps(acc, zero), one));
+    }
+  }
+}
+
+#endif
+
+// Reduces a float level to half its size with the configured filter.
+float_level downsample(const float_level& src, const mip_options& options) {
+  float_level dst = make_level(std::max(1, src.width / 2), std::max(1, src.height / 2));
+
+#ifdef MYOPENGL_MIPMAP_SSE2
+  const bool simd = options.use_simd;
+#else
+  const bool simd = false;
+#endif
+
+  if (options.filter == mip_filter::box) {
+#ifdef MYOPENGL_MIPMAP_SSE2
+    if (simd) {
+      downsample_box_simd(src, dst);
+      return dst;
+    }
+#endif
+
+    downsample_box_scalar(src, dst);
+    return dst;
+  }
+
+  float_level horizontal = make_level(dst.width, src.height);
+
+#ifdef MYOPENGL_MIPMAP_SSE2
+  if (simd) {
+    downsample_kaiser_horizontal_simd(src, horizontal);
+    downsample_kaiser_vertical_simd(horizontal, dst);
+    return dst;
+  }
+#endif
+
+  downsample_kaiser_horizontal_scalar(src, horizontal);
+  downsample_kaiser_vertical_scalar(horizontal, dst);
+
+  return dst;
+}
+
+}
+
+// Calculates the number of levels in a full mip chain for an image.
+//
+// Parameters
+// width - width of the base level in pixels
+// height - height of the base level in pixels
+//
+// Returns the number of levels including the base level
+int mip_level_count(int width, int height) noexcept {
+  int size = std::max(width, height);
+  int levels = 1;
+
+  while (size > 1) {
+    size /= 2;
+    ++levels;
+  }
+
+  return levels;
+}
+
+// Generates a mip chain on the CPU.  Filtering happens in linear space on alpha premultiplied values so that sRGB
+// images do not darken and transparent texels do not bleed their colour into their neighbours.  The function has no
+// OpenGL dependency and may be called from any thread.
+//
+// Parameters
+// base - the base level image, 1 to 4 channels of 8 bit data
+// options - filter, colour space and level options
+//
+// Returns every level of the chain, starting with a copy of the base level
+std::vector<image> generate_mip_chain(const image& base, const mip_options& options) {
+  assert(base.width > 0 && base.height > 0);
+  assert(base.channels >= 1 && base.channels <= 4);
+  assert(base.pixels.size() == static_cast<size_t>(base.width) * base.height * base.channels);
+
+  MYOPENGL_TRACE_SCOPE("generate_mip_chain");
+
+  int levels = mip_level_count(base.width, base.height);
+
+  if (options.max_levels > 0) {
+    levels = std::min(levels, options.max_levels);
+  }
+
+  std::vector<image> chain;
+  chain.reserve(levels);
+  chain.push_back(base);
+
+  float_level current = to_float_level(base, options);
+
+  for (int level = 1; level < levels; ++level) {
+    float_level next = downsample(current, options);
+    chain.push_back(from_float_level(next, base.channels, options));
+    current = std::move(next);
+  }
+
+  return chain;
+}
+
+}
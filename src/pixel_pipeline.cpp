@@ -0,0 +1,276 @@
+#include <cassert>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYOPENGL_PIXEL_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__)
+#define MYOPENGL_PIXEL_SSSE3
+#define MYOPENGL_PIXEL_SSSE3_TARGET
+#include <tmmintrin.h>
+#elif defined(MYOPENGL_PIXEL_SSE2) && defined(__GNUC__)
+#define MYOPENGL_PIXEL_SSSE3
+#define MYOPENGL_PIXEL_SSSE3_RUNTIME
+#define MYOPENGL_PIXEL_SSSE3_TARGET __attribute__((target("ssse3")))
+#include <tmmintrin.h>
+#endif
+
+#include "myopengl/pixel_pipeline.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+namespace {
+
+// Multiplies two 8 bit values as fractions of 255 with exact rounding.
+unsigned char multiply_255(unsigned int value, unsigned int alpha) {
+  unsigned int t = value * alpha + 128;
+
+  return static_cast<unsigned char>((t + (t >> 8)) >> 8);
+}
+
+// Processes pixels of a row one at a time, from a starting pixel to the end of the row.
+//
+// Parameters
+// src - the source row
+// dst - the destination row
+// first - the first pixel to process
+// width - the number of pixels in the row
+// src_channels - channels in the source
+// dst_channels - channels in the destination
+// operations - the operations to apply
+void process_row_scalar(const unsigned char* src, unsigned char* dst, int first, int width, int src_channels,
+    int dst_channels, const pixel_operations& operations) {
+  const bool has_alpha = dst_channels == 2 || dst_channels == 4;
+  const bool premultiply = operations.premultiply_alpha && has_alpha && src_channels == dst_channels;
+
+  for (int x = first; x < width; ++x) {
+    const unsigned char* s = src + x * src_channels;
+    unsigned char* d = dst + x * dst_channels;
+
+    for (int c = 0; c < src_channels; ++c) {
+      d[c] = s[c];
+    }
+
+    if (dst_channels > src_channels) {
+      d[3] = 255;
+    }
+
+    if (operations.swizzle_bgr) {
+      unsigned char r = d[0];
+      d[0] = d[2];
+      d[2] = r;
+    }
+
+    if (premultiply) {
+      unsigned int alpha = d[dst_channels - 1];
+
+      for (int c = 0; c < dst_channels - 1; ++c) {
+        d[c] = multiply_255(d[c], alpha);
+      }
+    }
+  }
+}
+
+#ifdef MYOPENGL_PIXEL_SSE2
+
+// Processes RGBA pixels four at a time, swapping red and blue with shifts and premultiplying in 16 bit lanes.
+//
+// Returns the number of pixels processed
+int process_rgba_row_simd(const unsigned char* src, unsigned char* dst, int width, const pixel_operations& operations) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ag_mask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+  const __m128i rb_mask = _mm_set1_epi32(0x00FF00FF);
+  const __m128i colour_lanes = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+  const __m128i alpha_lanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+  const __m128i rounding = _mm_set1_epi16(128);
+
+  int x = 0;
+
+  for (; x + 4 <= width; x += 4) {
+    __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+
+    if (operations.swizzle_bgr) {
+      __m128i rb = _mm_and_si128(p, rb_mask);
+      rb = _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16));
+      p = _mm_or_si128(_mm_and_si128(p, ag_mask), rb);
+    }
+
+    if (operations.premultiply_alpha) {
+      __m128i lo = _mm_unpacklo_epi8(p, zero);
+      __m128i hi = _mm_unpackhi_epi8(p, zero);
+
+      __m128i lo_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+      __m128i hi_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+      lo_alpha = _mm_or_si128(_mm_and_si128(lo_alpha, colour_lanes), alpha_lanes);
+      hi_alpha = _mm_or_si128(_mm_and_si128(hi_alpha, colour_lanes), alpha_lanes);
+
+      lo = _mm_add_epi16(_mm_mullo_epi16(lo, lo_alpha), rounding);
+      hi = _mm_add_epi16(_mm_mullo_epi16(hi, hi_alpha), rounding);
+      lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+      hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+      p = _mm_packus_epi16(lo, hi);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), p);
+  }
+
+  return x;
+}
+
+#endif
+
+#ifdef MYOPENGL_PIXEL_SSSE3
+
+// Returns true if the SSSE3 kernels can run.  Builds which do not target SSSE3 compile them for it anyway and check
+// the processor once.
+bool ssse3_supported() noexcept {
+#ifdef MYOPENGL_PIXEL_SSSE3_RUNTIME
+  static const bool supported = __builtin_cpu_supports("ssse3");
+
+  return supported;
+#else
+  return true;
+#endif
+}
+
+// Expands RGB pixels to RGBA four at a time, optionally swapping red and blue in the same shuffle.  Loads read 16
+// bytes, so the last few pixels of a row are left to the scalar path.
+//
+// Returns the number of pixels processed
+MYOPENGL_PIXEL_SSSE3_TARGET
+int process_rgb_to_rgba_row_simd(const unsigned char* src, unsigned char* dst, int width, bool swizzle) {
+  const __m128i shuffle = swizzle ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+                                  : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+  int x = 0;
+
+  for (; x + 6 <= width; x += 4) {
+    __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 3));
+    p = _mm_or_si128(_mm_shuffle_epi8(p, shuffle), alpha);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), p);
+  }
+
+  return x;
+}
+
+// Swaps red and blue of RGB pixels five at a time.  Each store writes one byte past the fifth pixel which the next
+// iteration overwrites, so the last few pixels of a row are left to the scalar path.
+//
+// Returns the number of pixels processed
+MYOPENGL_PIXEL_SSSE3_TARGET
+int process_rgb_swizzle_row_simd(const unsigned char* src, unsigned char* dst, int width) {
+  const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+
+  int x = 0;
+
+  for (; x + 6 <= width; x += 5) {
+    __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 3), _mm_shuffle_epi8(p, shuffle));
+  }
+
+  return x;
+}
+
+#endif
+
+// Processes as much of a row as the available SIMD kernels support.
+//
+// Returns the number of pixels processed
+int process_row_simd(const unsigned char* src, unsigned char* dst, int width, int src_channels, int dst_channels,
+    const pixel_operations& operations) {
+#ifdef MYOPENGL_PIXEL_SSE2
+  if (src_channels == 4 && dst_channels == 4) {
+    return process_rgba_row_simd(src, dst, width, operations);
+  }
+#endif
+
+#ifdef MYOPENGL_PIXEL_SSSE3
+  if (src_channels == 3 && dst_channels == 4 && ssse3_supported()) {
+    return process_rgb_to_rgba_row_simd(src, dst, width, operations.swizzle_bgr);
+  }
+
+  if (src_channels == 3 && dst_channels == 3 && operations.swizzle_bgr && ssse3_supported()) {
+    return process_rgb_swizzle_row_simd(src, dst, width);
+  }
+#endif
+
+  return 0;
+}
+
+}
+
+// Returns the number of channels an image will have after processing.
+//
+// Parameters
+// channels - the number of channels in the source image
+// operations - the operations to be applied
+int processed_channels(int channels, const pixel_operations& operations) noexcept {
+  return operations.expand_to_rgba && channels == 3 ? 4 : channels;
+}
+
+// Applies a set of post decode operations to an image in a single pass.  Each destination row is produced from its
+// source row, flipped or not, with every other operation applied while the pixels are in registers.  Rows needing
+// no operation beyond the flip are copied.
+//
+// Parameters
+// source - the source pixels
+// width - width of the image in pixels
+// height - height of the image in pixels
+// channels - number of channels in the source, 1 to 4
+// operations - the operations to apply
+// destination - receives the processed image
+void process_pixels(const unsigned char* source, int width, int height, int channels,
+    const pixel_operations& operations, image& destination) {
+  assert(source != NULL);
+  assert(width > 0 && height > 0);
+  assert(channels >= 1 && channels <= 4);
+  assert(!operations.swizzle_bgr || channels >= 3);
+
+  MYOPENGL_TRACE_SCOPE("process_pixels");
+
+  const int dst_channels = processed_channels(channels, operations);
+  const size_t src_stride = static_cast<size_t>(width) * channels;
+  const size_t dst_stride = static_cast<size_t>(width) * dst_channels;
+  const bool has_alpha = channels == 2 || channels == 4;
+  const bool copy = dst_channels == channels && !operations.swizzle_bgr && !(operations.premultiply_alpha && has_alpha);
+
+  destination.width = width;
+  destination.height = height;
+  destination.channels = dst_channels;
+  destination.pixels.resize(dst_stride * height);
+
+  for (int y = 0; y < height; ++y) {
+    const int source_row = operations.flip_vertically ? height - 1 - y : y;
+    const unsigned char* src = source + source_row * src_stride;
+    unsigned char* dst = destination.pixels.data() + y * dst_stride;
+
+    if (copy) {
+      std::memcpy(dst, src, src_stride);
+      continue;
+    }
+
+    int x = operations.use_simd ? process_row_simd(src, dst, width, channels, dst_channels, operations) : 0;
+    process_row_scalar(src, dst, x, width, channels, dst_channels, operations);
+  }
+}
+
+// Applies a set of post decode operations to an image in a single pass.
+//
+// Parameters
+// source - the image to process
+// operations - the operations to apply
+//
+// Returns the processed image
+image process_pixels(const image& source, const pixel_operations& operations) {
+  image result;
+  process_pixels(source.pixels.data(), source.width, source.height, source.channels, operations, result);
+
+  return result;
+}
+
+}
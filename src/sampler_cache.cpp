@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include <glad/glad.h>
+
+#include "myopengl/extensions.h"
+#include "myopengl/frame_recorder.h"
+#include "myopengl/sampler_cache.h"
+
+namespace myopengl {
+
+namespace {
+
+const GLenum texture_max_anisotropy = 0x84FE;
+const unsigned int unknown_sampler = ~0u;
+
+}
+
+// Returns true if two descriptors describe the same sampler state.
+//
+// Parameters
+// other - the descriptor to compare against
+bool sampler_descriptor::operator==(const sampler_descriptor& other) const noexcept {
+  return wrap_s == other.wrap_s && wrap_t == other.wrap_t && min_filter == other.min_filter
+      && mag_filter == other.mag_filter && max_anisotropy == other.max_anisotropy;
+}
+
+// Hashes a sampler descriptor.
+//
+// Parameters
+// descriptor - the descriptor to hash
+size_t sampler_descriptor_hash::operator()(const sampler_descriptor& descriptor) const noexcept {
+  size_t hash = std::hash<unsigned int>()(descriptor.wrap_s);
+  hash = hash * 31 + std::hash<unsigned int>()(descriptor.wrap_t);
+  hash = hash * 31 + std::hash<unsigned int>()(descriptor.min_filter);
+  hash = hash * 31 + std::hash<unsigned int>()(descriptor.mag_filter);
+  hash = hash * 31 + std::hash<float>()(descriptor.max_anisotropy);
+
+  return hash;
+}
+
+// Construct a sampler cache for the current context.
+sampler_cache::sampler_cache()
+    : _max_anisotropy(max_texture_anisotropy()) {
+  int units = 0;
+  glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+
+  _bound.assign(static_cast<size_t>(units), 0);
+}
+
+// Deconstructs a sampler cache, deleting every sampler object it created.
+sampler_cache::~sampler_cache() {
+  for (const auto& entry : _samplers) {
+    glDeleteSamplers(1, &entry.second);
+  }
+}
+
+// Returns the sampler object for a descriptor, creating it on first use.  Anisotropy is clamped to what the context
+// supports and ignored where the extension is unavailable.
+//
+// Parameters
+// descriptor - the sampler state required
+//
+// Returns the OpenGL generated id for the sampler
+unsigned int sampler_cache::get(const sampler_descriptor& descriptor) {
+  sampler_descriptor key = descriptor;
+  key.max_anisotropy = std::min(std::max(key.max_anisotropy, 1.0f), _max_anisotropy);
+
+  auto found = _samplers.find(key);
+
+  if (found != _samplers.end()) {
+    return found->second;
+  }
+
+  unsigned int sampler = 0;
+
+  glGenSamplers(1, &sampler);
+  glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, key.wrap_s);
+  glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, key.wrap_t);
+  glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, key.min_filter);
+  glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, key.mag_filter);
+
+  if (key.max_anisotropy > 1.0f) {
+    glSamplerParameterf(sampler, texture_max_anisotropy, key.max_anisotropy);
+  }
+
+  _samplers.emplace(key, sampler);
+
+  return sampler;
+}
+
+// Binds the sampler for a descriptor to a texture unit, skipping the call if it is already bound there.
+//
+// Parameters
+// unit - the index of the texture unit, i.e. 0 for GL_TEXTURE0
+// descriptor - the sampler state required
+void sampler_cache::bind(unsigned int unit, const sampler_descriptor& descriptor) {
+  assert(unit < _bound.size());
+
+  unsigned int sampler = get(descriptor);
+
+  if (_bound[unit] != sampler) {
+    glBindSampler(unit, sampler);
+    _bound[unit] = sampler;
+    record_state_change();
+  }
+}
+
+// Unbinds any sampler from a texture unit so the texture's own parameters apply.
+//
+// Parameters
+// unit - the index of the texture unit
+void sampler_cache::unbind(unsigned int unit) noexcept {
+  assert(unit < _bound.size());
+
+  if (_bound[unit] != 0) {
+    glBindSampler(unit, 0);
+    _bound[unit] = 0;
+    record_state_change();
+  }
+}
+
+// Forgets which samplers are bound, i.e. after code outside the cache has called glBindSampler, so the next bind
+// to each unit is always issued.
+void sampler_cache::invalidate() noexcept {
+  std::fill(_bound.begin(), _bound.end(), unknown_sampler);
+}
+
+// Returns the number of sampler objects created.
+size_t sampler_cache::size() const noexcept {
+  return _samplers.size();
+}
+
+// Returns the largest anisotropy samplers may use, 1 if anisotropic filtering is unavailable.
+float sampler_cache::max_anisotropy() const noexcept {
+  return _max_anisotropy;
+}
+
+}
@@ -0,0 +1,450 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+#include "myopengl/scene_graph.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+namespace {
+
+// The number of nodes whose transforms are composed and multiplied together.
+const size_t update_batch_size = 64;
+
+// Scratch space for one batch of an update, kept per thread so ranges updated concurrently do not share it.
+struct update_batch {
+  uint32_t indices[update_batch_size];
+  math::vec3 positions[update_batch_size];
+  math::quat rotations[update_batch_size];
+  math::vec3 scales[update_batch_size];
+  math::mat4 parents[update_batch_size];
+  math::mat4 locals[update_batch_size];
+};
+
+thread_local update_batch thread_batch;
+
+// Reorders an array so the element at each index moves to its new index.
+//
+// Parameters
+// values - the array to reorder
+// new_indices - the new index of each element
+template <typename T>
+void permute(std::vector<T>& values, const std::vector<uint32_t>& new_indices) {
+  std::vector<T> result(values.size());
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    result[new_indices[i]] = values[i];
+  }
+
+  values.swap(result);
+}
+
+}
+
+// Construct an empty scene graph.
+scene_graph::scene_graph()
+    : _changed(false)
+    , _any_dirty(false) {
+}
+
+// Adds a node with an identity transform.  Nodes are stored in structure of arrays form, sorted by depth on the next
+// update so every parent precedes its children.  The node's world transform is valid after the next update.
+//
+// Parameters
+// parent - the parent of the node, or no_scene_node for a root
+//
+// Returns the handle of the node, which stays valid until the node is removed
+scene_node_t scene_graph::add(scene_node_t parent) {
+  assert(parent == no_scene_node || contains(parent));
+
+  scene_node_t node;
+
+  if (!_free.empty()) {
+    node = _free.back();
+    _free.pop_back();
+  } else {
+    node = static_cast<scene_node_t>(_indices.size());
+    _indices.push_back(no_scene_node);
+  }
+
+  const uint32_t parent_index = parent == no_scene_node ? no_scene_node : _indices[parent];
+
+  _indices[node] = static_cast<uint32_t>(_nodes.size());
+  _nodes.push_back(node);
+  _parents.push_back(parent_index);
+  _depths.push_back(parent_index == no_scene_node ? 0 : _depths[parent_index] + 1);
+  _positions.push_back(math::vec3());
+  _rotations.push_back(math::quat());
+  _scales.push_back(math::vec3(1.0f, 1.0f, 1.0f));
+  _worlds.push_back(math::identity());
+  _dirty.push_back(1);
+
+  _changed = true;
+  _any_dirty = true;
+
+  return node;
+}
+
+// Removes a node along with all of its descendants.  The arrays are compacted in a single pass, keeping them sorted
+// by depth.
+//
+// Parameters
+// node - the node to remove
+void scene_graph::remove(scene_node_t node) {
+  assert(contains(node));
+
+  if (!std::is_sorted(_depths.begin(), _depths.end())) {
+    sort();
+  }
+
+  const size_t first = _indices[node];
+  std::vector<uint8_t> removed(_nodes.size(), 0);
+  std::vector<uint32_t> new_indices(_nodes.size(), no_scene_node);
+  removed[first] = 1;
+
+  for (size_t i = 0; i < first; ++i) {
+    new_indices[i] = static_cast<uint32_t>(i);
+  }
+
+  size_t next = first;
+
+  for (size_t i = first; i < _nodes.size(); ++i) {
+    const uint32_t parent = _parents[i];
+
+    if (i != first && !(parent != no_scene_node && removed[parent])) {
+      new_indices[i] = static_cast<uint32_t>(next);
+      _parents[next] = parent == no_scene_node ? no_scene_node : new_indices[parent];
+      _depths[next] = _depths[i];
+      _positions[next] = _positions[i];
+      _rotations[next] = _rotations[i];
+      _scales[next] = _scales[i];
+      _worlds[next] = _worlds[i];
+      _dirty[next] = _dirty[i];
+      _nodes[next] = _nodes[i];
+      _indices[_nodes[next]] = static_cast<uint32_t>(next);
+      ++next;
+      continue;
+    }
+
+    removed[i] = 1;
+    _indices[_nodes[i]] = no_scene_node;
+    _free.push_back(_nodes[i]);
+  }
+
+  _parents.resize(next);
+  _depths.resize(next);
+  _positions.resize(next);
+  _rotations.resize(next);
+  _scales.resize(next);
+  _worlds.resize(next);
+  _dirty.resize(next);
+  _nodes.resize(next);
+
+  _changed = true;
+}
+
+// Sets the position of a node relative to its parent, marking its subtree dirty.
+//
+// Parameters
+// node - the node to move
+// position - the new position
+void scene_graph::set_position(scene_node_t node, const math::vec3& position) {
+  assert(contains(node));
+
+  _positions[_indices[node]] = position;
+  mark_dirty(node);
+}
+
+// Sets the rotation of a node relative to its parent, marking its subtree dirty.
+//
+// Parameters
+// node - the node to rotate
+// rotation - the new rotation, a unit quaternion
+void scene_graph::set_rotation(scene_node_t node, const math::quat& rotation) {
+  assert(contains(node));
+
+  _rotations[_indices[node]] = rotation;
+  mark_dirty(node);
+}
+
+// Sets the scale of a node relative to its parent, marking its subtree dirty.
+//
+// Parameters
+// node - the node to scale
+// scale - the new scale along each axis
+void scene_graph::set_scale(scene_node_t node, const math::vec3& scale) {
+  assert(contains(node));
+
+  _scales[_indices[node]] = scale;
+  mark_dirty(node);
+}
+
+// Returns the position of a node relative to its parent.
+//
+// Parameters
+// node - the node
+const math::vec3& scene_graph::position(scene_node_t node) const noexcept {
+  assert(contains(node));
+
+  return _positions[_indices[node]];
+}
+
+// Returns the rotation of a node relative to its parent.
+//
+// Parameters
+// node - the node
+const math::quat& scene_graph::rotation(scene_node_t node) const noexcept {
+  assert(contains(node));
+
+  return _rotations[_indices[node]];
+}
+
+// Returns the scale of a node relative to its parent.
+//
+// Parameters
+// node - the node
+const math::vec3& scene_graph::scale(scene_node_t node) const noexcept {
+  assert(contains(node));
+
+  return _scales[_indices[node]];
+}
+
+// Returns the world transform of a node as of the last update.
+//
+// Parameters
+// node - the node
+const math::mat4& scene_graph::world(scene_node_t node) const noexcept {
+  assert(contains(node));
+
+  return _worlds[_indices[node]];
+}
+
+// Returns the parent of a node, or no_scene_node for a root.
+//
+// Parameters
+// node - the node
+scene_node_t scene_graph::parent(scene_node_t node) const noexcept {
+  assert(contains(node));
+
+  const uint32_t parent = _parents[_indices[node]];
+
+  return parent == no_scene_node ? no_scene_node : _nodes[parent];
+}
+
+// Returns true if a handle refers to a node in the graph.
+//
+// Parameters
+// node - the handle to check
+bool scene_graph::contains(scene_node_t node) const noexcept {
+  return node < _indices.size() && _indices[node] != no_scene_node;
+}
+
+// Recomputes the world transforms of dirty nodes and their descendants.  Nodes are visited in a linear pass, one
+// depth level at a time, with each node inheriting its parent's dirty flag.  Clean subtrees cost a read of two
+// small arrays per node, and a graph with nothing dirty returns immediately.  Levels larger than the grain are
+// split across the job system, which the calling thread must belong to.
+//
+// Parameters
+// jobs - the job system to update on, or NULL to update on the calling thread
+// grain - the number of nodes in each job
+//
+// Returns the number of world transforms recomputed
+size_t scene_graph::update(job_system* jobs, size_t grain) {
+  assert(grain > 0);
+
+  if (_changed) {
+    if (!std::is_sorted(_depths.begin(), _depths.end())) {
+      sort();
+    }
+
+    rebuild_levels();
+    _changed = false;
+  }
+
+  if (!_any_dirty) {
+    return 0;
+  }
+
+  MYOPENGL_TRACE_SCOPE("scene_graph::update");
+
+  size_t updated = 0;
+
+  for (size_t level = 0; level + 1 < _levels.size(); ++level) {
+    const size_t first = _levels[level];
+    const size_t count = _levels[level + 1] - first;
+
+    if (jobs == NULL || count <= grain) {
+      updated += update_range(first, first + count);
+      continue;
+    }
+
+    std::atomic<size_t> level_updated(0);
+
+    jobs->parallel_for(count, grain, [this, first, &level_updated](size_t begin, size_t end) {
+      level_updated.fetch_add(update_range(first + begin, first + end), std::memory_order_relaxed);
+    });
+
+    updated += level_updated.load(std::memory_order_relaxed);
+  }
+
+  std::fill(_dirty.begin(), _dirty.end(), 0);
+  _any_dirty = false;
+
+  return updated;
+}
+
+// Returns the world transforms of every node as of the last update, in depth order.  The node at each position is
+// given by nodes.
+const std::vector<math::mat4>& scene_graph::worlds() const noexcept {
+  return _worlds;
+}
+
+// Returns the handle of every node in depth order, matching worlds.  The order is valid after an update.
+const std::vector<scene_node_t>& scene_graph::nodes() const noexcept {
+  return _nodes;
+}
+
+// Returns the number of nodes in the graph.
+size_t scene_graph::size() const noexcept {
+  return _nodes.size();
+}
+
+// Returns the number of depth levels in the graph as of the last update.
+size_t scene_graph::levels() const noexcept {
+  return _levels.empty() ? 0 : _levels.size() - 1;
+}
+
+// Marks a node as needing its world transform recomputed.  Its descendants inherit the flag during the update.
+//
+// Parameters
+// node - the node to mark
+void scene_graph::mark_dirty(scene_node_t node) {
+  _dirty[_indices[node]] = 1;
+  _any_dirty = true;
+}
+
+// Sorts the node arrays by depth with a stable counting sort, remapping parent indices and handles.
+void scene_graph::sort() {
+  MYOPENGL_TRACE_SCOPE("scene_graph::sort");
+
+  const uint32_t max_depth = *std::max_element(_depths.begin(), _depths.end());
+  std::vector<size_t> offsets(max_depth + 1, 0);
+
+  for (uint32_t depth : _depths) {
+    ++offsets[depth];
+  }
+
+  size_t total = 0;
+
+  for (size_t& offset : offsets) {
+    const size_t count = offset;
+    offset = total;
+    total += count;
+  }
+
+  std::vector<uint32_t> new_indices(_nodes.size());
+
+  for (size_t i = 0; i < _nodes.size(); ++i) {
+    new_indices[i] = static_cast<uint32_t>(offsets[_depths[i]]++);
+  }
+
+  for (uint32_t& parent : _parents) {
+    parent = parent == no_scene_node ? no_scene_node : new_indices[parent];
+  }
+
+  permute(_parents, new_indices);
+  permute(_depths, new_indices);
+  permute(_positions, new_indices);
+  permute(_rotations, new_indices);
+  permute(_scales, new_indices);
+  permute(_worlds, new_indices);
+  permute(_dirty, new_indices);
+  permute(_nodes, new_indices);
+
+  for (size_t i = 0; i < _nodes.size(); ++i) {
+    _indices[_nodes[i]] = static_cast<uint32_t>(i);
+  }
+}
+
+// Records where each depth level starts in the sorted arrays.
+void scene_graph::rebuild_levels() {
+  _levels.clear();
+
+  for (size_t i = 0; i < _depths.size(); ++i) {
+    if (i == 0 || _depths[i] != _depths[i - 1]) {
+      _levels.push_back(i);
+    }
+  }
+
+  _levels.push_back(_depths.size());
+}
+
+// Recomputes the world transforms of dirty nodes in a range of one depth level.  Parents are in earlier levels, so
+// ranges of the same level can be updated concurrently.  Nodes are processed in batches: the dirty nodes of a batch
+// have their local transforms composed together, then are multiplied by their gathered parent world transforms, so
+// both steps run through the SIMD kernels of the math library.
+//
+// Parameters
+// first - the index of the first node
+// last - one past the index of the last node
+//
+// Returns the number of world transforms recomputed
+size_t scene_graph::update_range(size_t first, size_t last) noexcept {
+  update_batch& batch = thread_batch;
+  size_t updated = 0;
+
+  for (size_t begin = first; begin < last; begin += update_batch_size) {
+    const size_t end = std::min(begin + update_batch_size, last);
+    size_t count = 0;
+
+    for (size_t i = begin; i < end; ++i) {
+      const uint32_t parent = _parents[i];
+
+      if (parent != no_scene_node && _dirty[parent]) {
+        _dirty[i] = 1;
+      }
+
+      if (_dirty[i]) {
+        batch.indices[count++] = static_cast<uint32_t>(i);
+      }
+    }
+
+    if (count == 0) {
+      continue;
+    }
+
+    if (count == end - begin) {
+      math::compose_transforms(&_positions[begin], &_rotations[begin], &_scales[begin], batch.locals, count);
+    } else {
+      for (size_t k = 0; k < count; ++k) {
+        batch.positions[k] = _positions[batch.indices[k]];
+        batch.rotations[k] = _rotations[batch.indices[k]];
+        batch.scales[k] = _scales[batch.indices[k]];
+      }
+
+      math::compose_transforms(batch.positions, batch.rotations, batch.scales, batch.locals, count);
+    }
+
+    for (size_t k = 0; k < count; ++k) {
+      const uint32_t parent = _parents[batch.indices[k]];
+      batch.parents[k] = parent == no_scene_node ? math::identity() : _worlds[parent];
+    }
+
+    if (count == end - begin) {
+      math::multiply_matrices(batch.parents, batch.locals, &_worlds[begin], count);
+    } else {
+      math::multiply_matrices(batch.parents, batch.locals, batch.locals, count);
+
+      for (size_t k = 0; k < count; ++k) {
+        _worlds[batch.indices[k]] = batch.locals[k];
+      }
+    }
+
+    updated += count;
+  }
+
+  return updated;
+}
+
+}
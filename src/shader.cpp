@@ -8,8 +8,10 @@
 
 #include <glad/glad.h>
 
+#include "myopengl/frame_recorder.h"
 #include "myopengl/shader.h"
 #include "myopengl/shader_exception.h"
+#include "myopengl/trace.h"
 
 namespace myopengl {
 
@@ -49,6 +51,8 @@ void shader::load(const char* vertex_shader_path, const char* fragment_shader_pa
   assert(fragment_shader_path != NULL);
   assert(_id == 0);
 
+  MYOPENGL_TRACE_SCOPE("shader::load");
+
   unsigned int vertex_shader_id = 0;
   unsigned int fragment_shader_id = 0;
 
@@ -98,11 +102,41 @@ void shader::set_float(const std::string& name, float value) const noexcept {
   glUniform1f(glGetUniformLocation(_id, name.c_str()), value);
 }
 
+// Sets a vec2 uniform value in the shaders.
+//
+// Parameters
+// name - the name of the uniform to set
+// x - the first component of the value to be set
+// y - the second component of the value to be set
+void shader::set_vec2(const std::string& name, float x, float y) const noexcept {
+  assert(_id != 0);
+
+  glUniform2f(glGetUniformLocation(_id, name.c_str()), x, y);
+}
+
+// Returns the location of a uniform, to be looked up once rather than on every set, i.e. when recording commands.
+//
+// Parameters
+// name - the name of the uniform
+//
+// Returns the location, or -1 if the shaders have no active uniform of that name
+int shader::uniform_location(const std::string& name) const noexcept {
+  assert(_id != 0);
+
+  return glGetUniformLocation(_id, name.c_str());
+}
+
+// Returns the OpenGL generated id for the program.
+unsigned int shader::id() const noexcept {
+  return _id;
+}
+
 // Instructs OpenGL to use this shader.
 void shader::use() {
   assert(_id != 0);
 
   glUseProgram(_id);
+  record_state_change();
 }
 
 // Reads the contents of a supplied file path.
@@ -117,6 +151,8 @@ void shader::use() {
 std::string shader::read_file_content(const char* path) {
   assert(path != NULL);
 
+  MYOPENGL_TRACE_SCOPE("shader::read_file_content");
+
   std::ifstream file;
   file.exceptions(std::ifstream::badbit | std::ifstream::failbit);
 
@@ -155,6 +191,8 @@ std::string shader::read_file_content(const char* path) {
 unsigned int shader::compile(unsigned int type, const char* src) {
   assert(src != NULL);
 
+  MYOPENGL_TRACE_SCOPE("shader::compile");
+
   unsigned int shader = 0;
 
   shader = glCreateShader(type);
@@ -190,6 +228,8 @@ unsigned int shader::link(unsigned int vertex_shader_id, unsigned int fragment_s
   assert(vertex_shader_id != 0);
   assert(fragment_shader_id != 0);
 
+  MYOPENGL_TRACE_SCOPE("shader::link");
+
   unsigned int program_id = 0;
 
   program_id = glCreateProgram();
@@ -1,2 +1,10 @@
+#ifdef MYOPENGL_STBI_ARENA
+#include "myopengl/image_arena.h"
+
+#define STBI_MALLOC(size) myopengl::image_arena_malloc(size)
+#define STBI_REALLOC_SIZED(p, old_size, new_size) myopengl::image_arena_realloc(p, old_size, new_size)
+#define STBI_FREE(p) myopengl::image_arena_free(p)
+#endif
+
 #define STB_IMAGE_IMPLEMENTATION
-#include <stb/stb_image.h>
\ No newline at end of file
+#include <stb/stb_image.h>
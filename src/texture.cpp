@@ -0,0 +1,301 @@
+#include <cassert>
+#include <climits>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <stb/stb_image.h>
+
+#include "myopengl/extensions.h"
+#include "myopengl/frame_recorder.h"
+#include "myopengl/image_arena.h"
+#include "myopengl/mapped_file.h"
+#include "myopengl/mipmap.h"
+#include "myopengl/texture.h"
+#include "myopengl/texture_exception.h"
+#include "myopengl/texture_format.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+// Loads and decodes an image file.  The file is memory mapped and decoded in place rather than read through stdio.
+//
+// Parameters
+// path - path on the filesystem to the image
+// operations - post decode operations, such as a vertical flip, applied as the pixels are copied out of the decoder
+// desired_channels - number of channels to convert the image to, or 0 to keep the channels of the file
+//
+// Throws
+// file_exception - if the file could not be mapped
+// texture_exception - if the image could not be decoded
+//
+// Returns the decoded image
+image load_image(const char* path, const pixel_operations& operations, int desired_channels) {
+  assert(path != NULL);
+
+  MYOPENGL_TRACE_SCOPE("load_image");
+
+  mapped_file file(path);
+
+  try {
+    return load_image_from_memory(file.data(), file.size(), operations, desired_channels);
+  } catch (texture_exception& e) {
+    throw texture_exception("Failed to load image [" + std::string(path) + "], " + e.what());
+  }
+}
+
+// Decodes an image held in memory, such as a mapped file or an entry in a packed archive.  When built with
+// MYOPENGL_STBI_ARENA the decoder's transient allocations come from the calling thread's arena, which is reset once
+// the pixels have been copied out.  The copy out of the decoder is the single pass of the pixel pipeline, so a flip
+// or swizzle costs no extra pass over the image.
+//
+// Parameters
+// data - the encoded image
+// size - the size of the encoded image in bytes
+// operations - post decode operations applied as the pixels are copied out of the decoder
+// desired_channels - number of channels to convert the image to, or 0 to keep the channels of the image
+//
+// Throws
+// texture_exception - if the image could not be decoded
+//
+// Returns the decoded image
+image load_image_from_memory(const unsigned char* data, size_t size, const pixel_operations& operations,
+    int desired_channels) {
+  assert(desired_channels >= 0 && desired_channels <= 4);
+
+  if (data == NULL || size == 0 || size > static_cast<size_t>(INT_MAX)) {
+    throw texture_exception("[Invalid image data]");
+  }
+
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+
+#ifdef MYOPENGL_STBI_ARENA
+  image_arena::scope arena_scope(image_arena::thread_arena());
+#endif
+
+  unsigned char* pixels = NULL;
+
+  {
+    MYOPENGL_TRACE_SCOPE("decode_image");
+    pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, desired_channels);
+  }
+
+  if (pixels == NULL) {
+    throw texture_exception("[" + std::string(stbi_failure_reason()) + "]");
+  }
+
+  image result;
+  process_pixels(pixels, width, height, desired_channels != 0 ? desired_channels : channels, operations, result);
+
+  stbi_image_free(pixels);
+
+  return result;
+}
+
+// Creates a 2D texture from a mip chain, using a sized internal format picked from the channel count and colour
+// space of the images.  The texture is left unbound.
+//
+// Parameters
+// mips - the levels of the texture, starting with the base level
+// space - the colour space the image data is encoded in
+//
+// Returns the OpenGL generated id for the texture
+unsigned int create_texture(const std::vector<image>& mips, colour_space space) {
+  assert(!mips.empty());
+
+  MYOPENGL_TRACE_SCOPE("create_texture");
+
+  const image& base = mips.front();
+  const texture_format format = select_texture_format(base.channels, space);
+
+  unsigned int texture = 0;
+
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D, texture);
+
+  allocate_texture_storage(GL_TEXTURE_2D, static_cast<int>(mips.size()), format, base.width, base.height, 1);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  for (size_t level = 0; level < mips.size(); ++level) {
+    const image& mip = mips[level];
+    glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, mip.width, mip.height, format.format, format.type, mip.pixels.data());
+  }
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  return texture;
+}
+
+// Allocates storage for every level of the texture bound to a target.  Immutable storage is used when available,
+// otherwise each level is specified with a sized internal format and GL_TEXTURE_MAX_LEVEL is set so the driver
+// treats the texture as mip complete.
+//
+// Parameters
+// target - GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY
+// levels - the number of mip levels
+// format - formats selected for the image data
+// width - width of the base level
+// height - height of the base level
+// layers - the number of array layers, ignored for GL_TEXTURE_2D
+void allocate_texture_storage(unsigned int target, int levels, const texture_format& format, int width, int height,
+    int layers) {
+  glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+  if (has_texture_storage()) {
+    if (target == GL_TEXTURE_2D_ARRAY) {
+      texture_storage_3d(target, levels, format.internal_format, width, height, layers);
+    } else {
+      texture_storage_2d(target, levels, format.internal_format, width, height);
+    }
+
+    return;
+  }
+
+  for (int level = 0; level < levels; ++level) {
+    if (target == GL_TEXTURE_2D_ARRAY) {
+      glTexImage3D(target, level, format.internal_format, width, height, layers, 0, format.format, format.type, NULL);
+    } else {
+      glTexImage2D(target, level, format.internal_format, width, height, 0, format.format, format.type, NULL);
+    }
+
+    width = width > 1 ? width / 2 : 1;
+    height = height > 1 ? height / 2 : 1;
+  }
+}
+
+// Binds a texture to a texture unit, counting the unit selection and the bind as state changes of the frame being
+// recorded.
+//
+// Parameters
+// unit - the index of the texture unit, i.e. 0 for GL_TEXTURE0
+// target - the target to bind to, i.e. GL_TEXTURE_2D
+// texture - the OpenGL generated id for the texture
+void bind_texture(unsigned int unit, unsigned int target, unsigned int texture) noexcept {
+  glActiveTexture(GL_TEXTURE0 + unit);
+  glBindTexture(target, texture);
+  record_state_change(2);
+}
+
+// Construct a 2D texture array with storage for a fixed number of layers and a full mip chain.  Every layer shares
+// the same dimensions and channel count so objects using different layers can be drawn in one instanced call.
+//
+// Parameters
+// width - width of each layer in pixels
+// height - height of each layer in pixels
+// channels - number of 8 bit channels in each layer, 1 to 4
+// layers - the number of layers to allocate
+// space - the colour space the image data is encoded in
+//
+// Throws
+// texture_exception - if the number of layers exceeds GL_MAX_ARRAY_TEXTURE_LAYERS
+texture_array::texture_array(int width, int height, int channels, int layers, colour_space space)
+    : _id(0)
+    , _width(width)
+    , _height(height)
+    , _channels(channels)
+    , _space(space)
+    , _levels(mip_level_count(width, height))
+    , _layers(0)
+    , _capacity(layers) {
+  assert(width > 0 && height > 0);
+  assert(channels >= 1 && channels <= 4);
+  assert(layers > 0);
+
+  int max_layers = 0;
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+
+  if (layers > max_layers) {
+    throw texture_exception("Texture array of [" + std::to_string(layers) + "] layers exceeds the limit of ["
+        + std::to_string(max_layers) + "]");
+  }
+
+  glGenTextures(1, &_id);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, _id);
+
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  allocate_texture_storage(GL_TEXTURE_2D_ARRAY, _levels, select_texture_format(channels, space), width, height, layers);
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+// Deconstructs a texture array, releasing its storage.
+texture_array::~texture_array() {
+  if (_id != 0) {
+    glDeleteTextures(1, &_id);
+  }
+}
+
+// Uploads an image, along with a mip chain generated from it, into the next free layer.
+//
+// Parameters
+// source - the image to upload, which must match the dimensions and channels of the array
+//
+// Throws
+// texture_exception - if the image does not match the array or the array is full
+//
+// Returns the index of the layer the image was uploaded to
+int texture_array::add_layer(const image& source) {
+  if (source.width != _width || source.height != _height || source.channels != _channels) {
+    throw texture_exception("Image of [" + std::to_string(source.width) + "x" + std::to_string(source.height) + "x"
+        + std::to_string(source.channels) + "] does not match texture array of [" + std::to_string(_width) + "x"
+        + std::to_string(_height) + "x" + std::to_string(_channels) + "]");
+  }
+
+  if (_layers == _capacity) {
+    throw texture_exception("Texture array is full at [" + std::to_string(_capacity) + "] layers");
+  }
+
+  MYOPENGL_TRACE_SCOPE("texture_array::add_layer");
+
+  mip_options options;
+  options.space = _space;
+
+  std::vector<image> mips = generate_mip_chain(source, options);
+  const texture_format format = select_texture_format(_channels, _space);
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, _id);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  for (size_t level = 0; level < mips.size(); ++level) {
+    const image& mip = mips[level];
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, _layers, mip.width, mip.height, 1, format.format, format.type,
+        mip.pixels.data());
+  }
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  return _layers++;
+}
+
+// Binds the texture array to a texture unit.
+//
+// Parameters
+// unit - the index of the texture unit, i.e. 0 for GL_TEXTURE0
+void texture_array::bind(unsigned int unit) const noexcept {
+  bind_texture(unit, GL_TEXTURE_2D_ARRAY, _id);
+}
+
+// Returns the OpenGL generated id for the texture array.
+unsigned int texture_array::id() const noexcept {
+  return _id;
+}
+
+// Returns the number of layers which have been uploaded.
+int texture_array::layers() const noexcept {
+  return _layers;
+}
+
+// Returns the number of layers the array was allocated with.
+int texture_array::capacity() const noexcept {
+  return _capacity;
+}
+
+}
@@ -0,0 +1,18 @@
+#include "myopengl/texture_exception.h"
+
+namespace myopengl {
+
+// Construct a new instance of a texture_exception
+//
+// Parameters
+// message - the message to be associated with the exception
+myopengl::texture_exception::texture_exception(const std::string& message) noexcept
+    : _message(message) {
+}
+
+// Returns the message associated with this exception
+const char* myopengl::texture_exception::what() const noexcept {
+  return _message.c_str();
+}
+
+}
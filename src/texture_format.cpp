@@ -0,0 +1,42 @@
+#include <cassert>
+
+#include <glad/glad.h>
+
+#include "myopengl/texture_format.h"
+
+namespace myopengl {
+
+// Selects a sized internal format and matching pixel transfer format for 8 bit image data.  Core OpenGL has no sized
+// sRGB formats for one and two channel images, so those always use linear formats.
+//
+// Parameters
+// channels - the number of channels in the image, 1 to 4
+// space - the colour space the image data is encoded in
+//
+// Returns the formats to be used when allocating and uploading the texture
+texture_format select_texture_format(int channels, colour_space space) noexcept {
+  assert(channels >= 1 && channels <= 4);
+
+  const bool srgb = space == colour_space::srgb;
+
+  switch (channels) {
+  case 1:
+    return texture_format { GL_R8, GL_RED, GL_UNSIGNED_BYTE };
+  case 2:
+    return texture_format { GL_RG8, GL_RG, GL_UNSIGNED_BYTE };
+  case 3:
+    if (srgb) {
+      return texture_format { GL_SRGB8, GL_RGB, GL_UNSIGNED_BYTE };
+    }
+
+    return texture_format { GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE };
+  default:
+    if (srgb) {
+      return texture_format { GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE };
+    }
+
+    return texture_format { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE };
+  }
+}
+
+}
@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include <glad/glad.h>
+
+#include <stb/stb_image.h>
+
+#include "myopengl/mipmap.h"
+#include "myopengl/texture.h"
+#include "myopengl/texture_exception.h"
+#include "myopengl/texture_streamer.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+// Construct a texture streamer.
+//
+// Parameters
+// frame_budget - the number of bytes of texture data to upload each frame
+// thumbnail_size - levels no larger than this in either dimension are uploaded as soon as a texture's levels are
+//                  available
+// jobs - the job system textures are decoded and mipmapped on, or NULL if every texture is added with its levels.
+//        Must outlive the streamer
+texture_streamer::texture_streamer(size_t frame_budget, int thumbnail_size, job_system* jobs)
+    : _frame_budget(frame_budget)
+    , _thumbnail_size(thumbnail_size)
+    , _jobs(jobs)
+    , _next_load(1) {
+}
+
+// Deconstructs a texture streamer, waiting for any texture still being loaded.  Textures already created are left to
+// their owners.
+texture_streamer::~texture_streamer() {
+  if (_jobs != NULL) {
+    _jobs->wait(_loads);
+  }
+}
+
+// Creates a texture with storage for its full mip chain but only uploads the smallest levels, up to the thumbnail
+// size, so it can be drawn straight away.  The remaining levels are uploaded by update from the smallest up, with
+// GL_TEXTURE_BASE_LEVEL lowered as each one lands.  The levels must already be decoded and mipmapped, which is the
+// slow part of loading a large texture; use the loader or path overloads to move that work off the calling thread.
+// The caller owns the texture.
+//
+// Parameters
+// mips - the levels of the texture, starting with the base level
+// space - the colour space the image data is encoded in
+//
+// Returns the OpenGL generated id for the texture
+unsigned int texture_streamer::add(std::vector<image> mips, colour_space space) {
+  assert(!mips.empty());
+
+  const image& base = mips.front();
+
+  stream s;
+  s.texture = 0;
+  s.format = select_texture_format(base.channels, space);
+  s.width = base.width;
+  s.height = base.height;
+  s.channels = base.channels;
+  s.levels = static_cast<int>(mips.size());
+  s.base_level = s.levels;
+  s.load = 0;
+  s.loading = false;
+
+  glGenTextures(1, &s.texture);
+  glBindTexture(GL_TEXTURE_2D, s.texture);
+
+  allocate_texture_storage(GL_TEXTURE_2D, s.levels, s.format, s.width, s.height, 1);
+
+  s.mips = std::move(mips);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  upload_thumbnail(s);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  unsigned int texture = s.texture;
+
+  if (s.base_level > 0) {
+    _streams.push_back(std::move(s));
+  }
+
+  return texture;
+}
+
+// Creates a texture with storage for its full mip chain and queues a job to produce the levels, so neither decoding
+// nor mipmapping holds up the calling thread.  Until the levels arrive the texture is a single grey texel in its
+// smallest level.  Once they do, update uploads the smallest levels up to the thumbnail size and streams the rest
+// in as for a texture added with its levels.  The caller owns the texture.
+//
+// Parameters
+// width - width of the base level
+// height - height of the base level
+// channels - number of channels of the levels
+// space - the colour space the image data is encoded in
+// loader - run on the job system, returns the full mip chain, starting with a base level of the given size
+//
+// Returns the OpenGL generated id for the texture
+unsigned int texture_streamer::add(int width, int height, int channels, colour_space space, mip_chain_loader_t loader) {
+  assert(_jobs != NULL);
+  assert(width > 0 && height > 0);
+  assert(channels >= 1 && channels <= 4);
+
+  stream s;
+  s.texture = 0;
+  s.format = select_texture_format(channels, space);
+  s.width = width;
+  s.height = height;
+  s.channels = channels;
+  s.levels = mip_level_count(width, height);
+  s.base_level = s.levels - 1;
+  s.load = _next_load++;
+  s.loading = true;
+
+  std::vector<unsigned char> placeholder(channels, 128);
+
+  if (channels == 2 || channels == 4) {
+    placeholder.back() = 255;
+  }
+
+  glGenTextures(1, &s.texture);
+  glBindTexture(GL_TEXTURE_2D, s.texture);
+
+  allocate_texture_storage(GL_TEXTURE_2D, s.levels, s.format, width, height, 1);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, s.base_level, 0, 0, 1, 1, s.format.format, s.format.type, placeholder.data());
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, s.base_level);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  const size_t load = s.load;
+  _streams.push_back(std::move(s));
+
+  _jobs->run([this, load, loader]() {
+    loaded_chain chain;
+    chain.load = load;
+
+    try {
+      MYOPENGL_TRACE_SCOPE("texture_streamer::load");
+      chain.mips = loader();
+    } catch (...) {
+      chain.error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _loaded.push_back(std::move(chain));
+  }, &_loads);
+
+  return _streams.back().texture;
+}
+
+// Creates a texture from an image file which is decoded and mipmapped on the job system.  Only the header of the
+// file is read on the calling thread.  See the loader overload for how the texture is filled in.
+//
+// Parameters
+// path - path on the filesystem to the image
+// space - the colour space the image data is encoded in
+// operations - post decode operations, such as a vertical flip, applied as the pixels are copied out of the decoder
+// desired_channels - number of channels to convert the image to, or 0 to keep the channels of the file
+//
+// Throws
+// texture_exception - if the header of the image could not be read
+//
+// Returns the OpenGL generated id for the texture
+unsigned int texture_streamer::add(const char* path, colour_space space, const pixel_operations& operations,
+    int desired_channels) {
+  assert(path != NULL);
+  assert(desired_channels >= 0 && desired_channels <= 4);
+
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+
+  if (!stbi_info(path, &width, &height, &channels)) {
+    throw texture_exception("Failed to load image [" + std::string(path) + "], [" + stbi_failure_reason() + "]");
+  }
+
+  channels = processed_channels(desired_channels != 0 ? desired_channels : channels, operations);
+
+  std::string file(path);
+
+  return add(width, height, channels, space, [file, space, operations, desired_channels]() {
+    mip_options options;
+    options.space = space;
+
+    return generate_mip_chain(load_image(file.c_str(), operations, desired_channels), options);
+  });
+}
+
+// Stops streaming a texture, i.e. before it is deleted.  Levels already uploaded remain and levels still being loaded
+// are discarded when they arrive.
+//
+// Parameters
+// texture - the id returned by add
+void texture_streamer::remove(unsigned int texture) noexcept {
+  _streams.erase(std::remove_if(_streams.begin(), _streams.end(), [texture](const stream& s) {
+    return s.texture == texture;
+  }),
+      _streams.end());
+}
+
+// Takes the levels of textures which have finished loading, then uploads pending levels within the frame budget,
+// always choosing the smallest pending level across every texture so that all textures sharpen together.  At least
+// one level is uploaded per call so levels larger than the budget still land.  Call once per frame on the context
+// thread.  A job system with a single thread has no workers to run loads, so they are run here instead.
+//
+// Throws
+// the first exception thrown loading a texture, or texture_exception if the levels loaded do not match the texture.
+// The texture keeps its placeholder and is no longer streamed, other textures continue on the next call
+//
+// Returns the number of bytes uploaded
+size_t texture_streamer::update() {
+  MYOPENGL_TRACE_SCOPE("texture_streamer::update");
+
+  if (_jobs != NULL && _jobs->threads() == 1 && !_loads.done()) {
+    _jobs->wait(_loads);
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  size_t uploaded = receive_loaded();
+
+  while (true) {
+    stream* next = NULL;
+    size_t next_bytes = 0;
+
+    for (stream& s : _streams) {
+      if (s.loading || s.base_level == 0) {
+        continue;
+      }
+
+      size_t bytes = s.mips[s.base_level - 1].pixels.size();
+
+      if (next == NULL || bytes < next_bytes) {
+        next = &s;
+        next_bytes = bytes;
+      }
+    }
+
+    if (next == NULL || (uploaded > 0 && uploaded + next_bytes > _frame_budget)) {
+      break;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, next->texture);
+    upload_next_level(*next);
+    uploaded += next_bytes;
+  }
+
+  if (uploaded > 0) {
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+
+  _streams.erase(std::remove_if(_streams.begin(), _streams.end(), [](const stream& s) {
+    return !s.loading && s.base_level == 0;
+  }),
+      _streams.end());
+
+  return uploaded;
+}
+
+// Sets the number of bytes of texture data to upload each frame.
+//
+// Parameters
+// frame_budget - the budget in bytes
+void texture_streamer::set_frame_budget(size_t frame_budget) noexcept {
+  _frame_budget = frame_budget;
+}
+
+// Returns true when every added texture is fully resident.
+bool texture_streamer::idle() const noexcept {
+  return _streams.empty();
+}
+
+// Returns true until the levels of a texture added with a loader have been taken by update.
+//
+// Parameters
+// texture - the id returned by add
+bool texture_streamer::loading(unsigned int texture) const noexcept {
+  for (const stream& s : _streams) {
+    if (s.texture == texture) {
+      return s.loading;
+    }
+  }
+
+  return false;
+}
+
+// Returns the number of bytes of texture data waiting to be uploaded, not counting textures still being loaded.
+size_t texture_streamer::pending_bytes() const noexcept {
+  size_t total = 0;
+
+  for (const stream& s : _streams) {
+    if (s.loading) {
+      continue;
+    }
+
+    for (int level = 0; level < s.base_level; ++level) {
+      total += s.mips[level].pixels.size();
+    }
+  }
+
+  return total;
+}
+
+// Returns the most detailed level of a texture which has been uploaded, 0 once it is fully resident.
+//
+// Parameters
+// texture - the id returned by add
+int texture_streamer::base_level(unsigned int texture) const noexcept {
+  for (const stream& s : _streams) {
+    if (s.texture == texture) {
+      return s.base_level;
+    }
+  }
+
+  return 0;
+}
+
+// Moves the levels of textures which have finished loading onto their streams and uploads their smallest levels,
+// up to the thumbnail size.
+//
+// Throws
+// the first exception thrown loading a texture, or texture_exception if the levels loaded do not match the texture
+//
+// Returns the number of bytes uploaded
+size_t texture_streamer::receive_loaded() {
+  std::vector<loaded_chain> loaded;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    loaded.swap(_loaded);
+  }
+
+  size_t uploaded = 0;
+  std::exception_ptr error;
+
+  for (loaded_chain& chain : loaded) {
+    std::vector<stream>::iterator s = std::find_if(_streams.begin(), _streams.end(), [&chain](const stream& s) {
+      return s.load == chain.load;
+    });
+
+    if (s == _streams.end()) {
+      continue;
+    }
+
+    if (!chain.error
+        && (static_cast<int>(chain.mips.size()) != s->levels || chain.mips.front().width != s->width
+            || chain.mips.front().height != s->height || chain.mips.front().channels != s->channels)) {
+      chain.error = std::make_exception_ptr(texture_exception("Loaded levels do not match the texture"));
+    }
+
+    if (chain.error) {
+      if (!error) {
+        error = chain.error;
+      }
+
+      _streams.erase(s);
+      continue;
+    }
+
+    s->mips = std::move(chain.mips);
+    s->base_level = s->levels;
+    s->loading = false;
+
+    glBindTexture(GL_TEXTURE_2D, s->texture);
+    uploaded += upload_thumbnail(*s);
+  }
+
+  if (uploaded > 0) {
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  return uploaded;
+}
+
+// Uploads the smallest levels of a stream, up to the thumbnail size and always at least one.  The stream's texture
+// must be bound to GL_TEXTURE_2D.
+//
+// Parameters
+// s - the stream to advance
+//
+// Returns the number of bytes uploaded
+size_t texture_streamer::upload_thumbnail(stream& s) {
+  size_t uploaded = 0;
+
+  do {
+    uploaded += s.mips[s.base_level - 1].pixels.size();
+    upload_next_level(s);
+  } while (s.base_level > 0
+      && std::max(s.mips[s.base_level - 1].width, s.mips[s.base_level - 1].height) <= _thumbnail_size);
+
+  return uploaded;
+}
+
+// Uploads the next level of a stream, lowers its base level and releases the uploaded image.  The stream's texture
+// must be bound to GL_TEXTURE_2D.
+//
+// Parameters
+// s - the stream to advance
+void texture_streamer::upload_next_level(stream& s) {
+  assert(s.base_level > 0);
+
+  const int level = s.base_level - 1;
+  image& mip = s.mips[level];
+
+  glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, mip.width, mip.height, s.format.format, s.format.type, mip.pixels.data());
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+
+  mip = image();
+  s.base_level = level;
+}
+
+}
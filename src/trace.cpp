@@ -0,0 +1,213 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "myopengl/file_exception.h"
+#include "myopengl/trace.h"
+
+namespace myopengl {
+
+namespace {
+
+// Events recorded by one thread.  Only the owning thread writes, publishing each event by advancing the written
+// count with release ordering, so recording takes no lock.  Once full the oldest events are overwritten.
+struct trace_buffer {
+  std::unique_ptr<trace_event[]> events;
+  size_t capacity;
+  std::atomic<uint64_t> written;
+  std::string thread_name;
+  int thread_id;
+};
+
+std::mutex registry_mutex;
+std::vector<std::shared_ptr<trace_buffer>> registry;
+std::atomic<bool> tracing_enabled(true);
+std::atomic<size_t> buffer_capacity(64 * 1024);
+const std::chrono::steady_clock::time_point clock_origin = std::chrono::steady_clock::now();
+
+thread_local std::shared_ptr<trace_buffer> thread_buffer;
+
+// Returns the buffer of the calling thread, registering one on first use.
+trace_buffer& get_thread_buffer() {
+  if (!thread_buffer) {
+    std::shared_ptr<trace_buffer> buffer = std::make_shared<trace_buffer>();
+    buffer->capacity = buffer_capacity.load(std::memory_order_relaxed);
+    buffer->events.reset(new trace_event[buffer->capacity]);
+    buffer->written.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer->thread_id = static_cast<int>(registry.size()) + 1;
+    buffer->thread_name = "thread " + std::to_string(buffer->thread_id);
+    registry.push_back(buffer);
+
+    thread_buffer = buffer;
+  }
+
+  return *thread_buffer;
+}
+
+// Writes a string as a JSON string literal.
+//
+// Parameters
+// stream - the stream to write to
+// value - the string to write
+void write_json_string(std::ostream& stream, const char* value) {
+  stream << '"';
+
+  for (const char* c = value; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      stream << '\\';
+    }
+
+    stream << *c;
+  }
+
+  stream << '"';
+}
+
+}
+
+// Opens a trace scope, recording its start time if tracing is enabled.  Use through MYOPENGL_TRACE_SCOPE so the
+// scope compiles away in builds without MYOPENGL_TRACE.
+//
+// Parameters
+// name - the name of the scope, which must outlive the trace, i.e. a string literal
+trace_scope::trace_scope(const char* name) noexcept
+    : _name(name)
+    , _begin_ns(trace_enabled() ? trace_clock() : -1) {
+}
+
+// Closes the trace scope, recording it as a complete event.
+trace_scope::~trace_scope() {
+  if (_begin_ns >= 0) {
+    record_trace_event(_name, _begin_ns, trace_clock());
+  }
+}
+
+// Returns nanoseconds elapsed on a steady clock since the process started.
+int64_t trace_clock() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - clock_origin).count();
+}
+
+// Records an event in the calling thread's buffer.  The first event recorded by a thread allocates its buffer.
+//
+// Parameters
+// name - the name of the event, which must outlive the trace
+// begin_ns - the start of the event from trace_clock
+// end_ns - the end of the event from trace_clock
+void record_trace_event(const char* name, int64_t begin_ns, int64_t end_ns) noexcept {
+  try {
+    trace_buffer& buffer = get_thread_buffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+
+    buffer.events[index % buffer.capacity] = trace_event { name, begin_ns, end_ns };
+    buffer.written.store(index + 1, std::memory_order_release);
+  } catch (std::bad_alloc&) {
+  }
+}
+
+// Enables or disables recording at runtime.  Scopes opened while disabled record nothing.
+//
+// Parameters
+// enabled - true to record trace events
+void set_trace_enabled(bool enabled) noexcept {
+  tracing_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Returns true if trace events are being recorded.
+bool trace_enabled() noexcept {
+  return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+// Sets the number of events held by each thread's buffer.  Applies to threads which record their first event after
+// the call.
+//
+// Parameters
+// events - the capacity of each buffer
+void set_trace_buffer_capacity(size_t events) noexcept {
+  buffer_capacity.store(events > 0 ? events : 1, std::memory_order_relaxed);
+}
+
+// Names the calling thread in written traces.
+//
+// Parameters
+// name - the name of the thread
+void set_trace_thread_name(const std::string& name) {
+  trace_buffer& buffer = get_thread_buffer();
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  buffer.thread_name = name;
+}
+
+// Discards every recorded event.  No thread may be recording while the trace is cleared.
+void clear_trace() noexcept {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+
+  for (const std::shared_ptr<trace_buffer>& buffer : registry) {
+    buffer->written.store(0, std::memory_order_relaxed);
+  }
+}
+
+// Writes every recorded event in the Chrome trace event format, which chrome://tracing and Perfetto both open.
+// Events still being recorded by other threads may be missed, so write the trace once work has finished.
+//
+// Parameters
+// stream - the stream to write to
+void write_chrome_trace(std::ostream& stream) {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  stream << std::fixed << std::setprecision(3);
+
+  bool first = true;
+
+  for (const std::shared_ptr<trace_buffer>& buffer : registry) {
+    stream << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id
+           << ",\"args\":{\"name\":";
+    write_json_string(stream, buffer->thread_name.c_str());
+    stream << "}}";
+    first = false;
+
+    uint64_t written = buffer->written.load(std::memory_order_acquire);
+    uint64_t start = written > buffer->capacity ? written - buffer->capacity : 0;
+
+    for (uint64_t i = start; i < written; ++i) {
+      const trace_event& e = buffer->events[i % buffer->capacity];
+
+      stream << ",\n{\"name\":";
+      write_json_string(stream, e.name);
+      stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id << ",\"ts\":" << e.begin_ns / 1000.0
+             << ",\"dur\":" << (e.end_ns - e.begin_ns) / 1000.0 << "}";
+    }
+  }
+
+  stream << "\n]}\n";
+}
+
+// Writes every recorded event in the Chrome trace event format to a file.
+//
+// Parameters
+// path - path on the filesystem to write to
+//
+// Throws
+// file_exception - if the file could not be written
+void write_chrome_trace(const std::string& path) {
+  std::ofstream file(path);
+
+  if (!file) {
+    throw file_exception("Unable to open [" + path + "] for writing");
+  }
+
+  write_chrome_trace(file);
+
+  if (!file) {
+    throw file_exception("Unable to write [" + path + "]");
+  }
+}
+
+}